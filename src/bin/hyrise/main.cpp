@@ -17,6 +17,7 @@
 
 #include "helper/HwlocHelper.h"
 #include "net/AsyncConnection.h"
+#include "io/RedoLog.h"
 #include "io/StorageManager.h"
 #include "taskscheduler/SharedScheduler.h"
 
@@ -32,6 +33,8 @@ const char *PORT_FILE = "./hyrise_server.port";
 const size_t DEFAULT_PORT = 5000;
 // default maximum task size. 0 is disabled.
 const size_t DEFAULT_MTS = 0;
+// default group commit window in microseconds
+const size_t DEFAULT_GROUP_COMMIT_WINDOW = tx::default_group_commit_window.count();
 
 
 LoggerPtr logger(Logger::getLogger("hyrise"));
@@ -129,6 +132,8 @@ int main(int argc, char *argv[]) {
   std::string logPropertyFile;
   std::string scheduler_name;
   size_t maxTaskSize;
+  std::string redoLogFile;
+  size_t groupCommitWindow;
 
   // Program Options
   po::options_description desc("Allowed Parameters");
@@ -137,6 +142,8 @@ int main(int argc, char *argv[]) {
   ("logdef,l", po::value<std::string>(&logPropertyFile)->default_value("build/log.properties"), "Log4CXX Log Properties File")
   ("maxTaskSize,m", po::value<size_t>(&maxTaskSize)->default_value(DEFAULT_MTS), "Maximum task size used in dynamic parallelization scheduler. Use 0 for unbounded task run time.")
   ("scheduler,s", po::value<std::string>(&scheduler_name)->default_value("CentralScheduler"), "Name of the scheduler to use")
+  ("redoLog,r", po::value<std::string>(&redoLogFile)->default_value(""), "Redo log file, replayed into tables when they are loaded. Empty disables durability.")
+  ("groupCommitWindow,g", po::value<size_t>(&groupCommitWindow)->default_value(DEFAULT_GROUP_COMMIT_WINDOW), "Microseconds a redo log flush waits for further commits")
     // set default number of worker threads to #cores-1, as main thread with event loop is bound to core 0 
   ("threads,t", po::value<int>(&worker_threads)->default_value(getNumberOfCoresOnSystem()-1), "Number of worker threads for scheduler (only relevant for scheduler with fixed number of threads)");
   po::variables_map vm;
@@ -168,6 +175,11 @@ int main(int argc, char *argv[]) {
 
   taskscheduler::SharedScheduler::getInstance().init(scheduler_name, worker_threads, maxTaskSize);
 
+  if (!redoLogFile.empty()) {
+    tx::RedoLog::getInstance().open(redoLogFile, std::chrono::microseconds(groupCommitWindow));
+    LOG4CXX_INFO(logger, "Logging commits to " << redoLogFile);
+  }
+
   // Main Server Loop
   struct ev_loop *loop = ev_default_loop(0);
   ebb_server server;
@@ -185,5 +197,6 @@ int main(int argc, char *argv[]) {
   ev_loop(loop, 0);
   LOG4CXX_INFO(logger, "Stopping Server...");
   ev_default_destroy ();
+  tx::RedoLog::getInstance().close();
   return 0;
 }
@@ -0,0 +1,70 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest-bench.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+#include "taskscheduler/SharedScheduler.h"
+#include "taskscheduler/Task.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+// Throughput of the work-stealing scheduler for tasks that do (almost)
+// nothing, so queue operations and wake-ups dominate
+class SchedulerBase : public ::testing::Benchmark {
+
+ protected:
+
+  const size_t tasks = 100000;
+  std::shared_ptr<AbstractTaskScheduler> scheduler;
+
+  void scheduleAndWait(bool nested) {
+    auto waiter = std::make_shared<WaitTask>();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < tasks; ++i) {
+      std::shared_ptr<Task> task;
+      if (nested) {
+        // tasks spawned by workers go to the deque of their worker
+        auto inner = std::make_shared<SyncTask>();
+        waiter->addDependency(inner);
+        task = std::make_shared<FunctionTask>([this, inner] () { scheduler->schedule(inner); });
+      } else {
+        task = std::make_shared<SyncTask>();
+      }
+      waiter->addDependency(task);
+      scheduler->schedule(task);
+    }
+    scheduler->schedule(waiter);
+    waiter->wait();
+    std::chrono::duration<double> seconds = std::chrono::high_resolution_clock::now() - start;
+    logValue("tasks_per_second", (nested ? 2 : 1) * tasks / seconds.count());
+  }
+
+ public:
+  void BenchmarkSetUp() {
+    SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler");
+    scheduler = SharedScheduler::getInstance().getScheduler();
+  }
+
+  void BenchmarkTearDown() {
+    scheduler = nullptr;
+  }
+
+  SchedulerBase() {
+    SetNumIterations(10);
+    SetWarmUp(2);
+  }
+};
+
+BENCHMARK_F(SchedulerBase, empty_tasks) {
+  scheduleAndWait(false);
+}
+
+BENCHMARK_F(SchedulerBase, nested_empty_tasks) {
+  scheduleAndWait(true);
+}
+
+}
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/BloomFilterScan.h"
+#include "access/HashBuild.h"
+#include "access/HashJoinProbe.h"
+
+#include "io/shortcuts.h"
+#include "storage/AbstractHashTable.h"
+#include "storage/BloomFilter.h"
+#include "testing/TableEqualityTest.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class BloomFilterScanTests : public AccessTest {};
+
+TEST_F(BloomFilterScanTests, filtered_probe_matches_hash_join) {
+  auto build = io::Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+  auto probe = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  HashBuild hb;
+  hb.addInput(build);
+  hb.addField(0);
+  hb.setKey("join");
+  hb.setBloomFilter(true);
+  hb.execute();
+
+  BloomFilterScan bfs;
+  bfs.addInput(probe);
+  bfs.addInput(hb.getResultBloomFilter());
+  bfs.addField(0);
+  bfs.setMorselSize(7);
+  bfs.execute();
+  const auto& filtered = bfs.getResultTable();
+  // Only the first row of lin_xxs holds a value of the build table
+  EXPECT_LT(filtered->size(), probe->size());
+
+  auto join = [&] (storage::c_atable_ptr_t probeTable) {
+    HashJoinProbe hjp;
+    hjp.addInput(probeTable);
+    hjp.addInput(hb.getResultHashTable());
+    hjp.addField(0);
+    hjp.execute();
+    return hjp.getResultTable();
+  };
+  EXPECT_RELATION_EQ(join(probe), join(filtered));
+}
+
+}
+}
@@ -2,6 +2,9 @@
 #include "access/GroupByScan.h"
 #include "access/HashBuild.h"
 #include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
 #include "testing/TableEqualityTest.h"
 #include "testing/test.h"
 
@@ -57,6 +60,56 @@ TEST_F(GroupByScanTests, group_by_with_multiple_fields) {
   EXPECT_RELATION_EQ(reference, result);
 }
 
+TEST_F(GroupByScanTests, group_by_with_flat_hash_table) {
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+  auto reference = io::Loader::shortcuts::load("test/10_30_group_multi_result.tbl");
+
+  HashBuild hb;
+  hb.addInput(t);
+  hb.addField(0);
+  hb.addField(1);
+  hb.setKey("groupby");
+  hb.setFlat(true);
+  hb.execute();
+
+  const auto &hash = hb.getResultHashTable();
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addInput(hash);
+  gs.addField(0);
+  gs.addField(1);
+  gs.execute();
+
+  const auto &result = gs.getResultTable();
+
+  EXPECT_RELATION_EQ(reference, result);
+}
+
+TEST_F(GroupByScanTests, group_by_with_partitioned_hash_table) {
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+  auto reference = io::Loader::shortcuts::load("test/10_30_group_count_result.tbl");
+
+  HashBuild hb;
+  hb.addInput(t);
+  hb.addField(1);
+  hb.setKey("groupby");
+  hb.setPartitions(4);
+  hb.execute();
+
+  const auto &hash = hb.getResultHashTable();
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addFunction(new CountAggregateFun(0));
+  gs.addInput(hash);
+  gs.addField(1);
+  gs.execute();
+
+  const auto &result = gs.getResultTable();
+  EXPECT_RELATION_EQ(reference, result);
+}
+
 TEST_F(GroupByScanTests, group_by_with_aggregate_function) {
   auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
   auto reference = io::Loader::shortcuts::load("test/10_30_group_count_result.tbl");
@@ -81,6 +134,188 @@ TEST_F(GroupByScanTests, group_by_with_aggregate_function) {
   const auto &result = gs.getResultTable();
   EXPECT_RELATION_EQ(reference, result);
 }
+class StreamingGroupByScanTests : public AccessTest {
+ protected:
+  void addFunctions(GroupByScan &gs) {
+    gs.addFunction(new SumAggregateFun(2));
+    gs.addFunction(new AverageAggregateFun(2));
+    gs.addFunction(new MinAggregateFun(3));
+    gs.addFunction(new MaxAggregateFun(4));
+    gs.addFunction(new CountAggregateFun(0));
+  }
+
+  storage::c_atable_ptr_t hashGroupBy(const storage::c_atable_ptr_t &t, const field_list_t &fields) {
+    HashBuild hb;
+    hb.addInput(t);
+    for (const auto &field : fields)
+      hb.addField(field);
+    hb.setKey("groupby");
+    hb.execute();
+
+    GroupByScan gs;
+    gs.addInput(t);
+    gs.addInput(hb.getResultHashTable());
+    for (const auto &field : fields)
+      gs.addField(field);
+    addFunctions(gs);
+    gs.execute();
+    return gs.getResultTable();
+  }
+
+  storage::c_atable_ptr_t streamingGroupBy(const storage::c_atable_ptr_t &t, const field_list_t &fields,
+                                           size_t part = 0, size_t count = 0, size_t denseThreshold = 0) {
+    GroupByScan gs;
+    gs.addInput(t);
+    for (const auto &field : fields)
+      gs.addField(field);
+    addFunctions(gs);
+    gs.setStreaming(true);
+    gs.setDenseThreshold(denseThreshold);
+    gs.setPart(part);
+    gs.setCount(count);
+    gs.execute();
+    return gs.getResultTable();
+  }
+
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+};
+
+TEST_F(StreamingGroupByScanTests, matches_hash_group_by) {
+  EXPECT_RELATION_EQ(hashGroupBy(t, {1}), streamingGroupBy(t, {1}));
+  EXPECT_RELATION_EQ(hashGroupBy(t, {0, 1}), streamingGroupBy(t, {0, 1}));
+}
+
+TEST_F(StreamingGroupByScanTests, min_and_max_of_strings) {
+  auto table = io::Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+
+  GroupByScan gs;
+  gs.addInput(table);
+  gs.addField(0);
+  gs.addFunction(new MinAggregateFun(1));
+  gs.addFunction(new MaxAggregateFun(1));
+  gs.addFunction(new MaxAggregateFun(2));
+  gs.setStreaming(true);
+  gs.execute();
+
+  const auto &result = gs.getResultTable();
+  ASSERT_EQ(result->columnCount(), 4u);
+  for (size_t row = 0; row < result->size(); ++row) {
+    std::string min, max;
+    hyrise_float_t maxC = 0;
+    bool first = true;
+    for (size_t source = 0; source < table->size(); ++source) {
+      if (table->getValue<hyrise_int_t>(0, source) != result->getValue<hyrise_int_t>(0, row))
+        continue;
+      const auto &value = table->getValue<hyrise_string_t>(1, source);
+      min = first || value < min ? value : min;
+      max = first || max < value ? value : max;
+      maxC = first ? table->getValue<hyrise_float_t>(2, source) : std::max(maxC, table->getValue<hyrise_float_t>(2, source));
+      first = false;
+    }
+    EXPECT_EQ(min, result->getValue<hyrise_string_t>(1, row));
+    EXPECT_EQ(max, result->getValue<hyrise_string_t>(2, row));
+    EXPECT_FLOAT_EQ(maxC, result->getValue<hyrise_float_t>(3, row));
+  }
+}
+
+TEST_F(StreamingGroupByScanTests, parallel_instances_own_disjoint_groups) {
+  const size_t instances = 3;
+  size_t groups = 0, rows = 0;
+  for (size_t part = 0; part < instances; ++part) {
+    const auto &result = streamingGroupBy(t, {0, 1}, part, instances);
+    groups += result->size();
+    for (size_t row = 0; row < result->size(); ++row)
+      rows += result->getValue<hyrise_int_t>(6, row);
+  }
+  EXPECT_EQ(hashGroupBy(t, {0, 1})->size(), groups);
+  EXPECT_EQ(t->size(), rows);
+}
+TEST_F(StreamingGroupByScanTests, dense_matches_hash_group_by) {
+  EXPECT_RELATION_EQ(hashGroupBy(t, {1}), streamingGroupBy(t, {1}, 0, 0, 1024));
+  EXPECT_RELATION_EQ(hashGroupBy(t, {0, 1}), streamingGroupBy(t, {0, 1}, 0, 0, 1024));
+
+  // groups are numbered by value ids of ordered dictionaries
+  const auto &result = streamingGroupBy(t, {0, 1}, 0, 0, 1024);
+  for (size_t row = 1; row < result->size(); ++row) {
+    const auto previous = std::make_pair(result->getValue<hyrise_int_t>(0, row - 1), result->getValue<hyrise_int_t>(1, row - 1));
+    EXPECT_LT(previous, std::make_pair(result->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int_t>(1, row)));
+  }
+}
+
+TEST_F(StreamingGroupByScanTests, dense_parallel_instances_own_disjoint_groups) {
+  const size_t instances = 3;
+  size_t groups = 0, rows = 0;
+  for (size_t part = 0; part < instances; ++part) {
+    const auto &result = streamingGroupBy(t, {0, 1}, part, instances, 1024);
+    groups += result->size();
+    for (size_t row = 0; row < result->size(); ++row)
+      rows += result->getValue<hyrise_int_t>(6, row);
+  }
+  EXPECT_EQ(hashGroupBy(t, {0, 1})->size(), groups);
+  EXPECT_EQ(t->size(), rows);
+}
+
+TEST_F(StreamingGroupByScanTests, dense_merge_ignores_groups_a_task_did_not_see) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("group");
+  list.append().set_type("INTEGER").set_name("value");
+  auto table = storage::TableBuilder::build(list, false);
+
+  // enough rows for several tasks, group 0 only occurs in the first one
+  const size_t rows = 3 * 64 * 1024;
+  table->resize(rows);
+  table->setValue<hyrise_int_t>(0, 0, 0);
+  table->setValue<hyrise_int_t>(1, 0, -5);
+  table->setValue<hyrise_int_t>(0, 1, 1);
+  table->setValue<hyrise_int_t>(1, 1, -1);
+  for (size_t row = 2; row < rows; ++row) {
+    table->setValueId(0, row, table->getValueId(0, 1));
+    table->setValueId(1, row, table->getValueId(1, 1));
+  }
+
+  GroupByScan gs;
+  gs.addInput(table);
+  gs.addField(0);
+  gs.addFunction(new MaxAggregateFun(1));
+  gs.addFunction(new MinAggregateFun(1));
+  gs.addFunction(new CountAggregateFun(1));
+  gs.setStreaming(true);
+  gs.setDenseThreshold(1024);
+  gs.execute();
+
+  const auto &result = gs.getResultTable();
+  ASSERT_EQ(2u, result->size());
+  EXPECT_EQ(-5, result->getValue<hyrise_int_t>(1, 0));
+  EXPECT_EQ(-5, result->getValue<hyrise_int_t>(2, 0));
+  EXPECT_EQ(1, result->getValue<hyrise_int_t>(3, 0));
+  EXPECT_EQ(-1, result->getValue<hyrise_int_t>(1, 1));
+  EXPECT_EQ(-1, result->getValue<hyrise_int_t>(2, 1));
+  EXPECT_EQ(static_cast<hyrise_int_t>(rows - 1), result->getValue<hyrise_int_t>(3, 1));
+
+  // the partial state of a task that did not see a group holds no value
+  MaxAggregateFun max(1);
+  max.walk(*table);
+  aggregate_state_t state = aggregate_state_t(), empty = aggregate_state_t();
+  const pos_t first = 0;
+  aggregate_state_t *states[] = {&state};
+  max.accumulate(table, &first, states, 1, 0);
+  max.combine(table, state, empty);
+  EXPECT_EQ(-5, state.integer);
+  EXPECT_EQ(1u, state.count);
+}
+
+TEST_F(StreamingGroupByScanTests, dense_falls_back_for_delta_rows) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/10_30_group.tbl"));
+  auto ctx = tx::TransactionManager::beginTransaction();
+  auto writeArea = store->appendToDelta(1);
+  store->copyRowToDelta(store, 0, writeArea.first, ctx.tid);
+
+  const auto &result = streamingGroupBy(store, {1}, 0, 0, 1024);
+  size_t rows = 0;
+  for (size_t row = 0; row < result->size(); ++row)
+    rows += result->getValue<hyrise_int_t>(5, row);
+  EXPECT_EQ(store->size(), rows);
+}
 
 }
 }
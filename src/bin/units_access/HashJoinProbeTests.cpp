@@ -4,6 +4,8 @@
 
 #include "io/shortcuts.h"
 #include "storage/AbstractHashTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
 #include "testing/TableEqualityTest.h"
 #include "testing/test.h"
 
@@ -39,5 +41,101 @@ TEST_F(HashJoinProbeTests, DISABLED_basic_hash_join_probe_test) {
   EXPECT_RELATION_EQ(result, reference);
 }
 
+class HashJoinProbeTypeTests : public AccessTest {
+ protected:
+  storage::c_atable_ptr_t join(const storage::c_atable_ptr_t &probe, const storage::c_atable_ptr_t &build,
+                               ProbeJoinType::type joinType, bool dictionary = false) {
+    HashBuild hb;
+    hb.addInput(build);
+    hb.addField(1);
+    hb.setKey("join");
+    hb.setDictionary(dictionary);
+    hb.execute();
+
+    HashJoinProbe hjp;
+    hjp.addInput(probe);
+    hjp.addInput(hb.getResultHashTable());
+    hjp.addField(0);
+    hjp.setJoinType(joinType);
+    hjp.execute();
+    return hjp.getResultTable();
+  }
+
+  storage::c_atable_ptr_t rows(const storage::c_atable_ptr_t &table, std::vector<pos_t> positions) {
+    return storage::PointerCalculator::create(table, new pos_list_t(positions));
+  }
+
+  // The rows of one side of a join result, 0 being the probe and 1 the
+  // build side
+  std::shared_ptr<const storage::PointerCalculator> paddedSide(const storage::c_atable_ptr_t &result, size_t side) {
+    auto vertical = std::dynamic_pointer_cast<const storage::MutableVerticalTable>(result);
+    return std::dynamic_pointer_cast<const storage::PointerCalculator>(vertical->getContainer(side));
+  }
+
+  storage::c_atable_ptr_t companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  storage::c_atable_ptr_t employees = io::Loader::shortcuts::load("test/tables/employees.tbl");
+};
+
+TEST_F(HashJoinProbeTypeTests, semi_and_anti_join) {
+  // employees of the companies 1 and 3
+  auto build = rows(employees, {0, 2, 3});
+
+  const auto &semi = join(companies, build, ProbeJoinType::SEMI);
+  ASSERT_EQ(2u, semi->size());
+  EXPECT_EQ(companies->columnCount(), semi->columnCount());
+  EXPECT_EQ(1, semi->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(3, semi->getValue<hyrise_int_t>(0, 1));
+
+  const auto &anti = join(companies, build, ProbeJoinType::ANTI);
+  ASSERT_EQ(2u, anti->size());
+  EXPECT_EQ(2, anti->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(4, anti->getValue<hyrise_int_t>(0, 1));
+}
+
+TEST_F(HashJoinProbeTypeTests, left_outer_join) {
+  auto build = rows(employees, {0, 2, 3});
+  const auto &result = join(companies, build, ProbeJoinType::LEFT_OUTER);
+  ASSERT_EQ(5u, result->size());
+  EXPECT_EQ(3u, join(companies, build, ProbeJoinType::INNER)->size());
+
+  // Microsoft and Oracle have no employee, their padding reads as default
+  // values and is only recognizable by its position past the build input
+  const auto &padded = paddedSide(result, 1);
+  for (size_t row = 3; row < 5; ++row) {
+    EXPECT_EQ(0, result->getValue<hyrise_int_t>(2, row));
+    EXPECT_EQ("", result->getValue<hyrise_string_t>(4, row));
+    EXPECT_EQ(build->size(), padded->getPositions()->at(row));
+  }
+  for (size_t row = 0; row < 3; ++row)
+    EXPECT_LT(padded->getPositions()->at(row), build->size());
+  EXPECT_EQ("Microsoft", result->getValue<hyrise_string_t>(1, 3));
+  EXPECT_EQ("Oracle", result->getValue<hyrise_string_t>(1, 4));
+}
+
+TEST_F(HashJoinProbeTypeTests, right_outer_join) {
+  // Apple and SAP
+  auto probe = rows(companies, {0, 2});
+  const auto &result = join(probe, employees, ProbeJoinType::RIGHT_OUTER);
+  ASSERT_EQ(6u, result->size());
+
+  // Steve Balmer, Larry Page and Jeffrey O. Henley work elsewhere
+  const auto &padded = paddedSide(result, 0);
+  for (size_t row = 3; row < 6; ++row) {
+    EXPECT_EQ(0, result->getValue<hyrise_int_t>(0, row));
+    EXPECT_EQ("", result->getValue<hyrise_string_t>(1, row));
+    EXPECT_EQ(probe->size(), padded->getPositions()->at(row));
+  }
+  EXPECT_EQ(2, result->getValue<hyrise_int_t>(2, 3));
+  EXPECT_EQ(5, result->getValue<hyrise_int_t>(2, 4));
+  EXPECT_EQ(6, result->getValue<hyrise_int_t>(2, 5));
+}
+
+TEST_F(HashJoinProbeTypeTests, dictionary_join_matches_hash_join) {
+  const auto &reference = join(companies, employees, ProbeJoinType::INNER);
+  const auto &result = join(companies, employees, ProbeJoinType::INNER, true);
+  ASSERT_EQ(6u, result->size());
+  EXPECT_RELATION_EQ(reference, result);
+}
+
 }
 }
@@ -27,5 +27,24 @@ TEST_F(JoinScanTests, basic_join_scan_test) {
   ASSERT_TABLE_EQUAL(result, reference);
 }
 
+TEST_F(JoinScanTests, band_join_scan_test) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto employees = io::Loader::shortcuts::load("test/tables/employees.tbl");
+
+  // Employees of the same or the preceding company
+  JoinScan js(JoinType::BAND);
+  js.addInput(companies);
+  js.addInput(employees);
+  js.setBand(0, 1, 0, 1);
+  js.execute();
+
+  const auto &result = js.getResultTable();
+  ASSERT_EQ(10u, result->size());
+  for (size_t row = 0; row < result->size(); ++row) {
+    const auto difference = result->getValue<hyrise_int_t>(0, row) - result->getValue<hyrise_int_t>(3, row);
+    EXPECT_TRUE(difference == 0 || difference == 1);
+  }
+}
+
 }
 }
@@ -26,5 +26,20 @@ TEST_F(MergeTableTests, basic_merge_table_test) {
   ASSERT_TABLE_EQUAL(result, reference);
 }
 
+TEST_F(MergeTableTests, parallel_merge_table_test) {
+  auto s = io::Loader::shortcuts::loadMainDelta("test/merge1_main.tbl", "test/merge1_delta.tbl");
+  auto reference = io::Loader::shortcuts::load("test/merge1_result.tbl");
+
+  MergeTable mt;
+  mt.setParallel(true);
+  mt.addInput(s);
+  mt.execute();
+
+  const auto &result = mt.getResultTable();
+
+  ASSERT_EQ(9u, result->size());
+  ASSERT_TABLE_EQUAL(result, reference);
+}
+
 }
 }
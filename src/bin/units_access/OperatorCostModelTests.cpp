@@ -0,0 +1,79 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "access/system/OperatorCostModel.h"
+
+namespace hyrise {
+namespace access {
+
+class OperatorCostModelTests : public AccessTest {};
+
+const size_t rows = 1000000;
+
+TEST_F(OperatorCostModelTests, returns_prior_without_samples) {
+  OperatorCostModel model;
+  double a, b;
+  model.estimate(rows, 100, 20, a, b);
+  EXPECT_NEAR(100, a, 1e-9);
+  EXPECT_NEAR(20, b, 1e-9);
+}
+
+TEST_F(OperatorCostModelTests, ignores_small_inputs) {
+  OperatorCostModel model;
+  model.record(OperatorCostModel::MIN_TABLE_SIZE - 1, 1, 1000);
+  EXPECT_EQ(0, model.weight());
+}
+
+TEST_F(OperatorCostModelTests, rescales_prior_for_single_instance_count) {
+  // the host is twice as slow as the static coefficients assume
+  OperatorCostModel model;
+  for (size_t i = 0; i < 100; ++i)
+    model.record(rows, 1, 240);
+  double a, b;
+  model.estimate(rows, 100, 20, a, b);
+  EXPECT_NEAR(200, a, 2);
+  EXPECT_NEAR(40, b, 2);
+}
+
+TEST_F(OperatorCostModelTests, fits_model_to_runtimes) {
+  OperatorCostModel model;
+  for (size_t i = 0; i < 50; ++i) {
+    for (size_t instances : {1, 2, 4, 8})
+      model.record(rows, instances, 300.0 / instances + 50);
+  }
+  double a, b;
+  model.estimate(rows, 100, 20, a, b);
+  EXPECT_NEAR(300, a, 3);
+  EXPECT_NEAR(50, b, 3);
+  // a and b grow with the input
+  model.estimate(2 * rows, 200, 40, a, b);
+  EXPECT_NEAR(600, a, 6);
+  EXPECT_NEAR(100, b, 6);
+}
+
+TEST_F(OperatorCostModelTests, follows_recent_runtimes) {
+  OperatorCostModel model;
+  for (size_t i = 0; i < 100; ++i) {
+    for (size_t instances : {1, 2, 4, 8})
+      model.record(rows, instances, 300.0 / instances + 50);
+  }
+  for (size_t i = 0; i < 100; ++i) {
+    for (size_t instances : {1, 2, 4, 8})
+      model.record(rows, instances, 150.0 / instances + 25);
+  }
+  double a, b;
+  model.estimate(rows, 100, 20, a, b);
+  EXPECT_NEAR(150, a, 2);
+  EXPECT_NEAR(25, b, 2);
+}
+
+TEST_F(OperatorCostModelTests, models_are_kept_per_operator) {
+  OperatorCostModels::getInstance().reset();
+  OperatorCostModels::getInstance().get("ScanA").record(rows, 1, 100);
+  EXPECT_LT(0, OperatorCostModels::getInstance().get("ScanA").weight());
+  EXPECT_EQ(0, OperatorCostModels::getInstance().get("ScanB").weight());
+  OperatorCostModels::getInstance().reset();
+  EXPECT_EQ(0, OperatorCostModels::getInstance().get("ScanA").weight());
+}
+
+} } // namespace hyrise::access
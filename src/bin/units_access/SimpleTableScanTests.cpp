@@ -1,8 +1,15 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
 #include "access/SimpleTableScan.h"
 #include "access/expressions/predicates.h"
 #include "access/UnionAll.h"
 #include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+#include "taskscheduler/SharedScheduler.h"
 #include "testing/test.h"
 
 namespace hyrise {
@@ -25,6 +32,149 @@ TEST_F(SimpleTableScanTests, basic_simple_table_scan_test) {
   ASSERT_EQ(100, result->getValue<storage::hyrise_int_t>(0, 0));
 }
 
+TEST_F(SimpleTableScanTests, compressed_main_scan_test) {
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/lin_xxs.tbl", io::Loader::params().setCompressed(true));
+  storage::c_atable_ptr_t reference = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  auto scan = [] (storage::c_atable_ptr_t table, SimpleExpression *expr) {
+    SimpleTableScan sts;
+    sts.addInput(table);
+    sts.setPredicate(expr);
+    sts.execute();
+    return sts.getResultTable();
+  };
+
+  auto equals = scan(t, new EqualsExpression<storage::hyrise_int_t>(t, 0, 100));
+  ASSERT_EQ(1u, equals->size());
+  ASSERT_EQ(100, equals->getValue<storage::hyrise_int_t>(0, 0));
+
+  auto between = scan(t, new BetweenExpression<storage::hyrise_int_t>(t, 1, 15, 55));
+  auto between_ref = scan(reference, new BetweenExpression<storage::hyrise_int_t>(reference, 1, 15, 55));
+  ASSERT_EQ(4u, between->size());
+  ASSERT_TABLE_EQUAL(between_ref, between);
+}
+
+TEST_F(SimpleTableScanTests, batch_evaluation_matches_row_evaluation) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl", io::Loader::params().setCompressed(true)));
+  store->resizeDelta(4);
+  std::vector<storage::hyrise_int_t> delta_values = {15, 25, 995, 1};
+  for (size_t row = 0; row < delta_values.size(); ++row) {
+    store->copyRowToDelta(store, row, row, 1);
+    store->getDeltaTable()->setValue<storage::hyrise_int_t>(1, row, delta_values[row]);
+  }
+  storage::c_atable_ptr_t t = store;
+
+  std::vector<std::function<SimpleExpression*()>> expressions = {
+    [&] () { return new EqualsExpression<storage::hyrise_int_t>(t, 0, 100); },
+    [&] () { return new LessThanExpression<storage::hyrise_int_t>(t, 1, 50); },
+    [&] () { return new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 500); },
+    [&] () { return new BetweenExpression<storage::hyrise_int_t>(t, 1, 15, 55); },
+    [&] () { return new CompoundExpression(new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 200),
+                                           new LessThanExpression<storage::hyrise_int_t>(t, 2, 500), AND); },
+    [&] () { return new CompoundExpression(new EqualsExpression<storage::hyrise_int_t>(t, 0, 100),
+                                           new BetweenExpression<storage::hyrise_int_t>(t, 1, 900, 1000), OR); },
+    [&] () { return new CompoundExpression(new BetweenExpression<storage::hyrise_int_t>(t, 1, 15, 55), nullptr, NOT); }
+  };
+
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    std::unique_ptr<SimpleExpression> expr(expressions[i]());
+    expr->walk({t});
+
+    pos_list_t all, reference;
+    for (size_t row = 0; row < t->size(); ++row) {
+      all.push_back(row);
+      if ((*expr)(row)) {
+        reference.push_back(row);
+      }
+    }
+
+    pos_list_t evaluated;
+    expr->evaluate(0, t->size(), evaluated);
+    EXPECT_EQ(reference, evaluated) << "evaluate() of expression " << i;
+
+    // Starting in the middle of the main must not skip or duplicate rows
+    pos_list_t tail;
+    expr->evaluate(37, t->size(), tail);
+    pos_list_t tail_reference;
+    std::copy_if(reference.begin(), reference.end(), std::back_inserter(tail_reference),
+                 [] (pos_t row) { return row >= 37; });
+    EXPECT_EQ(tail_reference, tail) << "evaluate() from row 37 of expression " << i;
+
+    expr->refine(all);
+    EXPECT_EQ(reference, all) << "refine() of expression " << i;
+  }
+}
+
+TEST_F(SimpleTableScanTests, zone_maps_skip_blocks) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl", io::Loader::params().setCompressed(true)));
+  store->getMainTable()->buildZoneMaps(8);
+  storage::c_atable_ptr_t t = store;
+
+  auto evaluate = [] (SimpleExpression *raw, storage::c_atable_ptr_t table) {
+    std::unique_ptr<SimpleExpression> expr(raw);
+    expr->walk({table});
+    pos_list_t positions;
+    expr->evaluate(0, table->size(), positions);
+    return positions;
+  };
+
+  EXPECT_EQ(pos_list_t({2, 3, 4, 5}), evaluate(new BetweenExpression<storage::hyrise_int_t>(t, 1, 15, 55), t));
+  EXPECT_EQ(pos_list_t({97, 98, 99}), evaluate(new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 961), t));
+  EXPECT_EQ(pos_list_t({0, 1}), evaluate(new LessThanExpression<storage::hyrise_int_t>(t, 1, 12), t));
+  EXPECT_EQ(pos_list_t({50}), evaluate(new EqualsExpression<storage::hyrise_int_t>(t, 0, 500), t));
+}
+
+TEST_F(SimpleTableScanTests, morsel_driven_scan_matches_serial_scan) {
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  auto scan = [&t] (size_t morsel_size, bool positions) {
+    SimpleTableScan sts;
+    sts.addInput(t);
+    sts.setPredicate(new CompoundExpression(new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 200),
+                                            new LessThanExpression<storage::hyrise_int_t>(t, 2, 800), AND));
+    sts.setProducesPositions(positions);
+    sts.setMorselSize(morsel_size);
+    sts.execute();
+    return sts.getResultTable();
+  };
+
+  for (bool positions : {true, false}) {
+    auto reference = scan(0, positions);
+    ASSERT_EQ(60u, reference->size());
+    // Morsels that do not align with the expression chunks and a tail morsel
+    for (size_t morsel_size : {1, 7, 64}) {
+      ASSERT_TABLE_EQUAL(reference, scan(morsel_size, positions));
+    }
+  }
+}
+
+TEST_F(SimpleTableScanTests, validated_scan_skips_deleted_rows) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl"));
+  storage::c_atable_ptr_t t = store;
+
+  auto deleteCtx = tx::TransactionManager::beginTransaction();
+  ASSERT_EQ(tx::TX_CODE::TX_OK, store->markForDeletion(98, deleteCtx.tid));
+  tx::TransactionManager::getInstance()[deleteCtx.tid].deletePos(store, 98);
+  tx::TransactionManager::commitTransaction(deleteCtx);
+
+  auto scan = [&t] (bool validate) {
+    SimpleTableScan sts;
+    sts.setTXContext(tx::TransactionManager::beginTransaction());
+    sts.addInput(t);
+    sts.setPredicate(new GreaterThanExpression<storage::hyrise_int_t>(t, 1, 961));
+    sts.setValidate(validate);
+    sts.execute();
+    return sts.getResultTable();
+  };
+
+  EXPECT_EQ(3u, scan(false)->size());
+  auto validated = scan(true);
+  ASSERT_EQ(2u, validated->size());
+  EXPECT_EQ(970, validated->getValue<storage::hyrise_int_t>(0, 0));
+  EXPECT_EQ(990, validated->getValue<storage::hyrise_int_t>(0, 1));
+}
+
 // Same as above, but manually parallelized
 TEST_F(SimpleTableScanTests, parallelized_simple_table_scan) {
   storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/lin_xxs.tbl");
@@ -0,0 +1,101 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/SortMergeJoin.h"
+#include "access/radixjoin/RadixHashJoin.h"
+
+#include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
+#include "testing/TableEqualityTest.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class SortMergeJoinTests : public AccessTest {
+ protected:
+  storage::c_atable_ptr_t sortMergeJoin(storage::c_atable_ptr_t left, storage::c_atable_ptr_t right,
+                                        field_t leftField, field_t rightField) {
+    SortMergeJoin smj;
+    smj.addInput(left);
+    smj.addInput(right);
+    smj.addField(leftField);
+    smj.addField(rightField);
+    smj.execute();
+    return smj.getResultTable();
+  }
+};
+
+TEST_F(SortMergeJoinTests, join_matches_reference) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto employees = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  auto reference = io::Loader::shortcuts::load("test/tables/companies_employees_joined.tbl");
+
+  EXPECT_RELATION_EQ(reference, sortMergeJoin(companies, employees, 0, 1));
+}
+
+TEST_F(SortMergeJoinTests, string_join_matches_hash_join) {
+  auto left = io::Loader::shortcuts::load("test/tables/hash_table_test4.tbl");
+  auto right = io::Loader::shortcuts::load("test/tables/hash_table_test3.tbl");
+
+  RadixHashJoin rhj;
+  rhj.addInput(left);
+  rhj.addInput(right);
+  rhj.addField(1);
+  rhj.addField(1);
+  rhj.execute();
+
+  const auto &result = sortMergeJoin(left, right, 1, 1);
+  ASSERT_GT(result->size(), 0u);
+  EXPECT_RELATION_EQ(rhj.getResultTable(), result);
+}
+
+TEST_F(SortMergeJoinTests, joins_delta_rows) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto employees = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  const auto joined = sortMergeJoin(companies, employees, 0, 1)->size();
+
+  // Rows of the delta are not covered by the main dictionary
+  auto ctx = tx::TransactionManager::beginTransaction();
+  auto writeArea = employees->appendToDelta(2);
+  employees->copyRowToDelta(employees, 0, writeArea.first, ctx.tid);
+  employees->copyRowToDelta(employees, 1, writeArea.first + 1, ctx.tid);
+
+  const auto &result = sortMergeJoin(companies, employees, 0, 1);
+  ASSERT_EQ(joined + 2, result->size());
+  const size_t rightColumn = companies->columnCount() + 1;
+  for (size_t row = 0; row < result->size(); ++row)
+    EXPECT_EQ(result->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int_t>(rightColumn, row));
+}
+
+TEST_F(SortMergeJoinTests, joins_mixed_integer_widths) {
+  storage::TableBuilder::param_list wide;
+  wide.append().set_type("INTEGER").set_name("key");
+  auto left = storage::TableBuilder::build(wide, false);
+  const std::vector<hyrise_int_t> leftKeys = {3, 1, (hyrise_int_t(1) << 33) + 1, 3, -5, 2};
+  left->resize(leftKeys.size());
+  for (size_t row = 0; row < leftKeys.size(); ++row)
+    left->setValue<hyrise_int_t>(0, row, leftKeys[row]);
+
+  storage::TableBuilder::param_list narrow;
+  narrow.append().set_type("INTEGER_NO_DICT").set_name("key");
+  auto right = storage::TableBuilder::build(narrow, false);
+  const std::vector<hyrise_int32_t> rightKeys = {7, -5, 3, 1};
+  right->resize(rightKeys.size());
+  for (size_t row = 0; row < rightKeys.size(); ++row)
+    right->setValue<hyrise_int32_t>(0, row, rightKeys[row]);
+
+  // the wide key that truncates to 1 must not match
+  const auto &result = sortMergeJoin(left, right, 0, 0);
+  ASSERT_EQ(4u, result->size());
+  for (size_t row = 0; row < result->size(); ++row)
+    EXPECT_EQ(result->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int32_t>(1, row));
+
+  const auto &swapped = sortMergeJoin(right, left, 0, 0);
+  ASSERT_EQ(4u, swapped->size());
+  for (size_t row = 0; row < swapped->size(); ++row)
+    EXPECT_EQ(swapped->getValue<hyrise_int_t>(1, row), swapped->getValue<hyrise_int32_t>(0, row));
+}
+
+}
+}
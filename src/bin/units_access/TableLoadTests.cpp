@@ -37,6 +37,23 @@ TEST_F(TableLoadTests, table_load_existing_test) {
   ASSERT_TRUE(result->contentEquals(t));
 }
 
+TEST_F(TableLoadTests, table_load_on_numa_node_test) {
+  TableLoad tl;
+  tl.setFileName("lin_xxs.tbl");
+  tl.setTableName("myNumaTable");
+  tl.setNumaNode(0);
+  tl.execute();
+
+  const auto &result = tl.getResultTable();
+  ASSERT_EQ(0, result->numaNode());
+  // successors of the load run where the table is
+  EXPECT_EQ(0, tl.getActualNode());
+
+  TableLoad consumer;
+  consumer.addInput(result);
+  EXPECT_EQ(0, consumer.getPreferredNode());
+}
+
 TEST_F(TableLoadTests, raw_table_load_test) {
   TableLoad tl;
   tl.setFileName("lin_xxs.tbl");
@@ -56,4 +56,31 @@ TEST(TableScan, testDynamicParallelization) {
   ASSERT_GT(dynamicCount2, dynamicCount1); 
 }
 
+TEST(TableScan, testDynamicParallelizationUsesIdleWorkers) {
+  OperatorCostModels::getInstance().reset();
+  auto tbl = io::Loader::shortcuts::load("test/tables/companies.tbl");
+
+  auto eq = make_unique<EqualsExpression<hyrise_string_t>>(0, 1, "Apple Inc");
+  auto resizedTbl = tbl->copy_structure();
+  resizedTbl->resize(10000000); // 10 million
+  auto fakeTask = std::make_shared<Barrier>();
+  fakeTask->addInput(resizedTbl);
+  fakeTask->addField(0);
+  auto ts = std::make_shared<TableScan>(std::move(eq));
+  ts->addDependency(fakeTask);
+  (*fakeTask)();
+
+  // without a task size limit only idle workers make splitting worthwhile
+  EXPECT_EQ(1u, ts->determineDynamicCount(0));
+  auto dynamicCount = ts->determineDynamicCount(0, 4);
+  EXPECT_EQ(4u, dynamicCount);
+  EXPECT_LE(ts->determineDynamicCount(20), ts->determineDynamicCount(20, 64));
+
+  // instances report their runtimes to the TableScan model
+  ts->determineDynamicCount(0, 4);
+  EXPECT_EQ("TableScan", ts->getCalibration().op);
+  EXPECT_EQ(4u, ts->getCalibration().instances);
+  EXPECT_EQ(10000000u, ts->getCalibration().tableSize);
+}
+
 }}
@@ -21,14 +21,20 @@ typedef std::shared_ptr<storage::AbstractTable> tbl_ptr;
 storage::c_atable_ptr_t join(const tbl_ptr &left,
                              const tbl_ptr &right,
                              const std::vector<size_t> &fields_left,
-                             const std::vector<size_t> &fields_right) {
+                             const std::vector<size_t> &fields_right,
+                             bool flat = false,
+                             size_t partitions = 1,
+                             size_t morselSize = 0) {
   HashBuild hashBuild;
   hashBuild.addInput(left);
   hashBuild.setKey("join");
+  hashBuild.setFlat(flat);
+  hashBuild.setPartitions(partitions);
   for (auto & field_left: fields_left) hashBuild.addField(field_left);
   auto hashes = hashBuild.execute()->getResultHashTable();
 
   hyrise::access::HashJoinProbe hjp;  
+  hjp.setMorselSize(morselSize);
   hjp.addInput(right);
   for (auto & field_right: fields_right) hjp.addField(field_right);
   hjp.addInput(hashes);
@@ -63,6 +69,39 @@ TEST_P(HashTestJoinIdentical, join_identical) {
   EXPECT_RELATION_EQ(result, reference);
 }
 
+TEST_P(HashTestJoinIdentical, flat_join_identical) {
+  auto params = GetParam();
+  auto left = io::Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", header_a);
+  auto right = io::Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", header_b);
+
+  auto result = join(left, right, params.fields, params.fields, true);
+  auto reference = io::Loader::shortcuts::load(params.result);
+
+  EXPECT_RELATION_EQ(result, reference);
+}
+
+TEST_P(HashTestJoinIdentical, partitioned_join_identical) {
+  auto params = GetParam();
+  auto left = io::Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", header_a);
+  auto right = io::Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", header_b);
+
+  auto result = join(left, right, params.fields, params.fields, true, 4);
+  auto reference = io::Loader::shortcuts::load(params.result);
+
+  EXPECT_RELATION_EQ(result, reference);
+}
+
+TEST_P(HashTestJoinIdentical, morsel_probe_join_identical) {
+  auto params = GetParam();
+  auto left = io::Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", header_a);
+  auto right = io::Loader::shortcuts::loadWithStringHeader("test/tables/hash_table_test.tbl", header_b);
+
+  auto result = join(left, right, params.fields, params.fields, true, 1, 3);
+  auto reference = io::Loader::shortcuts::load(params.result);
+
+  EXPECT_RELATION_EQ(result, reference);
+}
+
 class HashTestJoinIdenticalWithDelta : public ::testing::TestWithParam<identicalJoinParams_t> {};
 /* TODO: Add string header_a and header_b
 TEST_P(HashTestJoinIdenticalWithDelta, join_identical) {
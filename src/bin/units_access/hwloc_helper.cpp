@@ -33,5 +33,32 @@ TEST_F(HwLocHelperTest, get_node_for_core){
   }
 }
 
+TEST_F(HwLocHelperTest, synthetic_numa_topology){
+  hwloc_topology_t topology;
+  hwloc_topology_init(&topology);
+  ASSERT_EQ(0, hwloc_topology_set_synthetic(topology, "node:2 core:4 pu:1"));
+  hwloc_topology_load(topology);
+
+  EXPECT_EQ(2u, getNumberOfNodes(topology));
+  EXPECT_EQ((std::vector<unsigned> {0, 1, 2, 3}), getCoresForNode(topology, 0));
+  EXPECT_EQ((std::vector<unsigned> {4, 5, 6, 7}), getCoresForNode(topology, 1));
+  EXPECT_EQ(0u, getNodeForCore(topology, 3));
+  EXPECT_EQ(1u, getNodeForCore(topology, 4));
+  hwloc_topology_destroy(topology);
+}
+
+TEST_F(HwLocHelperTest, bind_memory_on_single_node_is_noop){
+  hwloc_topology_t topology;
+  hwloc_topology_init(&topology);
+  ASSERT_EQ(0, hwloc_topology_set_synthetic(topology, "core:4 pu:1"));
+  hwloc_topology_load(topology);
+
+  EXPECT_EQ(1u, getNumberOfNodes(topology));
+  EXPECT_EQ(0u, getNodeForCore(topology, 2));
+  std::vector<int> data(1024);
+  EXPECT_TRUE(bindMemoryToNode(topology, data.data(), data.size() * sizeof(int), 0));
+  hwloc_topology_destroy(topology);
+}
+
 }
 }
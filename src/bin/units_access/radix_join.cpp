@@ -6,6 +6,7 @@
 #include "helper.h"
 #include "io/shortcuts.h"
 #include "access/radixjoin/NestedLoopEquiJoin.h"
+#include "access/radixjoin/RadixHashJoin.h"
 #include "testing/TableEqualityTest.h"
 #include <storage/TableBuilder.h>
 #include "access/RadixJoin.h"
@@ -798,6 +799,106 @@ TEST_F(RadixJoinTest, determine_dynamic_count) {
   ASSERT_GT(dynamicCount2, dynamicCount1);
 }
 
+TEST_F(RadixJoinTest, radix_partition_two_passes) {
+  std::vector<radix_tuple_t> tuples;
+  for (size_t i = 0; i < 1000; ++i)
+    tuples.push_back({(i * 0x9e3779b97f4a7c15ULL) >> 7, i});
+
+  const auto bounds = radixPartition(tuples, 3, 2);
+  ASSERT_EQ(33u, bounds.size());
+  ASSERT_EQ(1000u, bounds.back());
+
+  std::vector<bool> seen(1000, false);
+  for (size_t p = 0; p + 1 < bounds.size(); ++p) {
+    for (size_t i = bounds[p]; i < bounds[p + 1]; ++i) {
+      // the first pass selects the group of partitions, the second one the partition in it
+      EXPECT_EQ(p, (tuples[i].hash & 7) * 4 + ((tuples[i].hash >> 3) & 3));
+      EXPECT_EQ((tuples[i].pos * 0x9e3779b97f4a7c15ULL) >> 7, tuples[i].hash);
+      seen[tuples[i].pos] = true;
+    }
+  }
+  EXPECT_EQ(std::vector<bool>(1000, true), seen);
+}
+
+TEST_F(RadixJoinTest, radix_hash_join_matches_reference) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto employees = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  auto reference = io::Loader::shortcuts::load("test/tables/companies_employees_joined.tbl");
+
+  RadixHashJoin join;
+  join.addInput(companies);
+  join.addInput(employees);
+  join.addField(0);
+  join.addField(1);
+  join.execute();
+
+  EXPECT_RELATION_EQ(reference, join.getResultTable());
+}
+
+TEST_F(RadixJoinTest, radix_hash_join_partition_bits) {
+  auto probe = io::Loader::shortcuts::load("test/tables/hash_table_test4.tbl");
+  auto build = io::Loader::shortcuts::load("test/tables/hash_table_test3.tbl");
+
+  auto join = [&] (uint32_t bits1, uint32_t bits2) {
+    RadixHashJoin rhj;
+    rhj.addInput(probe);
+    rhj.addInput(build);
+    rhj.addField(0);
+    rhj.addField(0);
+    rhj.setBits1(bits1);
+    rhj.setBits2(bits2);
+    rhj.execute();
+    return rhj.getResultTable();
+  };
+
+  const auto result = join(0, 0);
+  ASSERT_GT(result->size(), 0u);
+  const size_t buildColumn = probe->columnCount();
+  for (size_t row = 0; row < result->size(); ++row)
+    ASSERT_EQ(result->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int_t>(buildColumn, row));
+  EXPECT_RELATION_EQ(result, join(4, 0));
+  EXPECT_RELATION_EQ(result, join(3, 3));
+}
+
+TEST_F(RadixJoinTest, radix_hash_join_mixed_integer_widths) {
+  TableBuilder::param_list wide;
+  wide.append().set_type("INTEGER").set_name("key");
+  auto probe = TableBuilder::build(wide, false);
+  const std::vector<hyrise_int_t> probeKeys = {1, 2, 3, 3, -5, (hyrise_int_t(1) << 33) + 1};
+  probe->resize(probeKeys.size());
+  for (size_t row = 0; row < probeKeys.size(); ++row)
+    probe->setValue<hyrise_int_t>(0, row, probeKeys[row]);
+
+  TableBuilder::param_list narrow;
+  narrow.append().set_type("INTEGER_NO_DICT").set_name("key");
+  auto build = TableBuilder::build(narrow, false);
+  const std::vector<hyrise_int32_t> buildKeys = {1, 3, -5, 7};
+  build->resize(buildKeys.size());
+  for (size_t row = 0; row < buildKeys.size(); ++row)
+    build->setValue<hyrise_int32_t>(0, row, buildKeys[row]);
+
+  auto join = [] (storage::c_atable_ptr_t left, storage::c_atable_ptr_t right) {
+    RadixHashJoin rhj;
+    rhj.addInput(left);
+    rhj.addInput(right);
+    rhj.addField(0);
+    rhj.addField(0);
+    rhj.execute();
+    return rhj.getResultTable();
+  };
+
+  // the wide key that truncates to 1 must not match
+  const auto result = join(probe, build);
+  ASSERT_EQ(4u, result->size());
+  for (size_t row = 0; row < result->size(); ++row)
+    EXPECT_EQ(result->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int32_t>(1, row));
+
+  const auto swapped = join(build, probe);
+  ASSERT_EQ(4u, swapped->size());
+  for (size_t row = 0; row < swapped->size(); ++row)
+    EXPECT_EQ(swapped->getValue<hyrise_int_t>(1, row), swapped->getValue<hyrise_int32_t>(0, row));
+}
+
 class RadixDynamicCountTest : public AccessTest, public ::testing::WithParamInterface<int> {
   protected:
     virtual void SetUp() {
@@ -826,6 +927,7 @@ class RadixDynamicCountTest : public AccessTest, public ::testing::WithParamInte
       waiter->addDependency(radix);
 
       auto dynamicCount = GetParam();
+      radix->setCalibration({"RadixJoin", 100000, static_cast<size_t>(dynamicCount)});
 
       tasks = radix->applyDynamicParallelization(dynamicCount);
 
@@ -849,6 +951,21 @@ TEST_P(RadixDynamicCountTest, concrete_radix_is_dependency) {
   ASSERT_TRUE(waiter->isDependency(finalOp));
 }
 
+TEST_P(RadixDynamicCountTest, join_runs_as_radix_hash_join) {
+  ASSERT_EQ(1u, tasks.size());
+  ASSERT_TRUE((bool) std::dynamic_pointer_cast<RadixHashJoin>(tasks.back()));
+}
+
+TEST_P(RadixDynamicCountTest, only_parallel_join_calibrates) {
+  const auto& calibration = std::dynamic_pointer_cast<PlanOperation>(tasks.back())->getCalibration();
+  if (GetParam() > 1) {
+    EXPECT_EQ("RadixJoin", calibration.op);
+    EXPECT_EQ(static_cast<size_t>(GetParam()), calibration.instances);
+  } else {
+    EXPECT_EQ(0u, calibration.instances);
+  }
+}
+
 TEST_P(RadixDynamicCountTest, execute_and_check_result) {
   auto finalOp = std::dynamic_pointer_cast<PlanOperation>(tasks.back());
   tasks.push_back(waiter);
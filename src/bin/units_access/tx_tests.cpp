@@ -6,6 +6,8 @@
 #include "helper.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "access/Delete.h"
 #include "access/InsertScan.h"
@@ -362,7 +364,7 @@ TEST_F(TransactionTests, delete_op_with_commit_and_concurrent_read) {
 
   // Acquire the TX Lock
   auto& txmgr = hyrise::tx::TransactionManager::getInstance();
-  writeCtx.cid = txmgr.prepareCommit();
+  writeCtx.cid = txmgr.prepareCommit(writeCtx.tid);
 
   // write commit id to simulate transaction in the process of committing
   linxxxs->commitPositions(*(pc->getPositions()), writeCtx.cid, false);
@@ -688,6 +690,112 @@ TEST_F(TransactionTests, update_and_merge) {
   ASSERT_EQ(99, r1->getValue<hyrise_int_t>(1,4));
 }
 
+TEST_F(TransactionTests, online_merge_with_running_transactions) {
+  size_t before = linxxxs->size();
+
+  // Uncommitted insert that ends up in the frozen delta
+  auto writeCtx = tx::TransactionManager::getInstance().buildContext();
+  InsertScan is;
+  is.setTXContext(writeCtx);
+  is.addInput(linxxxs);
+  is.setInputData(one_row);
+  is.execute();
+
+  linxxxs->freezeDelta();
+  ASSERT_EQ(1u, linxxxs->getFrozenDeltaTable()->size());
+  ASSERT_EQ(0u, linxxxs->getDeltaTable()->size());
+
+  // Writes during the merge go to the new delta
+  auto secondCtx = tx::TransactionManager::getInstance().buildContext();
+  InsertScan is2;
+  is2.setTXContext(secondCtx);
+  is2.addInput(linxxxs);
+  is2.setInputData(second_row);
+  is2.execute();
+  ASSERT_EQ(before + 1, linxxxs->deltaOffset());
+
+  linxxxs->mergeFrozenDelta();
+  ASSERT_TRUE(linxxxs->getFrozenDeltaTable() == nullptr);
+  ASSERT_EQ(before + 1, linxxxs->getMainTable()->size());
+  ASSERT_EQ(1u, linxxxs->getDeltaTable()->size());
+
+  // Both transactions still commit the rows they wrote
+  Commit c;
+  c.addInput(linxxxs);
+  c.setTXContext(writeCtx);
+  c.execute();
+
+  Commit c2;
+  c2.addInput(linxxxs);
+  c2.setTXContext(secondCtx);
+  c2.execute();
+
+  auto readCtx = tx::TransactionManager::getInstance().buildContext();
+  ProjectionScan ps;
+  ps.addField(0);
+  ps.setTXContext(readCtx);
+  ps.addInput(linxxxs);
+  ps.execute();
+
+  ValidatePositions vp;
+  vp.setTXContext(readCtx);
+  vp.addInput(ps.getResultTable());
+  vp.execute();
+
+  auto r1 = vp.getResultTable();
+  ASSERT_EQ(before + 2, r1->size());
+  ASSERT_EQ(99, r1->getValue<hyrise_int_t>(0, before));
+  ASSERT_EQ(22, r1->getValue<hyrise_int_t>(0, before + 1));
+}
+
+TEST_F(TransactionTests, online_merge_with_concurrent_readers) {
+  const size_t before = linxxxs->size();
+  const size_t merges = 20;
+  // Rows below are written and committed, readers may check them
+  std::atomic<size_t> readable(before);
+  std::atomic<bool> done(false);
+  std::atomic<size_t> mismatches(0);
+
+  auto read = [&] () {
+    while (!done) {
+      const size_t rows = readable;
+      for (size_t row = 0; row < rows; ++row) {
+        const auto expected = row < before ? linxxxs_ref->getValue<hyrise_int_t>(0, row) : 99;
+        if (linxxxs->getValue<hyrise_int_t>(0, row) != expected)
+          ++mismatches;
+      }
+    }
+  };
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < 4; ++i)
+    readers.emplace_back(read);
+
+  for (size_t i = 0; i < merges; ++i) {
+    auto writeCtx = tx::TransactionManager::getInstance().buildContext();
+    InsertScan is;
+    is.setTXContext(writeCtx);
+    is.addInput(linxxxs);
+    is.setInputData(one_row);
+    is.execute();
+
+    Commit c;
+    c.addInput(linxxxs);
+    c.setTXContext(writeCtx);
+    c.execute();
+    ++readable;
+
+    linxxxs->freezeDelta();
+    linxxxs->mergeFrozenDelta();
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+
+  ASSERT_EQ(0u, mismatches.load());
+  ASSERT_EQ(before + merges, linxxxs->getMainTable()->size());
+  ASSERT_EQ(before + merges, linxxxs->size());
+}
+
 TEST_F(TransactionTests, delete_rollback) {
   auto writeCtx = tx::TransactionManager::beginTransaction();
   auto pc = storage::PointerCalculator::create(linxxxs, new pos_list_t({0}));
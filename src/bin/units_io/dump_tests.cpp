@@ -9,12 +9,15 @@
 #include <fstream>
 #include <vector>
 
+#include <io/BinaryTableDump.h>
 #include <io/CSVLoader.h>
 #include <io/EmptyLoader.h>
 #include <io/Loader.h>
 #include <io/shortcuts.h>
 #include <io/TableDump.h>
 #include <storage/AbstractTable.h>
+#include <storage/BitCompressedVector.h>
+#include <storage/MappedDictionary.h>
 #include <storage/Store.h>
 #include <storage/TableMerger.h>
 #include <storage/AbstractMergeStrategy.h>
@@ -158,5 +161,63 @@ TEST_F(DumpTests, simple_dump_should_not_dump_delta) {
   ASSERT_TABLE_EQUAL(t, simpleTable);
 }
 
+TEST_F(DumpTests, binary_dump_load_all) {
+  auto dumper = hyrise::storage::BinaryTableDump("./test/dump");
+  ASSERT_TRUE(dumper.dump("simple", simpleTable));
+
+  BinaryDumpLoader input("./test/dump", "simple");
+  auto t = Loader::load(Loader::params().setInput(input));
+  ASSERT_EQ(100u, t->size());
+  ASSERT_TABLE_EQUAL(t, simpleTable);
+
+  // The checkpoint is adopted, not parsed into new structures
+  auto main = std::dynamic_pointer_cast<hyrise::storage::Store>(t)->getMainTable();
+  ASSERT_TRUE(std::dynamic_pointer_cast<storage::BitCompressedVector<value_id_t>>(main->getAttributeVectors(0).at(0).attribute_vector) != nullptr);
+  ASSERT_TRUE(std::dynamic_pointer_cast<storage::MappedDictionary<hyrise_int_t>>(main->dictionaryAt(0)) != nullptr);
+}
+
+TEST_F(DumpTests, binary_dump_strings_and_partitions) {
+  for (const auto& file : {"test/alltypes.tbl", "test/partitioned_test.tbl"}) {
+    for (bool compressed : {false, true}) {
+      auto table = Loader::shortcuts::load(file, Loader::params().setCompressed(compressed));
+      auto dumper = hyrise::storage::BinaryTableDump("./test/dump");
+      ASSERT_TRUE(dumper.dump("typed", table));
+
+      BinaryDumpLoader input("./test/dump", "typed");
+      auto t = Loader::load(Loader::params().setInput(input));
+      ASSERT_EQ(table->partitionCount(), t->partitionCount());
+      ASSERT_TABLE_EQUAL(t, table);
+    }
+  }
+}
+
+TEST_F(DumpTests, binary_dump_can_be_modified_and_merged) {
+  auto table = Loader::shortcuts::load("test/alltypes.tbl");
+  auto dumper = hyrise::storage::BinaryTableDump("./test/dump");
+  ASSERT_TRUE(dumper.dump("typed", table));
+
+  BinaryDumpLoader input("./test/dump", "typed");
+  auto s = std::dynamic_pointer_cast<hyrise::storage::Store>(Loader::load(Loader::params().setInput(input)));
+  const auto rows = s->size();
+  ASSERT_EQ(2u, s->getValueIdForValue<hyrise_string_t>(1, "s").valueId);
+
+  s->resizeDelta(1);
+  s->getDeltaTable()->setValue<hyrise_int_t>(0, 0, 42);
+  s->getDeltaTable()->setValue<hyrise_string_t>(1, 0, "a");
+  s->getDeltaTable()->setValue<hyrise_float_t>(2, 0, 1.5);
+  ASSERT_EQ(tx::TX_CODE::TX_OK, s->commitPositions({rows}, 0, true));
+  s->merge();
+
+  ASSERT_EQ(rows + 1, s->size());
+  ASSERT_EQ(42, s->getValue<hyrise_int_t>(0, rows));
+  ASSERT_EQ("a", s->getValue<hyrise_string_t>(1, rows));
+  ASSERT_EQ("s", s->getValue<hyrise_string_t>(1, 0));
+}
+
+TEST_F(DumpTests, binary_dump_load_missing_checkpoint) {
+  BinaryDumpLoader input("./test/dump", "missing");
+  ASSERT_THROW(Loader::load(Loader::params().setInput(input)), Loader::Error);
+}
+
 } } // namespace hyrise::io
 
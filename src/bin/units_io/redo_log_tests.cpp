@@ -0,0 +1,182 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "io/BinaryTableDump.h"
+#include "io/CSVLoader.h"
+#include "io/RedoLog.h"
+#include "io/shortcuts.h"
+#include "io/StorageManager.h"
+#include "io/TableDump.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace tx {
+
+static const char *redo_log_file = "test/redo.log";
+static const char *checkpoint_dir = "./test/dump";
+
+class RedoLogTests : public ::hyrise::Test {
+ protected:
+  virtual void SetUp() {
+    io::StorageManager::getInstance()->removeAll();
+    std::remove(redo_log_file);
+  }
+
+  virtual void TearDown() {
+    RedoLog::getInstance().close();
+    io::StorageManager::getInstance()->removeAll();
+    std::remove(redo_log_file);
+    boost::filesystem::remove_all(checkpoint_dir);
+  }
+
+  storage::store_ptr_t loadStore(const std::string& name) {
+    auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl"));
+    io::StorageManager::getInstance()->loadTable(name, store);
+    return store;
+  }
+
+  // Inserts a copy of row src of store within the transaction ctx
+  void insertCopy(const storage::store_ptr_t& store, TXContext ctx, pos_t src) {
+    locking::SharedLockGuard deltaLock(store->deltaWriteLock());
+    auto writeArea = store->appendToDelta(1);
+    store->copyRowToDelta(store, src, writeArea.first, ctx.tid);
+    TransactionManager::getInstance()[ctx.tid].insertPos(store, store->deltaOffset() + writeArea.first);
+  }
+
+  // Takes a checkpoint the way DumpTable does, commits another row and
+  // restarts from the checkpoint
+  void checkpointAndRestart(bool binary) {
+    RedoLog::getInstance().open(redo_log_file);
+    auto store = loadStore("redo_table");
+
+    auto first = TransactionManager::beginTransaction();
+    insertCopy(store, first, 3);
+    TransactionManager::commitTransaction(first);
+
+    const auto lsn = RedoLog::getInstance().merge(store);
+    ASSERT_LT(0u, lsn);
+    if (binary) {
+      ASSERT_TRUE(storage::BinaryTableDump(checkpoint_dir).dump("redo_table", store, lsn, "redo_table"));
+    } else {
+      ASSERT_TRUE(storage::SimpleTableDump(checkpoint_dir).dump("redo_table", store, lsn, "redo_table"));
+    }
+    // The only logged table is checkpointed, its records are trimmed
+    const auto logSize = boost::filesystem::file_size(redo_log_file);
+    RedoLog::getInstance().checkpointed("redo_table", lsn);
+    EXPECT_GT(logSize, boost::filesystem::file_size(redo_log_file));
+
+    auto second = TransactionManager::beginTransaction();
+    insertCopy(store, second, 5);
+    TransactionManager::commitTransaction(second);
+    RedoLog::getInstance().close();
+
+    // Replaying the first commit or the merge again would fail, its row is
+    // in the main of the checkpoint
+    io::StorageManager::getInstance()->removeAll();
+    RedoLog::getInstance().open(redo_log_file);
+    storage::store_ptr_t replayed;
+    if (binary) {
+      io::BinaryDumpLoader input(checkpoint_dir, "redo_table");
+      replayed = std::dynamic_pointer_cast<storage::Store>(io::Loader::load(io::Loader::params().setInput(input)));
+    } else {
+      io::TableDumpLoader input(checkpoint_dir, "redo_table");
+      io::CSVHeader header(std::string(checkpoint_dir) + "/redo_table/header.dat", io::CSVHeader::params().setCSVParams(io::csv::HYRISE_FORMAT));
+      replayed = std::dynamic_pointer_cast<storage::Store>(io::Loader::load(io::Loader::params().setInput(input).setHeader(header)));
+    }
+    io::StorageManager::getInstance()->loadTable("redo_table", replayed);
+
+    ASSERT_EQ(store->size(), replayed->size());
+    const auto last = TransactionManager::getInstance().getLastCommitId();
+    ASSERT_EQ(store->buildValidPositions(last, MERGE_TID), replayed->buildValidPositions(last, MERGE_TID));
+    for (size_t row = 0; row < store->size(); ++row) {
+      for (size_t col = 0; col < store->columnCount(); ++col) {
+        ASSERT_EQ(store->getValue<hyrise_int_t>(col, row), replayed->getValue<hyrise_int_t>(col, row));
+      }
+    }
+  }
+};
+
+TEST_F(RedoLogTests, replays_committed_transactions) {
+  RedoLog::getInstance().open(redo_log_file);
+  auto store = loadStore("redo_table");
+
+  auto first = TransactionManager::beginTransaction();
+  insertCopy(store, first, 3);
+  ASSERT_EQ(TX_CODE::TX_OK, store->markForDeletion(1, first.tid));
+  TransactionManager::getInstance()[first.tid].deletePos(store, 1);
+  TransactionManager::commitTransaction(first);
+
+  // Leaves an invisible row behind that is not logged
+  auto aborted = TransactionManager::beginTransaction();
+  insertCopy(store, aborted, 4);
+  TransactionManager::rollbackTransaction(aborted);
+
+  auto second = TransactionManager::beginTransaction();
+  insertCopy(store, second, 5);
+  TransactionManager::commitTransaction(second);
+  RedoLog::getInstance().close();
+
+  io::StorageManager::getInstance()->removeAll();
+  RedoLog::getInstance().open(redo_log_file);
+  auto replayed = loadStore("redo_table");
+
+  ASSERT_EQ(store->size(), replayed->size());
+  const auto last = TransactionManager::getInstance().getLastCommitId();
+  ASSERT_EQ(store->buildValidPositions(last, MERGE_TID), replayed->buildValidPositions(last, MERGE_TID));
+  for (const auto& row : store->buildValidPositions(last, MERGE_TID)) {
+    for (size_t col = 0; col < store->columnCount(); ++col) {
+      ASSERT_EQ(store->getValue<hyrise_int_t>(col, row), replayed->getValue<hyrise_int_t>(col, row));
+    }
+  }
+  EXPECT_FALSE(replayed->isVisibleForTransaction(1, last, MERGE_TID));
+}
+
+TEST_F(RedoLogTests, checkpoint_skips_contained_records) {
+  checkpointAndRestart(true);
+}
+
+TEST_F(RedoLogTests, text_checkpoint_skips_contained_records) {
+  checkpointAndRestart(false);
+}
+
+TEST_F(RedoLogTests, logs_tables_while_registered) {
+  auto store = loadStore("redo_table");
+  EXPECT_EQ("redo_table", RedoLog::getInstance().tableName(store));
+
+  auto replacement = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl"));
+  io::StorageManager::getInstance()->replaceTable("redo_table", replacement);
+  EXPECT_EQ("", RedoLog::getInstance().tableName(store));
+  EXPECT_EQ("redo_table", RedoLog::getInstance().tableName(replacement));
+
+  io::StorageManager::getInstance()->removeTable("redo_table");
+  EXPECT_EQ("", RedoLog::getInstance().tableName(replacement));
+}
+
+TEST_F(RedoLogTests, concurrent_commits_share_flushes) {
+  const size_t threads = 8;
+  RedoLog::getInstance().open(redo_log_file, std::chrono::milliseconds(100));
+  auto store = loadStore("redo_table");
+
+  std::vector<std::thread> committers;
+  for (size_t i = 0; i < threads; ++i) {
+    committers.emplace_back([&, i] () {
+        auto ctx = TransactionManager::beginTransaction();
+        insertCopy(store, ctx, i);
+        TransactionManager::commitTransaction(ctx);
+      });
+  }
+  for (auto& committer : committers) {
+    committer.join();
+  }
+
+  EXPECT_LT(RedoLog::getInstance().flushCount(), threads);
+}
+
+} } // namespace hyrise::tx
@@ -37,6 +37,50 @@ TEST(BitCompressedTests, empty_size_does_not_change_with_reserve) {
   ASSERT_EQ(128u, tuples.capacity());
 }
 
+TEST(BitCompressedTests, decode_range_matches_get) {
+  for (uint64_t bit = 1; bit <= 32; ++bit) {
+    std::vector<uint64_t> bits {3, bit, 32};
+    size_t rows = 1500;
+    BitCompressedVector<value_id_t> tuples(bits.size(), rows, bits);
+    tuples.resize(rows);
+    auto maxval = maxValueForBits<value_id_t>(bit);
+    for (size_t row = 0; row < rows; ++row) {
+      tuples.set(0, row, row % 8);
+      tuples.set(1, row, (row * 2654435761u) & maxval);
+      tuples.set(2, row, row);
+    }
+
+    std::vector<value_id_t> decoded(rows);
+    tuples.decodeRange(1, 7, rows, decoded.data());
+    for (size_t row = 7; row < rows; ++row) {
+      ASSERT_EQ(tuples.get(1, row), decoded[row - 7]) << "bits " << bit << " row " << row;
+    }
+  }
+}
+
+TEST(BitCompressedTests, scan_between_and_equals) {
+  std::vector<uint64_t> bits {5, 11};
+  size_t rows = 3000;
+  BitCompressedVector<value_id_t> tuples(bits.size(), rows, bits);
+  tuples.resize(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    tuples.set(0, row, row % 32);
+    tuples.set(1, row, row % 2000);
+  }
+
+  pos_list_t equals;
+  tuples.scanEquals(1, 42, 0, rows, equals);
+  ASSERT_EQ((pos_list_t {42, 2042}), equals);
+
+  pos_list_t between;
+  tuples.scanBetween(0, 3, 4, 10, 100, between);
+  ASSERT_EQ((pos_list_t {35, 36, 67, 68, 99}), between);
+
+  pos_list_t empty;
+  tuples.scanBetween(0, 4, 3, 0, rows, empty);
+  ASSERT_TRUE(empty.empty());
+}
+
 TEST(FixedLengthVectorTest, increment_test) {
   size_t cols = 1;
   size_t rows = 3;
@@ -0,0 +1,47 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "io/shortcuts.h"
+#include "storage/AbstractTable.h"
+#include "storage/BloomFilter.h"
+
+namespace hyrise {
+namespace storage {
+
+class BloomFilterTests : public ::hyrise::Test {};
+
+TEST_F(BloomFilterTests, inserted_keys_are_found) {
+  BloomFilter filter(1000);
+  for (uint64_t key = 0; key < 1000; ++key) {
+    filter.insert(key * 0x9e3779b97f4a7c15ull);
+  }
+  for (uint64_t key = 0; key < 1000; ++key) {
+    EXPECT_TRUE(filter.mayContain(key * 0x9e3779b97f4a7c15ull));
+  }
+}
+
+TEST_F(BloomFilterTests, filters_rows_of_other_tables_by_value) {
+  auto build = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto probe = io::Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+
+  BloomFilter filter(build, {0});
+  for (pos_t row = 0; row < build->size(); ++row) {
+    EXPECT_TRUE(filter.mayContain(build, {0}, row));
+  }
+
+  // Only the rows with value 0 have a partner in lin_xxs, the others are
+  // dropped unless they are false positives
+  pos_list_t positions;
+  filter.filter(probe, {0}, 0, probe->size(), positions);
+  pos_list_t matches;
+  std::copy_if(positions.begin(), positions.end(), std::back_inserter(matches), [&probe] (pos_t row) {
+      return probe->getValue<hyrise_int_t>(0, row) == 0;
+    });
+  EXPECT_EQ(pos_list_t({0, 2, 3}), matches);
+  EXPECT_LT(positions.size(), probe->size());
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,67 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/DictionaryJoinTable.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace storage {
+
+class DictionaryJoinTableTests : public ::hyrise::Test {};
+
+TEST_F(DictionaryJoinTableTests, groups_rows_by_value_id) {
+  auto table = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  auto ht = DictionaryJoinTable::build(table, 1);
+  ASSERT_NE(nullptr, ht);
+  EXPECT_EQ(table->size(), ht->size());
+  EXPECT_EQ(4u, ht->numKeys());
+
+  for (pos_t row = 0; row < table->size(); ++row) {
+    const auto positions = ht->get(table, {1}, row);
+    ASSERT_FALSE(positions.empty());
+    for (const auto &position : positions)
+      EXPECT_EQ(table->getValue<hyrise_int_t>(1, row), table->getValue<hyrise_int_t>(1, position));
+  }
+  // Probing the build table itself needs no translation
+  EXPECT_EQ(nullptr, ht->translation(table->dictionaryByTableId(1, 0)));
+}
+
+TEST_F(DictionaryJoinTableTests, translates_ordered_dictionaries) {
+  auto build = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto probe = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  auto ht = DictionaryJoinTable::build(build, 0);
+  ASSERT_NE(nullptr, ht);
+
+  // employee ids 1 to 6 against company ids 1 to 4
+  const size_t npos = AbstractFlatHashTable::npos;
+  const std::vector<size_t> expected {0, 1, 2, 3, npos, npos};
+  EXPECT_EQ(expected, *ht->translation(probe->dictionaryByTableId(0, 0)));
+
+  pos_list_t buildPositions, probePositions;
+  ht->probe(probe, {0}, 0, probe->size(), buildPositions, probePositions);
+  EXPECT_EQ((pos_list_t {0, 1, 2, 3}), buildPositions);
+  EXPECT_EQ((pos_list_t {0, 1, 2, 3}), probePositions);
+}
+
+TEST_F(DictionaryJoinTableTests, probes_delta_rows) {
+  auto build = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto probe = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  auto ht = DictionaryJoinTable::build(build, 0);
+
+  auto ctx = tx::TransactionManager::beginTransaction();
+  auto writeArea = probe->appendToDelta(1);
+  probe->copyRowToDelta(probe, 5, writeArea.first, ctx.tid);
+  const pos_t deltaRow = probe->size() - 1;
+
+  // The delta dictionary is not ordered, its values are looked up
+  EXPECT_EQ(3u, ht->find(probe, {1}, deltaRow));
+  const size_t npos = AbstractFlatHashTable::npos;
+  EXPECT_EQ(npos, ht->find(probe, {0}, deltaRow));
+
+  // Rows of a delta cannot be addressed by main value ids
+  EXPECT_EQ(nullptr, DictionaryJoinTable::build(probe, 1));
+}
+
+} } // namespace hyrise::storage
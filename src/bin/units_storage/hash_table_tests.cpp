@@ -2,11 +2,15 @@
 #include "testing/test.h"
 
 #include <time.h>
+#include <algorithm>
 
 #include "helper/stringhelpers.h"
 #include "io/shortcuts.h"
+#include "storage/FlatHashTable.h"
 #include "storage/HashTable.h"
 #include "storage/Store.h"
+#include "storage/TableGenerator.h"
+#include "storage/TableRangeView.h"
 
 namespace hyrise {
 namespace storage {
@@ -200,5 +204,94 @@ TYPED_TEST(HashTableViewTest, partial_range) {
   }
 }
 
-} } // namespace hyrise::storage
+template <typename T>
+class FlatHashTableTest : public ::hyrise::Test {
+protected:
+  hyrise::storage::atable_ptr_t table;
+  virtual void SetUp() {
+    table = io::Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+  }
+};
+
+typedef ::testing::Types<aggregate_single_key_t, join_single_key_t> flat_key_types;
+TYPED_TEST_CASE(FlatHashTableTest, flat_key_types);
+
+TYPED_TEST(FlatHashTableTest, matches_hash_table) {
+  for (auto & cols: combinations) {
+    SCOPED_TRACE(joinString(cols, ","));
+    auto flat = buildFlatHashTable<TypeParam>(this->table, cols);
+    auto reference = std::make_shared<AggregateHashTable>(this->table, cols);
+    EXPECT_EQ(this->table->size(), flat->size());
+    EXPECT_EQ(reference->numKeys(), flat->numKeys());
+    for (pos_t row = 0; row < this->table->size(); ++row) {
+      auto positions = flat->get(this->table, cols, row);
+      auto expected = reference->get(this->table, cols, row);
+      std::sort(expected.begin(), expected.end());
+      EXPECT_EQ(expected, positions);
+    }
+  }
+}
+
+TYPED_TEST(FlatHashTableTest, merge_keeps_groups) {
+  field_list_t columns {0, 1};
+  const size_t split = this->table->size() / 2;
+  auto first = std::make_shared<TableRangeView>(this->table, 0, split);
+  auto second = std::make_shared<TableRangeView>(this->table, split, this->table->size());
+
+  std::vector<std::shared_ptr<const AbstractHashTable> > parts {
+    buildFlatHashTable<TypeParam>(first, columns), buildFlatHashTable<TypeParam>(second, columns, split)};
+  auto merged = mergeFlatHashTables<TypeParam>(parts);
+  auto reference = buildFlatHashTable<TypeParam>(this->table, columns);
 
+  ASSERT_EQ(reference->numKeys(), merged->numKeys());
+  for (pos_t row = 0; row < this->table->size(); ++row) {
+    EXPECT_EQ(reference->get(this->table, columns, row), merged->get(this->table, columns, row));
+  }
+}
+
+TYPED_TEST(FlatHashTableTest, partitioned_matches_flat) {
+  // Spans several chunks of the partitioned build
+  auto table = TableGenerator(true).int_random(3 * PartitionedFlatHashTable<TypeParam, 1>::chunk_rows + 17, 2);
+  for (auto & cols: std::vector<field_list_t> {{0}, {0, 1}}) {
+    SCOPED_TRACE(joinString(cols, ","));
+    auto partitioned = buildPartitionedFlatHashTable<TypeParam>(table, cols, 6, 5);
+    auto reference = buildFlatHashTable<TypeParam>(table, cols, 5);
+
+    EXPECT_EQ(reference->numKeys(), partitioned->numKeys());
+    EXPECT_EQ(table->size(), partitioned->size());
+    size_t positions = 0;
+    for (size_t group = 0; group < partitioned->numKeys(); ++group) {
+      positions += partitioned->groupEnd(group) - partitioned->groupBegin(group);
+    }
+    EXPECT_EQ(table->size(), positions);
+    for (pos_t row = 0; row < table->size(); row += 7) {
+      ASSERT_EQ(reference->get(table, cols, row), partitioned->get(table, cols, row));
+    }
+  }
+}
+
+TYPED_TEST(FlatHashTableTest, batched_probe_matches_get) {
+  // Probes a build table with itself, every row finds at least its own
+  auto build = TableGenerator(true).int_random(3 * probe_batch_rows + 5, 2);
+  auto probe = build;
+  field_list_t columns {0};
+
+  std::vector<std::shared_ptr<AbstractFlatHashTable> > tables {
+    buildFlatHashTable<TypeParam>(build, columns), buildPartitionedFlatHashTable<TypeParam>(build, columns, 4)};
+  for (const auto &hashTable : tables) {
+    pos_list_t expectedBuild, expectedProbe;
+    for (pos_t row = 0; row < probe->size(); ++row) {
+      auto matches = hashTable->get(probe, columns, row);
+      expectedBuild.insert(expectedBuild.end(), matches.begin(), matches.end());
+      expectedProbe.insert(expectedProbe.end(), matches.size(), row);
+    }
+
+    pos_list_t buildPositions, probePositions;
+    hashTable->probe(probe, columns, 0, probe->size(), buildPositions, probePositions);
+    EXPECT_LE(probe->size(), buildPositions.size());
+    EXPECT_EQ(expectedBuild, buildPositions);
+    EXPECT_EQ(expectedProbe, probePositions);
+  }
+}
+
+} } // namespace hyrise::storage
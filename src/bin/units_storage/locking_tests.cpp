@@ -0,0 +1,43 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "helper/locking.h"
+
+namespace hyrise {
+namespace locking {
+
+class SharedSpinlockTests : public ::hyrise::Test {};
+
+TEST_F(SharedSpinlockTests, contending_exclusive_lockers_take_turns) {
+  SharedSpinlock lock;
+  const size_t iterations = 10000;
+  size_t counter = 0;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 2; ++t) {
+    threads.emplace_back([&]() {
+      for (size_t i = 0; i < iterations; ++i) {
+        std::lock_guard<SharedSpinlock> guard(lock);
+        ++counter;
+        // let the other locker announce its request during the hold
+        std::this_thread::yield();
+      }
+    });
+  }
+  threads.emplace_back([&]() {
+    for (size_t i = 0; i < iterations; ++i) {
+      SharedLockGuard guard(lock);
+    }
+  });
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(2 * iterations, counter);
+}
+
+}
+}
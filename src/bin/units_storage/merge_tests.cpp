@@ -9,12 +9,15 @@
 #include "io/shortcuts.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/ParallelMerger.h"
 #include "storage/Store.h"
 #include "storage/TableGenerator.h"
 
 #include "helper/types.h"
 #include "helper/vector_helpers.h"
 
+#include "taskscheduler/SharedScheduler.h"
+
 namespace hyrise { namespace storage {
 
 class MergeTests : public ::hyrise::Test {};
@@ -129,6 +132,36 @@ TEST_F(MergeTests, row_wise_merger_vs_simple_merge_test) {
 }
 
 
+TEST_F(MergeTests, parallel_merger_vs_sequential_heap_merger_test) {
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  TableGenerator g(true);
+  hyrise::storage::atable_ptr_t main = g.int_random(1000, 5);
+  hyrise::storage::atable_ptr_t delta = g.int_random_delta(1000, 5);
+
+  std::vector<hyrise::storage::c_atable_ptr_t > tables;
+  tables.push_back(main);
+  tables.push_back(delta);
+
+  std::vector<bool> valid(2000);
+  for (size_t i = 0; i < valid.size(); ++i) {
+    valid[i] = (i % 7) != 3;
+  }
+
+  for (bool useValid : {false, true}) {
+    for (bool compress : {false, true}) {
+      TableMerger sequential(new DefaultMergeStrategy(), new SequentialHeapMerger(), compress);
+      const auto& result_sequential = sequential.merge(tables, useValid, valid);
+
+      // Small chunks so that chunks cross the boundary between main and delta
+      TableMerger parallel(new DefaultMergeStrategy(), new ParallelMerger(128), compress);
+      const auto& result_parallel = parallel.merge(tables, useValid, valid);
+
+      ASSERT_EQ(result_sequential[0]->size(), result_parallel[0]->size());
+      ASSERT_TRUE(result_sequential[0]->contentEquals(result_parallel[0]));
+    }
+  }
+}
+
 TEST_F(MergeTests, simple_merger_delta_test) {
   TableGenerator g(true);
   hyrise::storage::atable_ptr_t main1 = g.int_random(1000, 1);
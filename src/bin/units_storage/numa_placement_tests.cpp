@@ -0,0 +1,40 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace storage {
+
+class NumaPlacementTests : public ::hyrise::Test {};
+
+TEST_F(NumaPlacementTests, tables_start_unplaced) {
+  auto table = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  const int none = AbstractTable::NO_NUMA_NODE;
+  EXPECT_EQ(none, table->numaNode());
+}
+
+TEST_F(NumaPlacementTests, place_main_on_node) {
+  auto table = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  auto reference = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  table->placeOnNode(0);
+
+  EXPECT_EQ(0, table->numaNode());
+  EXPECT_TRUE(table->contentEquals(reference));
+
+  // positions are resolved in the placed table
+  auto pc = PointerCalculator::create(table, new pos_list_t {0, 2});
+  EXPECT_EQ(0, pc->numaNode());
+}
+
+TEST_F(NumaPlacementTests, merge_keeps_placement) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  ASSERT_NE(nullptr, store);
+  store->placeOnNode(0);
+  store->merge();
+  EXPECT_EQ(0, store->numaNode());
+}
+
+} } // namespace hyrise::storage
@@ -3,6 +3,9 @@
 #include "helper.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
 
 #include <io/shortcuts.h>
 #include <storage/Store.h>
@@ -65,12 +68,84 @@ TEST_F(VisibilityTests, check_tx_prepare_commit) {
 	auto lc = ctx.lastCid;
 
 	ASSERT_EQ(hyrise::tx::UNKNOWN, lc);
-	ASSERT_EQ(lc + 1, txmgr.tryPrepareCommit());
+	ASSERT_EQ(lc + 1, txmgr.tryPrepareCommit(ctx.tid));
 	txmgr.commit(ctx.tid);
 	ASSERT_EQ(lc + 1, txmgr.getLastCommitId());
 	ASSERT_ANY_THROW(txmgr.commit(hyrise::tx::UNKNOWN)) << "Double commit is not allowed";
 }
 
+TEST_F(VisibilityTests, concurrent_commits_become_visible_in_order) {
+	auto&	 txmgr = hyrise::tx::TransactionManager::getInstance();
+	auto first = txmgr.buildContext();
+	auto second = txmgr.buildContext();
+	auto lc = first.lastCid;
+
+	ASSERT_EQ(lc + 1, txmgr.prepareCommit(first.tid));
+	ASSERT_EQ(lc + 2, txmgr.prepareCommit(second.tid));
+
+	// The second commit completes first but has to wait for the first one
+	std::atomic<bool> done(false);
+	std::thread committer([&] () {
+			txmgr.commit(second.tid);
+			done = true;
+		});
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_FALSE(done);
+	EXPECT_EQ(lc, txmgr.getLastCommitId());
+
+	txmgr.commit(first.tid);
+	committer.join();
+	ASSERT_EQ(lc + 2, txmgr.getLastCommitId());
+}
+
+TEST_F(VisibilityTests, snapshot_visibility_is_cached_and_advanced) {
+	auto&	 txmgr = hyrise::tx::TransactionManager::getInstance();
+	auto lc = txmgr.getLastCommitId();
+
+	auto before = linxxxs->snapshotVisibility(lc);
+	ASSERT_EQ(before, linxxxs->snapshotVisibility(lc)) << "Snapshot of a published commit id is cached";
+	ASSERT_EQ(linxxxs->size(), before->count());
+
+	// Insert a row and delete row 0 in two commits
+	auto tid = txmgr.buildContext().tid;
+	linxxxs->resizeDelta(1);
+	linxxxs->copyRowToDelta(one_row, 0, 0, tid);
+	auto cid = txmgr.prepareCommit(tid);
+	ASSERT_EQ(hyrise::tx::TX_CODE::TX_OK, linxxxs->commitPositions({linxxxs->size() - 1}, cid, true));
+	txmgr.commit(tid);
+
+	tid = txmgr.buildContext().tid;
+	ASSERT_EQ(hyrise::tx::TX_CODE::TX_OK, linxxxs->markForDeletion(0, tid));
+	cid = txmgr.prepareCommit(tid);
+	ASSERT_EQ(hyrise::tx::TX_CODE::TX_OK, linxxxs->commitPositions({0}, cid, false));
+	txmgr.commit(tid);
+
+	auto after = linxxxs->snapshotVisibility(txmgr.getLastCommitId());
+	ASSERT_EQ(linxxxs->buildValidPositions(txmgr.getLastCommitId(), hyrise::tx::MERGE_TID).size(), after->count());
+	EXPECT_FALSE(after->test(0));
+	EXPECT_TRUE(after->test(linxxxs->size() - 1));
+
+	// Older snapshots are computed, not taken from the cache
+	auto old = linxxxs->snapshotVisibility(lc);
+	EXPECT_TRUE(old->test(0));
+	EXPECT_FALSE(old->test(linxxxs->size() - 1));
+}
+
+TEST_F(VisibilityTests, validate_positions_checks_own_rows) {
+	auto&	 txmgr = hyrise::tx::TransactionManager::getInstance();
+	auto ctx = txmgr.buildContext();
+	linxxxs->resizeDelta(1);
+	linxxxs->copyRowToDelta(one_row, 0, 0, ctx.tid);
+	ASSERT_EQ(hyrise::tx::TX_CODE::TX_OK, linxxxs->markForDeletion(1, ctx.tid));
+
+	pos_list_t positions(linxxxs->size());
+	std::iota(positions.begin(), positions.end(), 0);
+	linxxxs->validatePositions(positions, ctx.lastCid, ctx.tid);
+	EXPECT_EQ(linxxxs->buildValidPositions(ctx.lastCid, ctx.tid), positions);
+	EXPECT_TRUE(std::find(positions.begin(), positions.end(), linxxxs->size() - 1) != positions.end());
+	EXPECT_TRUE(std::find(positions.begin(), positions.end(), 1u) == positions.end());
+}
+
 TEST_F(VisibilityTests, read_your_own_writes) {
 	auto&	 txmgr = hyrise::tx::TransactionManager::getInstance();
 
@@ -120,7 +195,7 @@ TEST_F (VisibilityTests, read_writes_after_commit) {
 	linxxxs->validatePositions(tmp, lc, tid_a);
 	ASSERT_EQ(linxxxs->size(), tmp.size());
 
-	auto next_cid = txmgr.prepareCommit();
+	auto next_cid = txmgr.prepareCommit(tid_a);
 	ASSERT_EQ(next_cid, txmgr.getLastCommitId() + 1);
 
 	pos_list_t pos_tmp = {linxxxs->size() -1};
@@ -157,7 +232,7 @@ TEST_F (VisibilityTests, read_writes_after_commit_old_cid) {
 	linxxxs->validatePositions(tmp, lc, tid_a);
 	ASSERT_EQ(linxxxs->size(), tmp.size());
 
-	auto next_cid = txmgr.prepareCommit();
+	auto next_cid = txmgr.prepareCommit(tid_a);
 	ASSERT_EQ(next_cid, txmgr.getLastCommitId() + 1);
 	pos_list_t pos_tmp = {linxxxs->size() -1};
 	ASSERT_EQ(hyrise::tx::TX_CODE::TX_OK, linxxxs->commitPositions(pos_tmp, next_cid, true));
@@ -0,0 +1,106 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <utility>
+#include <vector>
+
+#include "io/shortcuts.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/Store.h"
+#include "storage/ZoneMap.h"
+
+namespace hyrise {
+namespace storage {
+
+typedef std::vector<std::pair<size_t, size_t>> ranges_t;
+
+ranges_t candidates(const ZoneMap& zone_map, size_t start, size_t stop, value_id_t low, value_id_t high) {
+  ranges_t result;
+  zone_map.forEachCandidate(start, stop, low, high, [&result] (size_t begin, size_t end) {
+      result.emplace_back(begin, end);
+    });
+  return result;
+}
+
+class ZoneMapTests : public ::hyrise::Test {
+ protected:
+  // Column 0 is clustered (value id = row / 4), column 1 is constant
+  FixedLengthVector<value_id_t> vector {2, 16};
+
+  virtual void SetUp() {
+    vector.resize(16);
+    for (size_t row = 0; row < 16; ++row) {
+      vector.set(0, row, row / 4);
+      vector.set(1, row, 7);
+    }
+  }
+};
+
+TEST_F(ZoneMapTests, summarizes_blocks) {
+  ZoneMap zone_map(vector, 0, 16, 4);
+  ASSERT_EQ(4u, zone_map.blockCount());
+  ASSERT_EQ(16u, zone_map.coveredRows());
+  for (size_t block = 0; block < 4; ++block) {
+    EXPECT_EQ(block, zone_map.minAt(block));
+    EXPECT_EQ(block, zone_map.maxAt(block));
+  }
+
+  ZoneMap partial(vector, 0, 10, 4);
+  ASSERT_EQ(3u, partial.blockCount());
+  EXPECT_EQ(2u, partial.minAt(2));
+  EXPECT_EQ(2u, partial.maxAt(2));
+}
+
+TEST_F(ZoneMapTests, combines_adjacent_candidates) {
+  ZoneMap zone_map(vector, 0, 16, 4);
+  EXPECT_EQ(ranges_t({{4, 12}}), candidates(zone_map, 0, 16, 1, 2));
+  EXPECT_EQ(ranges_t({{5, 10}}), candidates(zone_map, 5, 10, 1, 2));
+  EXPECT_EQ(ranges_t(), candidates(zone_map, 0, 16, 5, 9));
+  EXPECT_EQ(ranges_t({{0, 16}}), candidates(zone_map, 0, 16, 0, 3));
+
+  ZoneMap constant(vector, 1, 16, 4);
+  EXPECT_EQ(ranges_t(), candidates(constant, 0, 16, 0, 6));
+  EXPECT_EQ(ranges_t({{3, 13}}), candidates(constant, 3, 13, 7, 7));
+}
+
+TEST_F(ZoneMapTests, uncovered_rows_are_candidates) {
+  ZoneMap zone_map(vector, 0, 8, 4);
+  EXPECT_EQ(ranges_t({{8, 16}}), candidates(zone_map, 0, 16, 3, 3));
+  EXPECT_EQ(ranges_t({{4, 16}}), candidates(zone_map, 0, 16, 1, 3));
+  EXPECT_EQ(ranges_t({{10, 12}}), candidates(zone_map, 10, 12, 0, 0));
+}
+
+TEST_F(ZoneMapTests, update_widens_block) {
+  ZoneMap zone_map(vector, 0, 16, 4);
+  zone_map.update(1, 3);
+  EXPECT_EQ(0u, zone_map.minAt(0));
+  EXPECT_EQ(3u, zone_map.maxAt(0));
+  EXPECT_EQ(ranges_t({{0, 4}, {12, 16}}), candidates(zone_map, 0, 16, 3, 3));
+}
+
+TEST_F(ZoneMapTests, merged_main_has_zone_maps) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl"));
+  auto main = store->getMainTable();
+  ASSERT_TRUE(main->zoneMapAt(0) != nullptr);
+  ASSERT_EQ(main->size(), main->zoneMapAt(0)->coveredRows());
+  ASSERT_TRUE(store->getDeltaTable()->zoneMapAt(0) == nullptr);
+
+  // Zone maps follow value id updates
+  main->buildZoneMaps(8);
+  main->setValueId(0, 3, ValueId(99, 0));
+  EXPECT_EQ(99u, main->zoneMapAt(0)->maxAt(0));
+}
+
+TEST_F(ZoneMapTests, replacing_dictionary_drops_zone_map) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxs.tbl"));
+  auto main = store->getMainTable();
+  ASSERT_TRUE(main->zoneMapAt(0) != nullptr);
+
+  auto dict = main->dictionaryAt(0);
+  main->setDictionaryAt(dict, 0);
+  EXPECT_TRUE(main->zoneMapAt(0) == nullptr);
+  EXPECT_TRUE(main->zoneMapAt(1) != nullptr);
+  main->setValueId(0, 3, ValueId(1, 0));
+}
+
+} } // namespace hyrise::storage
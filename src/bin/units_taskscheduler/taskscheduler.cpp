@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <ctime>
 #include <sys/time.h>
@@ -14,6 +15,7 @@
 #include "taskscheduler/WSCoreBoundQueuesScheduler.h"
 #include "taskscheduler/ThreadPerTaskScheduler.h"
 #include "taskscheduler/DynamicPriorityScheduler.h"
+#include "taskscheduler/ShardedPriorityScheduler.h"
 
 #include "helper/HwlocHelper.h"
 
@@ -35,7 +37,8 @@ std::vector<std::string> getSchedulersToTest() {
            "CoreBoundPriorityQueuesScheduler",
            "WSCoreBoundPriorityQueuesScheduler",
            "ThreadPerTaskScheduler",
-           "DynamicPriorityScheduler"};
+           "DynamicPriorityScheduler",
+           "ShardedPriorityScheduler"};
 }
 
 class SchedulerTest : public TestWithParam<std::string> {
@@ -179,6 +182,21 @@ TEST_P(SchedulerTest, wait_dependency_task_test) {
   waiter->wait();
 }
 
+TEST_P(SchedulerTest, schedule_after_dependencies_are_done) {
+  SharedScheduler::getInstance().resetScheduler(scheduler_name);
+  const auto& scheduler = SharedScheduler::getInstance().getScheduler();
+
+  // the dependency count of second drops to zero before or while it is
+  // scheduled, it has to run either way
+  auto first = std::make_shared<WaitTask>();
+  auto second = std::make_shared<WaitTask>();
+  second->addDependency(first);
+  scheduler->schedule(first);
+  first->wait();
+  scheduler->schedule(second);
+  second->wait();
+}
+
 TEST_P(SchedulerTest, wait_set_test) {
   //int threads1 = 4;
   int tasks = 100;
@@ -267,5 +285,75 @@ TEST(SchedulerBlockTest, dont_block_test_with_work_stealing) {
   long_block_test(scheduler.get());
 }
 
+TEST(ShardedPrioritySchedulerTest, runs_urgent_tasks_first) {
+  auto scheduler = std::make_shared<ShardedPriorityScheduler>(1);
+  scheduler->init();
+
+  // block the only worker until all tasks are queued
+  std::atomic<bool> blocked(true);
+  auto blocker = std::make_shared<FunctionTask>([&blocked] () { while (blocked) std::this_thread::yield(); });
+  scheduler->schedule(blocker);
+
+  std::vector<int> order;
+  auto waiter = std::make_shared<WaitTask>();
+  waiter->setPriority(Task::DEFAULT_PRIORITY + 1);
+  for (int priority : {5, 3, 4, 1, 2}) {
+    auto task = std::make_shared<FunctionTask>([&order, priority] () { order.push_back(priority); });
+    task->setPriority(priority);
+    waiter->addDependency(task);
+    scheduler->schedule(task);
+  }
+  scheduler->schedule(waiter);
+  blocked = false;
+  waiter->wait();
+
+  EXPECT_EQ((std::vector<int> {1, 2, 3, 4, 5}), order);
+}
+
+namespace {
+  // records the idle workers a scheduler reports to a dynamic task
+  class IdleWorkersProbe : public FunctionTask {
+  public:
+    std::atomic<size_t> idleWorkers;
+
+    IdleWorkersProbe() : FunctionTask([] () {}), idleWorkers(0) {
+      setDynamic(true);
+    }
+
+    size_t determineDynamicCount(size_t maxTaskRunTime, size_t idleWorkers) {
+      this->idleWorkers = idleWorkers;
+      return 1;
+    }
+
+    std::vector<task_ptr_t> applyDynamicParallelization(size_t dynamicCount) {
+      return { shared_from_this() };
+    }
+  };
+}
+
+TEST(DynamicPrioritySchedulerTest, busy_workers_are_not_idle) {
+  auto scheduler = std::make_shared<DynamicPriorityScheduler>(2);
+  scheduler->init();
+
+  // keep one of the two workers busy
+  std::atomic<bool> running(false), blocked(true);
+  auto blocker = std::make_shared<FunctionTask>([&running, &blocked] () {
+      running = true;
+      while (blocked) std::this_thread::yield();
+    });
+  scheduler->schedule(blocker);
+  while (!running) std::this_thread::yield();
+
+  auto probe = std::make_shared<IdleWorkersProbe>();
+  auto waiter = std::make_shared<WaitTask>();
+  waiter->addDependency(probe);
+  scheduler->schedule(probe);
+  scheduler->schedule(waiter);
+  blocked = false;
+  waiter->wait();
+
+  EXPECT_EQ(1u, probe->idleWorkers);
+}
+
 } } // namespace hyrise::taskscheduler
 
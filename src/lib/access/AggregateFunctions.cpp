@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "AggregateFunctions.h"
 #include <storage/meta_storage.h>
+#include <type_traits>
 #include "json.h"
 
 namespace hyrise { namespace storage {
@@ -165,6 +166,189 @@ struct max_aggregate_functor : aggregate_functor{
   }
 };
 
+/// Running value of an aggregate state for input type R, integers are
+/// summed as hyrise_int_t and floats as double
+template <typename R, bool Real = std::is_floating_point<R>::value>
+struct state_value {
+  static hyrise_int_t &of(access::aggregate_state_t &state) {
+    return state.integer;
+  }
+  static hyrise_int_t of(const access::aggregate_state_t &state) {
+    return state.integer;
+  }
+};
+
+template <typename R>
+struct state_value<R, true> {
+  static double &of(access::aggregate_state_t &state) {
+    return state.real;
+  }
+  static double of(const access::aggregate_state_t &state) {
+    return state.real;
+  }
+};
+
+/// Current value of a MIN or MAX state, strings are not fixed-width and
+/// are read from the row the state refers to
+template <typename R>
+struct extreme_value {
+  static R get(const c_atable_ptr_t &, field_t, const access::aggregate_state_t &state) {
+    return static_cast<R>(state_value<R>::of(state));
+  }
+  static void set(access::aggregate_state_t &state, const R &value, pos_t) {
+    state_value<R>::of(state) = value;
+  }
+};
+
+template <>
+struct extreme_value<std::string> {
+  static std::string get(const c_atable_ptr_t &input, field_t field, const access::aggregate_state_t &state) {
+    return input->getValue<std::string>(field, state.row);
+  }
+  static void set(access::aggregate_state_t &state, const std::string &, pos_t row) {
+    state.row = row;
+  }
+};
+
+template <bool Max, typename R>
+inline bool replaces(const R &value, const R &current) {
+  return Max ? current < value : value < current;
+}
+
+struct state_functor {
+  typedef void value_type;
+
+  const c_atable_ptr_t& input;
+  field_t sourceField;
+
+  state_functor(const c_atable_ptr_t& i, field_t sourceF) : input(i), sourceField(sourceF) {}
+};
+
+struct sum_state_functor : state_functor {
+  const pos_t *rows;
+  access::aggregate_state_t *const *states;
+  size_t count, offset;
+
+  sum_state_functor(const c_atable_ptr_t& i,
+                    field_t sourceF,
+                    const pos_t *forRows,
+                    access::aggregate_state_t *const *toStates,
+                    size_t rowCount,
+                    size_t stateOffset): state_functor(i, sourceF), rows(forRows), states(toStates), count(rowCount), offset(stateOffset) {}
+
+  template <typename R>
+  value_type operator()() {
+    for (size_t i = 0; i < count; ++i) {
+      auto &state = states[i][offset];
+      state_value<R>::of(state) += input->getValue<R>(sourceField, rows[i]);
+      ++state.count;
+    }
+  }
+};
+
+template<>
+void sum_state_functor::operator()<std::string>() {
+  throw std::runtime_error("Cannot calculate sum for column of StringType");
+}
+
+struct sum_combine_functor : state_functor {
+  access::aggregate_state_t &state;
+  const access::aggregate_state_t &other;
+
+  sum_combine_functor(const c_atable_ptr_t& i,
+                      field_t sourceF,
+                      access::aggregate_state_t &into,
+                      const access::aggregate_state_t &from): state_functor(i, sourceF), state(into), other(from) {}
+
+  template <typename R>
+  value_type operator()() {
+    state_value<R>::of(state) += state_value<R>::of(other);
+    state.count += other.count;
+  }
+};
+
+template <bool Max>
+struct extreme_state_functor : state_functor {
+  const pos_t *rows;
+  access::aggregate_state_t *const *states;
+  size_t count, offset;
+
+  extreme_state_functor(const c_atable_ptr_t& i,
+                        field_t sourceF,
+                        const pos_t *forRows,
+                        access::aggregate_state_t *const *toStates,
+                        size_t rowCount,
+                        size_t stateOffset): state_functor(i, sourceF), rows(forRows), states(toStates), count(rowCount), offset(stateOffset) {}
+
+  template <typename R>
+  value_type operator()() {
+    for (size_t i = 0; i < count; ++i) {
+      auto &state = states[i][offset];
+      const R value = input->getValue<R>(sourceField, rows[i]);
+      if (state.count == 0 || replaces<Max>(value, extreme_value<R>::get(input, sourceField, state)))
+        extreme_value<R>::set(state, value, rows[i]);
+      ++state.count;
+    }
+  }
+};
+
+template <bool Max>
+struct extreme_combine_functor : state_functor {
+  access::aggregate_state_t &state;
+  const access::aggregate_state_t &other;
+
+  extreme_combine_functor(const c_atable_ptr_t& i,
+                          field_t sourceF,
+                          access::aggregate_state_t &into,
+                          const access::aggregate_state_t &from): state_functor(i, sourceF), state(into), other(from) {}
+
+  template <typename R>
+  value_type operator()() {
+    const uint64_t count = state.count + other.count;
+    if (state.count == 0 || replaces<Max>(extreme_value<R>::get(input, sourceField, other),
+                                          extreme_value<R>::get(input, sourceField, state)))
+      state = other;
+    state.count = count;
+  }
+};
+
+struct write_state_functor : state_functor {
+  const access::aggregate_state_t &state;
+  atable_ptr_t& target;
+  std::string targetColumn;
+  size_t targetRow;
+  bool average, extreme;
+
+  write_state_functor(const c_atable_ptr_t& i,
+                      field_t sourceF,
+                      const access::aggregate_state_t &from,
+                      atable_ptr_t& t,
+                      std::string column,
+                      size_t toRow,
+                      bool isAverage,
+                      bool isExtreme): state_functor(i, sourceF), state(from), target(t), targetColumn(column),
+                                       targetRow(toRow), average(isAverage), extreme(isExtreme) {}
+
+  template <typename R>
+  value_type operator()() {
+    const auto column = target->numberOfColumn(targetColumn);
+    if (average)
+      target->setValue<float>(column, targetRow, (float) state_value<R>::of(state) / state.count);
+    else if (extreme)
+      target->setValue<R>(column, targetRow, extreme_value<R>::get(input, sourceField, state));
+    else
+      target->setValue<R>(column, targetRow, static_cast<R>(state_value<R>::of(state)));
+  }
+};
+
+template<>
+void write_state_functor::operator()<std::string>() {
+  if (!extreme)
+    throw std::runtime_error("Cannot write sum or average for column of StringType");
+  target->setValue<std::string>(target->numberOfColumn(targetColumn), targetRow,
+                                extreme_value<std::string>::get(input, sourceField, state));
+}
+
 } // namespace storage
 
 namespace access {
@@ -231,6 +415,29 @@ void SumAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos
   ts(_dataType, fun);
 }
 
+void SumAggregateFun::accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+                                 aggregate_state_t *const *states, size_t count, size_t offset) {
+  storage::sum_state_functor fun(t, _field, rows, states, count, offset);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void SumAggregateFun::combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+                              const aggregate_state_t& other) {
+  if (other.count == 0)
+    return;
+  storage::sum_combine_functor fun(t, _field, state, other);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void SumAggregateFun::writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+                                 storage::atable_ptr_t& target, size_t targetRow) {
+  storage::write_state_functor fun(t, _field, state, target, columnName(), targetRow, false, false);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *SumAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new SumAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new SumAggregateFun(f["field"].asString());
@@ -306,6 +513,22 @@ size_t CountAggregateFun::countRowsDistinct(const storage::c_atable_ptr_t& t, po
   return distinctRows.size();
 }
 
+void CountAggregateFun::accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+                                   aggregate_state_t *const *states, size_t count, size_t offset) {
+  for (size_t i = 0; i < count; ++i)
+    ++states[i][offset].count;
+}
+
+void CountAggregateFun::combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+                                const aggregate_state_t& other) {
+  state.count += other.count;
+}
+
+void CountAggregateFun::writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+                                   storage::atable_ptr_t& target, size_t targetRow) {
+  target->setValue<hyrise_int_t>(target->numberOfColumn(columnName()), targetRow, state.count);
+}
+
 AggregateFun *CountAggregateFun::parse(const Json::Value &f) {
   CountAggregateFun* aggregate;
   
@@ -327,6 +550,29 @@ void AverageAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t,
     ts(_dataType, fun);
 }
 
+void AverageAggregateFun::accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+                                     aggregate_state_t *const *states, size_t count, size_t offset) {
+  storage::sum_state_functor fun(t, _field, rows, states, count, offset);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void AverageAggregateFun::combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+                                  const aggregate_state_t& other) {
+  if (other.count == 0)
+    return;
+  storage::sum_combine_functor fun(t, _field, state, other);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void AverageAggregateFun::writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+                                     storage::atable_ptr_t& target, size_t targetRow) {
+  storage::write_state_functor fun(t, _field, state, target, columnName(), targetRow, true, false);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *AverageAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new AverageAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new AverageAggregateFun(f["field"].asString());
@@ -341,6 +587,29 @@ void MinAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos
     ts(_dataType, fun);
 }
 
+void MinAggregateFun::accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+                                 aggregate_state_t *const *states, size_t count, size_t offset) {
+  storage::extreme_state_functor<false> fun(t, _field, rows, states, count, offset);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void MinAggregateFun::combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+                              const aggregate_state_t& other) {
+  if (other.count == 0)
+    return;
+  storage::extreme_combine_functor<false> fun(t, _field, state, other);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void MinAggregateFun::writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+                                 storage::atable_ptr_t& target, size_t targetRow) {
+  storage::write_state_functor fun(t, _field, state, target, columnName(), targetRow, false, true);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *MinAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new MinAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new MinAggregateFun(f["field"].asString());
@@ -355,6 +624,29 @@ void MaxAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos
     ts(_dataType, fun);
 }
 
+void MaxAggregateFun::accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+                                 aggregate_state_t *const *states, size_t count, size_t offset) {
+  storage::extreme_state_functor<true> fun(t, _field, rows, states, count, offset);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void MaxAggregateFun::combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+                              const aggregate_state_t& other) {
+  if (other.count == 0)
+    return;
+  storage::extreme_combine_functor<true> fun(t, _field, state, other);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
+void MaxAggregateFun::writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+                                 storage::atable_ptr_t& target, size_t targetRow) {
+  storage::write_state_functor fun(t, _field, state, target, columnName(), targetRow, false, true);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *MaxAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new MaxAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new MaxAggregateFun(f["field"].asString());
@@ -30,6 +30,20 @@ class AggregateFun;
 
 AggregateFun *parseAggregateFunction(const Json::Value &value);
 
+/// Fixed-width partial result of one aggregate function for one group as
+/// kept by the streaming GroupByScan. count is the number of rows seen,
+/// the running value is kept in the member matching the input type;
+/// MIN and MAX on strings keep the row of the current value instead.
+/// A zeroed state is an empty group.
+struct aggregate_state_t {
+  union {
+    hyrise_int_t integer;
+    double real;
+    pos_t row;
+  };
+  uint64_t count;
+};
+
 /*
   This is the base function for all aggregate functions. It defers the
   type handling down to the process Method and only returns
@@ -53,6 +67,21 @@ class AggregateFun {
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, 
     pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) = 0;
   virtual DataType getType() const = 0;
+
+  /// Whether the function can be computed from an aggregate_state_t
+  virtual bool isStreamable() const {
+    return true;
+  }
+  /// Adds the value of t at rows[i] to states[i][offset] for every i
+  /// below count
+  virtual void accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+    aggregate_state_t *const *states, size_t count, size_t offset) = 0;
+  /// Adds the partial state other of the same group to state
+  virtual void combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+    const aggregate_state_t& other) = 0;
+  virtual void writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+    storage::atable_ptr_t& target, size_t targetRow) = 0;
+
   std::string columnName() const
   {
     return _new_field_name;
@@ -85,6 +114,12 @@ class SumAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow);
+  virtual void accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+    aggregate_state_t *const *states, size_t count, size_t offset);
+  virtual void combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+    const aggregate_state_t& other);
+  virtual void writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+    storage::atable_ptr_t& target, size_t targetRow);
 
   virtual DataType getType() const {
     return _dataType;
@@ -121,9 +156,20 @@ class CountAggregateFun: public AggregateFun {
    * are considered for counting.
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow);
+  virtual void accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+    aggregate_state_t *const *states, size_t count, size_t offset);
+  virtual void combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+    const aggregate_state_t& other);
+  virtual void writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+    storage::atable_ptr_t& target, size_t targetRow);
+
   size_t countRows(const storage::c_atable_ptr_t& t, pos_list_t *rows);
   size_t countRowsDistinct(const storage::c_atable_ptr_t& t, pos_list_t *rows);
 
+  virtual bool isStreamable() const {
+    return !_distinct;
+  }
+
   void setDistinct(bool distinct) {
     _distinct = distinct;
   }
@@ -160,6 +206,12 @@ class AverageAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) ;
+  virtual void accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+    aggregate_state_t *const *states, size_t count, size_t offset);
+  virtual void combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+    const aggregate_state_t& other);
+  virtual void writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+    storage::atable_ptr_t& target, size_t targetRow);
 
   virtual DataType getType() const {
     return FloatType;
@@ -196,6 +248,12 @@ class MinAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) ;
+  virtual void accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+    aggregate_state_t *const *states, size_t count, size_t offset);
+  virtual void combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+    const aggregate_state_t& other);
+  virtual void writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+    storage::atable_ptr_t& target, size_t targetRow);
 
   virtual DataType getType() const {
     return _dataType;
@@ -229,6 +287,12 @@ class MaxAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) ;
+  virtual void accumulate(const storage::c_atable_ptr_t& t, const pos_t *rows,
+    aggregate_state_t *const *states, size_t count, size_t offset);
+  virtual void combine(const storage::c_atable_ptr_t& t, aggregate_state_t& state,
+    const aggregate_state_t& other);
+  virtual void writeState(const storage::c_atable_ptr_t& t, const aggregate_state_t& state,
+    storage::atable_ptr_t& target, size_t targetRow);
 
   virtual DataType getType() const {
     return _dataType;
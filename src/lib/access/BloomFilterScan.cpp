@@ -0,0 +1,83 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/BloomFilterScan.h"
+
+#include <algorithm>
+
+#include "access/system/BasicParser.h"
+#include "access/system/OperationData-Impl.h"
+#include "access/system/QueryParser.h"
+
+#include "storage/BloomFilter.h"
+#include "storage/PointerCalculator.h"
+#include "taskscheduler/ParallelFor.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerPlanOperation<BloomFilterScan>("BloomFilterScan");
+}
+
+BloomFilterScan::~BloomFilterScan() {
+}
+
+void BloomFilterScan::executePlanOperation() {
+  const auto& table = getInputTable();
+  const auto filters = input.allOf<storage::BloomFilter>();
+  if (filters.empty()) {
+    throw std::runtime_error("BloomFilterScan needs a Bloom filter input, set \"bloomFilter\" on the HashBuild");
+  }
+
+  // Rows of a parallel build are split over several filters
+  auto filterRange = [&] (pos_t start, pos_t stop, pos_list_t& positions) {
+    if (filters.size() == 1) {
+      filters.front()->filter(table, _field_definition, start, stop, positions);
+      return;
+    }
+    for (pos_t row = start; row < stop; ++row) {
+      const auto hash = storage::BloomFilter::hashRow(table, _field_definition, row);
+      if (std::any_of(filters.begin(), filters.end(), [hash] (const storage::c_bloom_filter_ptr_t& filter) {
+            return filter->mayContain(hash);
+          })) {
+        positions.push_back(row);
+      }
+    }
+  };
+
+  auto positions = new pos_list_t;
+  const size_t rows = table->size();
+  if (_morselSize == 0 || rows <= _morselSize) {
+    filterRange(0, rows, *positions);
+  } else {
+    const size_t morselCount = (rows + _morselSize - 1) / _morselSize;
+    std::vector<pos_list_t> results(morselCount);
+    taskscheduler::parallelFor(morselCount, [&] (size_t morsel) {
+        const size_t begin = morsel * _morselSize;
+        filterRange(begin, std::min(rows, begin + _morselSize), results[morsel]);
+      }, 0, _priority);
+    for (const auto& result : results) {
+      positions->insert(positions->end(), result.begin(), result.end());
+    }
+  }
+
+  addResult(storage::PointerCalculator::create(table, positions));
+}
+
+std::shared_ptr<PlanOperation> BloomFilterScan::parse(const Json::Value &data) {
+  std::shared_ptr<BloomFilterScan> instance = BasicParser<BloomFilterScan>::parse(data);
+  if (data.isMember("morselSize")) {
+    instance->setMorselSize(data["morselSize"].asUInt());
+  }
+  return instance;
+}
+
+const std::string BloomFilterScan::vname() {
+  return "BloomFilterScan";
+}
+
+void BloomFilterScan::setMorselSize(size_t morselSize) {
+  _morselSize = morselSize;
+}
+
+}
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_BLOOMFILTERSCAN_H_
+#define SRC_LIB_ACCESS_BLOOMFILTERSCAN_H_
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Semi join filter for the probe side of a hash join: drops all rows of
+/// the input table whose key columns are not in any of the input Bloom
+/// filters, the other rows are returned as positions. The filters are
+/// emitted by a HashBuild with "bloomFilter" set, so the scan is wired
+/// in by an edge from the HashBuild:
+/// {
+///     "operators": {
+///         "0": { "type": "TableLoad", "table": "dimension", "filename": "..." },
+///         "1": { "type": "TableLoad", "table": "fact", "filename": "..." },
+///         "2": { "type": "HashBuild", "fields" : [1], "key": "join", "bloomFilter": true },
+///         "3": { "type": "BloomFilterScan", "fields" : [0] },
+///         "4": { "type": "HashJoinProbe", "fields" : [0] }
+///     },
+///     "edges": [["0", "2"], ["1", "3"], ["2", "3"], ["2", "4"], ["3", "4"]]
+/// }
+class BloomFilterScan : public PlanOperation {
+public:
+  virtual ~BloomFilterScan();
+
+  void executePlanOperation();
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
+  const std::string vname();
+  /// Filters in morsels of morselSize rows that helper tasks pull from a
+  /// shared cursor, 0 filters in the calling task
+  void setMorselSize(size_t morselSize);
+
+private:
+  size_t _morselSize = 0;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_BLOOMFILTERSCAN_H_
@@ -1,14 +1,21 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/GroupByScan.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
 #include "access/system/QueryParser.h"
 #include "storage/ColumnMetadata.h"
 #include "storage/DictionaryFactory.h"
+#include "storage/FlatHashTable.h"
 #include "storage/HashTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/OrderIndifferentDictionary.h"
 #include "storage/meta_storage.h"
 #include "storage/storage_types.h"
+#include "taskscheduler/ParallelFor.h"
 
 namespace hyrise {
 namespace storage {
@@ -55,6 +62,103 @@ namespace access {
 
 namespace {
   auto _ = QueryParser::registerPlanOperation<GroupByScan>("GroupByScan");
+
+  // Rows are grouped batch-wise before the aggregate functions run over
+  // the whole batch
+  const size_t batch_rows = 1024;
+  const size_t min_task_rows = 64 * 1024;
+  const size_t partition_bits = 4;
+  const size_t npos = std::numeric_limits<size_t>::max();
+  // Groups of the dense array merged by one task
+  const size_t merge_groups = 4096;
+
+  // compare FlatHashTable::hashOf
+  uint64_t hashOf(const uint64_t *key, size_t width) {
+    size_t seed = 0;
+    for (size_t i = 0; i < width; ++i)
+      seed ^= static_cast<size_t>(key[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return static_cast<uint64_t>(seed) * 0x9e3779b97f4a7c15ull;
+  }
+
+  // Open addressing table from the value ids of the group columns to the
+  // aggregate states of a group. A group keeps its first row to write the
+  // group columns from.
+  class aggregate_table_t {
+   public:
+    aggregate_table_t(size_t width, size_t functions) : _width(width), _functions(functions) {
+      resizeSlots(16);
+    }
+
+    size_t size() const {
+      return _rows.size();
+    }
+
+    const uint64_t *key(size_t group) const {
+      return &_keys[group * _width];
+    }
+
+    uint64_t hash(size_t group) const {
+      return _hashes[group];
+    }
+
+    pos_t row(size_t group) const {
+      return _rows[group];
+    }
+
+    aggregate_state_t *states(size_t group) {
+      return &_states[group * _functions];
+    }
+
+    const aggregate_state_t *states(size_t group) const {
+      return &_states[group * _functions];
+    }
+
+    // Returns the group of key, adding an empty group first seen in row
+    // if the key is unknown
+    size_t insert(const uint64_t *key, uint64_t hash, pos_t row) {
+      const size_t mask = _slots.size() - 1;
+      size_t slot = static_cast<size_t>(hash >> _shift);
+      while (_slots[slot] != npos) {
+        const size_t group = _slots[slot];
+        if (_hashes[group] == hash && std::equal(key, key + _width, &_keys[group * _width]))
+          return group;
+        slot = (slot + 1) & mask;
+      }
+      const size_t group = _rows.size();
+      _slots[slot] = group;
+      _keys.insert(_keys.end(), key, key + _width);
+      _hashes.push_back(hash);
+      _rows.push_back(row);
+      _states.resize(_states.size() + _functions, aggregate_state_t());
+      if (2 * _rows.size() > _slots.size())
+        resizeSlots(2 * _slots.size());
+      return group;
+    }
+
+   private:
+    void resizeSlots(size_t count) {
+      size_t bits = 4;
+      while ((size_t(1) << bits) < count)
+        ++bits;
+      _shift = 64 - bits;
+      _slots.assign(size_t(1) << bits, npos);
+      const size_t mask = _slots.size() - 1;
+      for (size_t group = 0; group < _rows.size(); ++group) {
+        size_t slot = static_cast<size_t>(_hashes[group] >> _shift);
+        while (_slots[slot] != npos)
+          slot = (slot + 1) & mask;
+        _slots[slot] = group;
+      }
+    }
+
+    size_t _width, _functions;
+    std::vector<size_t> _slots;
+    size_t _shift;
+    std::vector<uint64_t> _keys;
+    std::vector<uint64_t> _hashes;
+    pos_list_t _rows;
+    std::vector<aggregate_state_t> _states;
+  };
 }
 
 GroupByScan::~GroupByScan() {
@@ -72,7 +176,15 @@ void GroupByScan::setupPlanOperation() {
 }
 
 void GroupByScan::executePlanOperation() {
+  if (isStreaming()) {
+    if (!executeDenseGroupBy())
+      executeStreamingGroupBy();
+    return;
+  }
   if ((_field_definition.size() != 0) && (input.numberOfHashTables() >= 1)) {
+    if (std::dynamic_pointer_cast<const storage::AbstractFlatHashTable>(getInputHashTable())) {
+      return executeFlatGroupBy();
+    }
     if (_globalAggregation) {
       if (_field_definition.size() == 1) {
         return executeGroupBy<storage::SingleJoinHashTable, storage::join_single_hash_map_t, storage::join_single_key_t>();
@@ -119,6 +231,9 @@ std::shared_ptr<PlanOperation> GroupByScan::parse(const Json::Value &v) {
   if (v.isMember("key") && v["key"].asString().compare("value") == 0) {
     gs->_globalAggregation = true;
   }
+  gs->setStreaming(v.get("streaming", false).asBool());
+  if (v.isMember("denseThreshold"))
+    gs->setDenseThreshold(v["denseThreshold"].asUInt());
   return gs;
 }
 
@@ -155,9 +270,31 @@ void GroupByScan::addFunction(AggregateFun *fun) {
   this->_aggregate_functions.push_back(fun);
 }
 
+void GroupByScan::setStreaming(bool streaming) {
+  _streaming = streaming;
+}
+
+void GroupByScan::setDenseThreshold(size_t groups) {
+  _denseThreshold = groups;
+}
+
+bool GroupByScan::isStreaming() const {
+  // streaming groups on value ids, aggregation by value needs the hash
+  // table input
+  if (!_streaming || _globalAggregation || (_indexed_field_definition.size() + _named_field_definition.size()) == 0)
+    return false;
+  return std::all_of(_aggregate_functions.begin(), _aggregate_functions.end(),
+                     [] (const AggregateFun *fun) { return fun->isStreamable(); });
+}
+
 void GroupByScan::splitInput() {
   hash_table_list_t hashTables = input.getHashTables();
-  if (_count > 0 && !hashTables.empty()) {
+  if (isStreaming()) {
+    // every instance reads all rows and keeps the groups of its own
+    // partitions, see executeStreamingGroupBy
+  } else if (_count > 0 && !hashTables.empty() && std::dynamic_pointer_cast<const storage::AbstractFlatHashTable>(hashTables[0])) {
+    // groups of flat hash tables are distributed in executeFlatGroupBy
+  } else if (_count > 0 && !hashTables.empty()) {
     auto r = distribute(hashTables[0]->numKeys(), _part, _count);
 
     if ((_indexed_field_definition.size() + _named_field_definition.size()) == 1)
@@ -169,14 +306,20 @@ void GroupByScan::splitInput() {
   }
 }
 
-void GroupByScan::writeGroupResult(storage::atable_ptr_t &resultTab,
-                                   const std::shared_ptr<storage::pos_list_t> &hit,
-                                   const size_t row) {
+void GroupByScan::writeGroupColumns(storage::atable_ptr_t &resultTab,
+                                    const pos_t sourceRow,
+                                    const size_t row) {
   for (const auto & columnNr: _field_definition) {
-    storage::write_group_functor fun(getInputTable(0), resultTab, hit->at(0), (size_t)columnNr, row);
+    storage::write_group_functor fun(getInputTable(0), resultTab, sourceRow, (size_t)columnNr, row);
     storage::type_switch<hyrise_basic_types> ts;
     ts(getInputTable(0)->typeOfColumn(columnNr), fun);
   }
+}
+
+void GroupByScan::writeGroupResult(storage::atable_ptr_t &resultTab,
+                                   const std::shared_ptr<storage::pos_list_t> &hit,
+                                   const size_t row) {
+  writeGroupColumns(resultTab, hit->at(0), row);
 
   for (const auto & funct: _aggregate_functions) {
     funct->processValuesForRows(getInputTable(0), hit.get(), resultTab, row);
@@ -218,5 +361,217 @@ void GroupByScan::executeGroupBy() {
   this->addResult(resultTab);
 }
 
+void GroupByScan::executeFlatGroupBy() {
+  auto resultTab = createResultTableLayout();
+
+  const auto& hashTable = std::dynamic_pointer_cast<const storage::AbstractFlatHashTable>(getInputHashTable());
+  std::pair<uint64_t, uint64_t> groups(0, hashTable->numKeys());
+  if (_count > 0)
+    groups = distribute(hashTable->numKeys(), _part, _count);
+  resultTab->resize(groups.second - groups.first);
+
+  pos_t row = 0;
+  for (size_t group = groups.first; group < groups.second; ++group) {
+    auto pos_list = std::make_shared<pos_list_t>(hashTable->groupBegin(group), hashTable->groupEnd(group));
+    writeGroupResult(resultTab, pos_list, row);
+    row++;
+  }
+
+  this->addResult(resultTab);
+}
+void GroupByScan::executeStreamingGroupBy() {
+  const auto &table = getInputTable(0);
+  const size_t rows = table->size();
+  const size_t width = _field_definition.size();
+  const size_t functions = _aggregate_functions.size();
+
+  // Instances of a parallelized GroupByScan keep the groups of every
+  // _count-th partition
+  size_t partitions = size_t(1) << partition_bits;
+  while (partitions < _count)
+    partitions *= 2;
+  const size_t mask = partitions - 1;
+  const size_t count = _count, part = _part;
+  auto owned = [count, part] (size_t partition) { return count == 0 || partition % count == part; };
+
+  // Every task aggregates a range of rows into its own partitioned table
+  const size_t tasks = std::max<size_t>(1, std::min<size_t>(rows / min_task_rows, std::thread::hardware_concurrency()));
+  std::vector<std::vector<aggregate_table_t> > partials(tasks, std::vector<aggregate_table_t>(partitions, aggregate_table_t(width, functions)));
+  taskscheduler::parallelFor(tasks, [&] (size_t task) {
+      auto &tables = partials[task];
+      std::vector<uint64_t> keys(width);
+      std::vector<size_t> partitionOf(batch_rows), groups(batch_rows);
+      std::vector<aggregate_state_t *> states(batch_rows);
+      pos_list_t batch;
+      batch.reserve(batch_rows);
+      const pos_t end = rows * (task + 1) / tasks;
+      for (pos_t first = rows * task / tasks; first < end; first += batch_rows) {
+        batch.clear();
+        for (pos_t row = first, last = std::min<pos_t>(end, first + batch_rows); row < last; ++row) {
+          for (size_t i = 0; i < width; ++i) {
+            const auto valueId = table->getValueId(_field_definition[i], row);
+            keys[i] = (static_cast<uint64_t>(valueId.table) << 32) | valueId.valueId;
+          }
+          const uint64_t hash = hashOf(keys.data(), width);
+          const size_t partition = hash & mask;
+          if (!owned(partition))
+            continue;
+          partitionOf[batch.size()] = partition;
+          groups[batch.size()] = tables[partition].insert(keys.data(), hash, row);
+          batch.push_back(row);
+        }
+        // states move while groups are added, they are resolved once the
+        // batch is grouped
+        for (size_t i = 0; i < batch.size(); ++i)
+          states[i] = tables[partitionOf[i]].states(groups[i]);
+        for (size_t f = 0; f < functions; ++f)
+          _aggregate_functions[f]->accumulate(table, batch.data(), states.data(), batch.size(), f);
+      }
+    }, 0, _priority);
+
+  // The partial tables of a partition are combined into the first one
+  std::vector<size_t> offsets(partitions + 1, 0);
+  taskscheduler::parallelFor(partitions, [&] (size_t partition) {
+      if (!owned(partition))
+        return;
+      auto &merged = partials[0][partition];
+      for (size_t task = 1; task < tasks; ++task) {
+        const auto &partial = partials[task][partition];
+        for (size_t group = 0; group < partial.size(); ++group) {
+          const size_t target = merged.insert(partial.key(group), partial.hash(group), partial.row(group));
+          for (size_t f = 0; f < functions; ++f)
+            _aggregate_functions[f]->combine(table, merged.states(target)[f], partial.states(group)[f]);
+        }
+      }
+      offsets[partition + 1] = merged.size();
+    }, 0, _priority);
+  for (size_t partition = 0; partition < partitions; ++partition)
+    offsets[partition + 1] += offsets[partition];
+
+  auto resultTab = createResultTableLayout();
+  resultTab->resize(offsets[partitions]);
+  for (size_t partition = 0; partition < partitions; ++partition) {
+    const auto &merged = partials[0][partition];
+    for (size_t group = 0; group < merged.size(); ++group) {
+      const size_t row = offsets[partition] + group;
+      writeGroupColumns(resultTab, merged.row(group), row);
+      for (size_t f = 0; f < functions; ++f)
+        _aggregate_functions[f]->writeState(table, merged.states(group)[f], resultTab, row);
+    }
+  }
+
+  this->addResult(resultTab);
+}
+bool GroupByScan::executeDenseGroupBy() {
+  const auto &table = getInputTable(0);
+  const size_t rows = table->size();
+  const size_t width = _field_definition.size();
+  const size_t functions = _aggregate_functions.size();
+
+  // A group is numbered by the value ids of its columns with the last
+  // column varying fastest, the domain of a column is its main dictionary
+  std::vector<size_t> domains(width);
+  size_t domain = 1;
+  for (size_t i = 0; i < width; ++i) {
+    const auto type = table->typeOfColumn(_field_definition[i]);
+    if (type == IntegerNoDictType || type == FloatNoDictType)
+      return false;
+    const auto &dictionary = table->dictionaryByTableId(_field_definition[i], 0);
+    if (!dictionary)
+      return false;
+    domains[i] = std::max<size_t>(1, dictionary->size());
+    if (domains[i] > _denseThreshold / domain)
+      return false;
+    domain *= domains[i];
+    // rows of a delta are appended last
+    if (rows > 0 && table->getValueId(_field_definition[i], rows - 1).table != 0)
+      return false;
+  }
+
+  // Instances of a parallelized GroupByScan keep a range of the groups
+  std::pair<uint64_t, uint64_t> owned(0, domain);
+  if (_count > 0)
+    owned = distribute(domain, _part, _count);
+  const size_t groups = owned.second - owned.first;
+
+  const size_t tasks = std::max<size_t>(1, std::min<size_t>(rows / min_task_rows, std::thread::hardware_concurrency()));
+  std::vector<std::vector<aggregate_state_t> > states(tasks);
+  std::vector<pos_list_t> firstRows(tasks);
+  std::atomic<bool> fits(true);
+  taskscheduler::parallelFor(tasks, [&] (size_t task) {
+      auto &taskStates = states[task];
+      auto &taskRows = firstRows[task];
+      taskStates.assign(groups * functions, aggregate_state_t());
+      taskRows.assign(groups, std::numeric_limits<pos_t>::max());
+      std::vector<size_t> codes(batch_rows);
+      std::vector<aggregate_state_t *> batchStates(batch_rows);
+      pos_list_t batch;
+      batch.reserve(batch_rows);
+      const pos_t end = rows * (task + 1) / tasks;
+      for (pos_t first = rows * task / tasks; first < end && fits; first += batch_rows) {
+        const size_t count = std::min<size_t>(end - first, batch_rows);
+        std::fill(codes.begin(), codes.begin() + count, 0);
+        for (size_t i = 0; i < width; ++i) {
+          const field_t field = _field_definition[i];
+          const size_t size = domains[i];
+          for (size_t j = 0; j < count; ++j) {
+            const auto valueId = table->getValueId(field, first + j);
+            if (valueId.table != 0) {
+              fits = false;
+              return;
+            }
+            codes[j] = codes[j] * size + valueId.valueId;
+          }
+        }
+
+        batch.clear();
+        for (size_t j = 0; j < count; ++j) {
+          if (codes[j] < owned.first || codes[j] >= owned.second)
+            continue;
+          const size_t group = codes[j] - owned.first;
+          taskRows[group] = std::min<pos_t>(taskRows[group], first + j);
+          batchStates[batch.size()] = taskStates.data() + group * functions;
+          batch.push_back(first + j);
+        }
+        for (size_t f = 0; f < functions; ++f)
+          _aggregate_functions[f]->accumulate(table, batch.data(), batchStates.data(), batch.size(), f);
+      }
+    }, 0, _priority);
+  if (!fits)
+    return false;
+
+  // The arrays of all tasks are combined into the first one
+  auto &merged = states[0];
+  auto &mergedRows = firstRows[0];
+  taskscheduler::parallelFor((groups + merge_groups - 1) / merge_groups, [&] (size_t range) {
+      for (size_t group = range * merge_groups, end = std::min(groups, group + merge_groups); group < end; ++group) {
+        for (size_t task = 1; task < tasks; ++task) {
+          // skip the states of tasks that did not see the group
+          if (firstRows[task][group] == std::numeric_limits<pos_t>::max())
+            continue;
+          mergedRows[group] = std::min(mergedRows[group], firstRows[task][group]);
+          for (size_t f = 0; f < functions; ++f)
+            _aggregate_functions[f]->combine(table, merged[group * functions + f], states[task][group * functions + f]);
+        }
+      }
+    }, 0, _priority);
+
+  auto resultTab = createResultTableLayout();
+  resultTab->resize(std::count_if(mergedRows.begin(), mergedRows.end(),
+                                  [] (pos_t row) { return row != std::numeric_limits<pos_t>::max(); }));
+  pos_t row = 0;
+  for (size_t group = 0; group < groups; ++group) {
+    if (mergedRows[group] == std::numeric_limits<pos_t>::max())
+      continue;
+    writeGroupColumns(resultTab, mergedRows[group], row);
+    for (size_t f = 0; f < functions; ++f)
+      _aggregate_functions[f]->writeState(table, merged[group * functions + f], resultTab, row);
+    ++row;
+  }
+
+  this->addResult(resultTab);
+  return true;
+}
+
 }
 }
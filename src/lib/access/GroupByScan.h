@@ -36,6 +36,8 @@ public:
   ///      },
   ///      "edges": [["0", "1"], ["0", "2"], ["1", "2"]]
   ///  }
+  /// With "streaming": true no HashBuild is needed, the rows are
+  /// aggregated into per-group states on the fly (see setStreaming)
   static std::shared_ptr<PlanOperation> parse(const Json::Value &v);
   const std::string vname();
   /// creates output result table layout using _field_definitions
@@ -45,15 +47,35 @@ public:
   storage::atable_ptr_t createResultTableLayout();
   /// adds a given AggregateFunction to group by scan instance SUM or COUNT
   void addFunction(AggregateFun *fun);
+  /// Aggregates the input into partial tables of fixed-width states per
+  /// group instead of collecting the positions of every group. Tasks
+  /// group their rows by value ids into own open addressing tables that
+  /// are merged by hash partition. Only used if all functions are
+  /// streamable, otherwise the hash table input is required.
+  void setStreaming(bool streaming);
+  /// Streaming aggregation addresses the states of a group directly by
+  /// the main dictionary value ids of its columns if the product of the
+  /// dictionary sizes is at most groups, default 65536
+  void setDenseThreshold(size_t groups);
 
 private:
   void splitInput();
+  void writeGroupColumns(storage::atable_ptr_t &resultTab,
+                         const pos_t sourceRow,
+                         const size_t row);
   void writeGroupResult(storage::atable_ptr_t &resultTab,
                         const std::shared_ptr<storage::pos_list_t> &hit,
                         const size_t row);
   /// Depending on the number of fields to group by choose the appropriate map type
   template<typename HashTableType, typename MapType, typename KeyType>
   void executeGroupBy();
+  /// Groups are read from the position ranges of a FlatHashTable
+  void executeFlatGroupBy();
+  bool isStreaming() const;
+  void executeStreamingGroupBy();
+  /// Returns false without a result if the group columns do not fit a
+  /// dense array, e.g. for rows of a delta
+  bool executeDenseGroupBy();
 
   std::vector<AggregateFun *> _aggregate_functions;
 
@@ -63,6 +85,8 @@ private:
   //
   // Default values is to use the valueID hashing
   bool _globalAggregation = false;
+  bool _streaming = false;
+  size_t _denseThreshold = 65536;
 };
 
 }
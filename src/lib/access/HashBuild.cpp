@@ -1,6 +1,10 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/HashBuild.h"
 
+#include "access/system/OperationData-Impl.h"
+#include "storage/BloomFilter.h"
+#include "storage/DictionaryJoinTable.h"
+#include "storage/FlatHashTable.h"
 #include "storage/HashTable.h"
 #include "storage/TableRangeView.h"
 
@@ -20,7 +24,22 @@ void HashBuild::executePlanOperation() {
   auto input = std::dynamic_pointer_cast<const storage::TableRangeView>(getInputTable());
   if(input)
     row_offset = input->getStart();
-  if (_key == "groupby" || _key == "selfjoin" ) {
+  const bool partitioned = _partitions > 1 && _field_definition.size() <= storage::max_flat_key_columns;
+  const bool flat = _flat && _field_definition.size() <= storage::max_flat_key_columns;
+  std::shared_ptr<storage::DictionaryJoinTable> dictionaryTable;
+  if (_dictionary && _key == "join" && _field_definition.size() == 1)
+    dictionaryTable = storage::DictionaryJoinTable::build(getInputTable(), _field_definition[0], row_offset);
+  if (dictionaryTable) {
+    addResult(dictionaryTable);
+  } else if (partitioned && (_key == "groupby" || _key == "selfjoin")) {
+    addResult(storage::buildPartitionedFlatHashTable<storage::aggregate_single_key_t>(getInputTable(), _field_definition, _partitions, row_offset));
+  } else if (partitioned && _key == "join") {
+    addResult(storage::buildPartitionedFlatHashTable<storage::join_single_key_t>(getInputTable(), _field_definition, _partitions, row_offset));
+  } else if (flat && (_key == "groupby" || _key == "selfjoin")) {
+    addResult(storage::buildFlatHashTable<storage::aggregate_single_key_t>(getInputTable(), _field_definition, row_offset));
+  } else if (flat && _key == "join") {
+    addResult(storage::buildFlatHashTable<storage::join_single_key_t>(getInputTable(), _field_definition, row_offset));
+  } else if (_key == "groupby" || _key == "selfjoin" ) {
     if (_field_definition.size() == 1)
         addResult(std::make_shared<storage::SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset));
       else
@@ -33,6 +52,9 @@ void HashBuild::executePlanOperation() {
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
+  if (_bloomFilter) {
+    addResult(std::make_shared<storage::BloomFilter>(getInputTable(), _field_definition));
+  }
 }
 
 std::shared_ptr<PlanOperation> HashBuild::parse(const Json::Value &data) {
@@ -45,6 +67,10 @@ std::shared_ptr<PlanOperation> HashBuild::parse(const Json::Value &data) {
   if (data.isMember("key")) {
     instance->setKey(data["key"].asString());
   }
+  instance->setFlat(data.get("flat", false).asBool());
+  instance->setPartitions(data.get("partitions", 1).asUInt());
+  instance->setBloomFilter(data.get("bloomFilter", false).asBool());
+  instance->setDictionary(data.get("dictionary", false).asBool());
   return instance;
 }
 
@@ -60,5 +86,25 @@ const std::string HashBuild::getKey() const {
   return _key;
 }
 
+void HashBuild::setFlat(bool flat) {
+  _flat = flat;
+}
+
+void HashBuild::setPartitions(size_t partitions) {
+  _partitions = partitions;
+}
+
+void HashBuild::setBloomFilter(bool bloomFilter) {
+  _bloomFilter = bloomFilter;
+}
+
+void HashBuild::setDictionary(bool dictionary) {
+  _dictionary = dictionary;
+}
+
+std::shared_ptr<const storage::BloomFilter> HashBuild::getResultBloomFilter() const {
+  return output.nthOf<storage::BloomFilter>(0);
+}
+
 }
 }
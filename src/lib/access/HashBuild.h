@@ -5,6 +5,10 @@
 #include "access/system/ParallelizablePlanOperation.h"
 
 namespace hyrise {
+namespace storage {
+class BloomFilter;
+}
+
 namespace access {
 
 class HashBuild : public ParallelizablePlanOperation {
@@ -21,18 +25,36 @@ public:
   ///         },
   ///         "1": {
   ///             "type": "HashBuild",
-  ///             "fields" : [1]
+  ///             "fields" : [1],
+  ///             "flat" : true
   ///         },
   ///     },
   ///         "edges": [["0", "1"]]
   /// }
+  /// With "flat" the rows are hashed into a FlatHashTable if there are at
+  /// most four key columns. Setting "partitions" to more than one builds
+  /// a PartitionedFlatHashTable in parallel instead, which does not need
+  /// a MergeHashTables. With "bloomFilter" a BloomFilter over the keys is
+  /// emitted as second result for a BloomFilterScan on the probe side.
+  /// With "dictionary" a join on a single column whose rows all refer to
+  /// its main dictionary builds a DictionaryJoinTable that is addressed
+  /// by value id, other builds fall back to the options above.
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   void setKey(const std::string &key);
   const std::string getKey() const;
+  void setFlat(bool flat);
+  void setPartitions(size_t partitions);
+  void setBloomFilter(bool bloomFilter);
+  void setDictionary(bool dictionary);
+  std::shared_ptr<const storage::BloomFilter> getResultBloomFilter() const;
 
 private:
   std::string _key;
+  bool _flat = false;
+  size_t _partitions = 1;
+  bool _bloomFilter = false;
+  bool _dictionary = false;
 };
 
 }
@@ -1,10 +1,16 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/HashJoinProbe.h"
 
+#include <algorithm>
+
 #include "access/system/QueryParser.h"
 
+#include "storage/FlatHashTable.h"
 #include "storage/HashTable.h"
+#include "storage/HorizontalTable.h"
+#include "storage/meta_storage.h"
 #include "storage/PointerCalculator.h"
+#include "taskscheduler/ParallelFor.h"
 
 #include <log4cxx/logger.h>
 
@@ -14,6 +20,51 @@ namespace access {
 namespace {
   auto _ = QueryParser::registerPlanOperation<HashJoinProbe>("HashJoinProbe");
   log4cxx::LoggerPtr logger(log4cxx::Logger::getLogger("access.plan.PlanOperation"));
+
+  struct set_default_functor {
+    typedef void value_type;
+    const storage::atable_ptr_t &table;
+    const size_t column;
+
+    set_default_functor(const storage::atable_ptr_t &t, size_t c) : table(t), column(c) {}
+
+    template<typename R>
+    void operator()() {
+      table->setValue<R>(column, 0, R());
+    }
+  };
+
+  // Appends a row of default values that stands in for the missing rows
+  // of an outer join at position table->size()
+  storage::c_atable_ptr_t appendNullRow(const storage::c_atable_ptr_t &table) {
+    auto row = table->copy_structure_modifiable(nullptr, 1);
+    row->resize(1);
+    storage::type_switch<hyrise_basic_types> ts;
+    for (size_t column = 0; column < row->columnCount(); ++column) {
+      set_default_functor fun(row, column);
+      ts(row->typeOfColumn(column), fun);
+    }
+    return std::make_shared<storage::HorizontalTable>(std::vector<storage::c_atable_ptr_t> {table, row});
+  }
+
+  std::vector<bool> matchedRows(const pos_list_t &matches, size_t rows) {
+    std::vector<bool> matched(rows, false);
+    for (const auto &row : matches)
+      matched[row] = true;
+    return matched;
+  }
+
+  // Pairs every row of one side that has no match with the null row of
+  // the other side
+  void appendUnmatched(pos_list_t *matches, size_t rows, pos_list_t *other, pos_t nullRow) {
+    const auto matched = matchedRows(*matches, rows);
+    for (pos_t row = 0; row < rows; ++row) {
+      if (!matched[row]) {
+        matches->push_back(row);
+        other->push_back(nullRow);
+      }
+    }
+  }
 }
 
 HashJoinProbe::HashJoinProbe() : _selfjoin(false) {
@@ -31,7 +82,9 @@ void HashJoinProbe::executePlanOperation() {
   storage::pos_list_t *buildTablePosList = new pos_list_t;
   storage::pos_list_t *probeTablePosList = new pos_list_t;
 
-  if (_selfjoin) {
+  if (std::dynamic_pointer_cast<const storage::AbstractFlatHashTable>(getInputHashTable(0))) {
+    fetchFlatPositions(buildTablePosList, probeTablePosList);
+  } else if (_selfjoin) {
     if (_field_definition.size() == 1)
       fetchPositions<storage::SingleAggregateHashTable>(buildTablePosList, probeTablePosList);
     else
@@ -43,6 +96,31 @@ void HashJoinProbe::executePlanOperation() {
       fetchPositions<storage::JoinHashTable>(buildTablePosList, probeTablePosList);
   }
 
+  const size_t probeRows = getProbeTable()->size(), buildRows = getBuildTable()->size();
+  switch (_joinType) {
+    case ProbeJoinType::SEMI:
+    case ProbeJoinType::ANTI: {
+      const auto matched = matchedRows(*probeTablePosList, probeRows);
+      auto rows = new pos_list_t;
+      for (pos_t row = 0; row < probeRows; ++row) {
+        if (matched[row] == (_joinType == ProbeJoinType::SEMI))
+          rows->push_back(row);
+      }
+      delete buildTablePosList;
+      delete probeTablePosList;
+      addResult(storage::PointerCalculator::create(getProbeTable(), rows));
+      return;
+    }
+    case ProbeJoinType::LEFT_OUTER:
+      appendUnmatched(probeTablePosList, probeRows, buildTablePosList, buildRows);
+      break;
+    case ProbeJoinType::RIGHT_OUTER:
+      appendUnmatched(buildTablePosList, buildRows, probeTablePosList, probeRows);
+      break;
+    case ProbeJoinType::INNER:
+      break;
+  }
+
   addResult(buildResultTable(buildTablePosList, probeTablePosList));
 }
 
@@ -54,6 +132,24 @@ std::shared_ptr<PlanOperation> HashJoinProbe::parse(const Json::Value &data) {
     }
   }
   instance->_selfjoin = data["selfjoin"].asBool();
+  if (data.isMember("morselSize")) {
+    instance->setMorselSize(data["morselSize"].asUInt());
+  }
+  if (data.isMember("joinType")) {
+    const auto joinType = data["joinType"].asString();
+    if (joinType == "inner")
+      instance->setJoinType(ProbeJoinType::INNER);
+    else if (joinType == "leftOuter")
+      instance->setJoinType(ProbeJoinType::LEFT_OUTER);
+    else if (joinType == "rightOuter")
+      instance->setJoinType(ProbeJoinType::RIGHT_OUTER);
+    else if (joinType == "semi")
+      instance->setJoinType(ProbeJoinType::SEMI);
+    else if (joinType == "anti")
+      instance->setJoinType(ProbeJoinType::ANTI);
+    else
+      throw std::runtime_error("Unknown joinType " + joinType + " for HashJoinProbe");
+  }
   return instance;
 }
 
@@ -61,6 +157,14 @@ const std::string HashJoinProbe::vname() {
   return "HashJoinProbe";
 }
 
+void HashJoinProbe::setMorselSize(size_t morselSize) {
+  _morselSize = morselSize;
+}
+
+void HashJoinProbe::setJoinType(ProbeJoinType::type joinType) {
+  _joinType = joinType;
+}
+
 void HashJoinProbe::setBuildTable(const storage::c_atable_ptr_t &table) {
   _buildTable = table;
 }
@@ -96,12 +200,54 @@ void HashJoinProbe::fetchPositions(storage::pos_list_t *buildTablePosList,
   LOG4CXX_DEBUG(logger, "Done Probing");
 }
 
+void HashJoinProbe::fetchFlatPositions(storage::pos_list_t *buildTablePosList,
+                                       storage::pos_list_t *probeTablePosList) {
+  const auto& probeTable = getProbeTable();
+  const auto& hash_table = std::dynamic_pointer_cast<const storage::AbstractFlatHashTable>(getInputHashTable(0));
+
+  LOG4CXX_DEBUG(logger, hash_table->stats());
+  LOG4CXX_DEBUG(logger, "Probe Table Size: " << probeTable->size());
+  LOG4CXX_DEBUG(logger, "Hash Table Size:  " << hash_table->size());
+
+  const size_t probeRows = probeTable->size();
+  if (_morselSize == 0 || probeRows <= _morselSize) {
+    buildTablePosList->reserve(probeRows);
+    probeTablePosList->reserve(probeRows);
+    hash_table->probe(probeTable, _field_definition, 0, probeRows, *buildTablePosList, *probeTablePosList);
+  } else {
+    // Every morsel fills its own position lists, the result is their
+    // concatenation in morsel order
+    const size_t morselCount = (probeRows + _morselSize - 1) / _morselSize;
+    std::vector<pos_list_t> buildResults(morselCount), probeResults(morselCount);
+    taskscheduler::parallelFor(morselCount, [&] (size_t morsel) {
+        const size_t begin = morsel * _morselSize, end = std::min(probeRows, begin + _morselSize);
+        buildResults[morsel].reserve(end - begin);
+        probeResults[morsel].reserve(end - begin);
+        hash_table->probe(probeTable, _field_definition, begin, end, buildResults[morsel], probeResults[morsel]);
+      });
+
+    size_t matches = 0;
+    for (const auto& result : buildResults)
+      matches += result.size();
+    buildTablePosList->reserve(matches);
+    probeTablePosList->reserve(matches);
+    for (size_t morsel = 0; morsel < morselCount; ++morsel) {
+      buildTablePosList->insert(buildTablePosList->end(), buildResults[morsel].begin(), buildResults[morsel].end());
+      probeTablePosList->insert(probeTablePosList->end(), probeResults[morsel].begin(), probeResults[morsel].end());
+    }
+  }
+
+  LOG4CXX_DEBUG(logger, "Done Probing");
+}
+
 storage::atable_ptr_t HashJoinProbe::buildResultTable(storage::pos_list_t *buildTablePosList,
                                                       storage::pos_list_t *probeTablePosList) const {
   std::vector<storage::atable_ptr_t> parts;
 
-  auto buildTableRows = storage::PointerCalculator::create(getBuildTable(), buildTablePosList);
-  auto probeTableRows = storage::PointerCalculator::create(getProbeTable(), probeTablePosList);
+  const auto &buildTable = _joinType == ProbeJoinType::LEFT_OUTER ? appendNullRow(getBuildTable()) : getBuildTable();
+  const auto &probeTable = _joinType == ProbeJoinType::RIGHT_OUTER ? appendNullRow(getProbeTable()) : getProbeTable();
+  auto buildTableRows = storage::PointerCalculator::create(buildTable, buildTablePosList);
+  auto probeTableRows = storage::PointerCalculator::create(probeTable, probeTablePosList);
 
   parts.push_back(probeTableRows);
   parts.push_back(buildTableRows);
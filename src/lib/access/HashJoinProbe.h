@@ -8,9 +8,29 @@
 namespace hyrise {
 namespace access {
 
+struct ProbeJoinType {
+  enum type {
+    INNER,
+    LEFT_OUTER,
+    RIGHT_OUTER,
+    SEMI,
+    ANTI
+  };
+};
+
 /// The HashJoinProbe operator performs the probe phase of a hash join to
 /// produce the join result.
 /// It takes the build table's AbstractHashTable and the probe table as input.
+///
+/// The probe table is the left, the build table the right side of the
+/// join. Outer joins pair the rows without a match with a row of default
+/// values (0, 0.0 and "") appended to the other side, semi and anti joins
+/// return the rows of the probe table that have or do not have a match.
+///
+/// The padded values cannot be told apart from stored defaults. Consumers
+/// that need to detect them check the positions of the padded side: the
+/// appended row has the position of the input's size, one past its last
+/// row.
 class HashJoinProbe : public ParallelizablePlanOperation {
 public:
   HashJoinProbe();
@@ -36,13 +56,21 @@ public:
   ///         },
   ///         "3": {
   ///             "type": "HashJoinProbe",
-  ///             "fields" : [0]
+  ///             "fields" : [0],
+  ///             "joinType": "leftOuter" // inner, leftOuter, rightOuter, semi or anti;
+  ///                                     // outer joins pad unmatched rows with
+  ///                                     // 0, 0.0 and "" (see class comment)
   ///         }
   ///     },
   ///     "edges": [["0", "2"], ["2", "3"], ["1", "3"]]
   /// }
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
+  /// Probes flat hash tables in morsels of morselSize probe rows that
+  /// helper tasks pull from a shared counter, 0 probes on the calling
+  /// thread only.
+  void setMorselSize(size_t morselSize);
+  void setJoinType(ProbeJoinType::type joinType);
   void setBuildTable(const storage::c_atable_ptr_t &table);
   storage::c_atable_ptr_t getBuildTable() const;
   storage::c_atable_ptr_t getProbeTable() const;
@@ -53,11 +81,17 @@ private:
   template<class HashTable>
   void fetchPositions(storage::pos_list_t *buildTablePosList,
                       storage::pos_list_t *probeTablePosList);
+  /// Same as above for a flat hash table, rows are probed in prefetching
+  /// batches straight into the position lists.
+  void fetchFlatPositions(storage::pos_list_t *buildTablePosList,
+                          storage::pos_list_t *probeTablePosList);
   /// Constructs resulting table from given build and probe tables' rows.
   storage::atable_ptr_t buildResultTable(storage::pos_list_t *buildTablePosList,
                                          storage::pos_list_t *probeTablePosList) const;
   storage::c_atable_ptr_t _buildTable;
+  ProbeJoinType::type _joinType = ProbeJoinType::INNER;
   bool _selfjoin;
+  size_t _morselSize = 0;
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include "helper/vector_helpers.h"
 #include "helper/checked_cast.h"
+#include "helper/locking.h"
 #include "helper/stringhelpers.h"
 
 #include "io/TransactionManager.h"
@@ -83,9 +84,11 @@ void InsertScan::executePlanOperation() {
   if (!_data)
     _data = buildFromJson();
 
+  // An online merge must not freeze the delta while we write to it
+  locking::SharedLockGuard deltaLock(store->deltaWriteLock());
   auto writeArea = store->appendToDelta(_data->size());
 
-  const size_t firstPosition = store->getMainTable()->size() + writeArea.first;
+  const size_t firstPosition = store->deltaOffset() + writeArea.first;
 
   // Get the modifications record
   auto& mods = tx::TransactionManager::getInstance()[_txContext.tid];
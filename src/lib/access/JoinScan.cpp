@@ -1,16 +1,21 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/JoinScan.h"
 
+#include <algorithm>
+
 #include "access/expressions/expression_types.h"
 #include "access/system/QueryParser.h"
 
 #include "storage/PointerCalculator.h"
+#include "taskscheduler/ParallelFor.h"
 
 namespace hyrise {
 namespace access {
 
 namespace {
   auto _ = QueryParser::registerPlanOperation<JoinScan>("JoinScan");
+
+  const size_t band_chunk_rows = 16 * 1024;
 }
 
 JoinScan::JoinScan(const JoinType::type t) :
@@ -23,10 +28,29 @@ JoinScan::~JoinScan() {
 }
 
 void JoinScan::setupPlanOperation() {
-  _join_condition->walk(input.getTables());
+  if (_join_condition)
+    _join_condition->walk(input.getTables());
 }
 
 void JoinScan::executePlanOperation() {
+  if (_join_type == JoinType::BAND) {
+    switch (input.getTable(0)->typeOfColumn(_band_field_left)) {
+      case IntegerType:
+      case IntegerTypeDelta:
+      case IntegerTypeDeltaConcurrent:
+        return executeBandJoin<storage::hyrise_int_t>();
+      case IntegerNoDictType:
+        return executeBandJoin<storage::hyrise_int32_t>();
+      case FloatType:
+      case FloatTypeDelta:
+      case FloatTypeDeltaConcurrent:
+      case FloatNoDictType:
+        return executeBandJoin<storage::hyrise_float_t>();
+      default:
+        throw std::runtime_error("JoinScan supports band joins on numeric fields only");
+    }
+  }
+
   if (_join_type != JoinType::EQUI) {
     throw std::runtime_error("Currently only JoinType::EQUI supported by JoinScan");
   }
@@ -58,10 +82,59 @@ void JoinScan::executePlanOperation() {
       std::vector<storage::atable_ptr_t> {left_target, right_target}));
 }
 
+template<typename T>
+void JoinScan::executeBandJoin() {
+  const auto &left = input.getTable(0);
+  const auto &right = input.getTable(1);
+  if (!types::isCompatible(left->typeOfColumn(_band_field_left), right->typeOfColumn(_band_field_right)))
+    throw std::runtime_error("JoinScan requires band join fields of the same type");
+
+  std::vector<std::pair<T, storage::pos_t>> sorted;
+  sorted.reserve(right->size());
+  for (storage::pos_t row = 0, size = right->size(); row < size; ++row)
+    sorted.emplace_back(right->getValue<T>(_band_field_right, row), row);
+  std::sort(sorted.begin(), sorted.end());
+
+  // Left rows are processed in chunks whose results are concatenated in
+  // order, every left row lists its matches in ascending right value
+  const size_t left_size = left->size();
+  const size_t chunks = (left_size + band_chunk_rows - 1) / band_chunk_rows;
+  std::vector<storage::pos_list_t> left_results(chunks), right_results(chunks);
+  taskscheduler::parallelFor(chunks, [&] (size_t chunk) {
+      for (storage::pos_t row = chunk * band_chunk_rows, end = std::min(left_size, row + band_chunk_rows); row < end; ++row) {
+        const double value = left->getValue<T>(_band_field_left, row);
+        const double first = value - _band_upper, last = value - _band_lower;
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), first,
+                                   [] (const std::pair<T, storage::pos_t> &entry, double bound) { return entry.first < bound; });
+        for (; it != sorted.end() && it->first <= last; ++it) {
+          left_results[chunk].push_back(row);
+          right_results[chunk].push_back(it->second);
+        }
+      }
+    }, 0, _priority);
+
+  auto left_positions = new storage::pos_list_t;
+  auto right_positions = new storage::pos_list_t;
+  for (size_t chunk = 0; chunk < chunks; ++chunk) {
+    left_positions->insert(left_positions->end(), left_results[chunk].begin(), left_results[chunk].end());
+    right_positions->insert(right_positions->end(), right_results[chunk].begin(), right_results[chunk].end());
+  }
+
+  addResult(std::make_shared<storage::MutableVerticalTable>(std::vector<storage::atable_ptr_t> {
+        storage::PointerCalculator::create(left, left_positions),
+        storage::PointerCalculator::create(right, right_positions)}));
+}
+
 std::shared_ptr<PlanOperation> JoinScan::parse(const Json::Value &v) {
   JoinType::type t = JoinType::type(v["join_type"].asUInt());
   std::shared_ptr<JoinScan> s = std::make_shared<JoinScan>(t);
 
+  if (v.isMember("band")) {
+    const Json::Value &band = v["band"];
+    s->setBand(band["field_left"].asUInt(), band["field_right"].asUInt(),
+               band["lower"].asDouble(), band["upper"].asDouble());
+  }
+
   for (unsigned i = 0; i < v["predicates"].size(); ++i) {
     Json::Value p = v["predicates"][i];
     if (parseExpressionType(p["type"]) == EXP_EQ) {
@@ -78,6 +151,16 @@ const std::string JoinScan::vname() {
   return "JoinScan";
 }
 
+void JoinScan::setBand(const storage::field_t field_left,
+                       const storage::field_t field_right,
+                       const double lower,
+                       const double upper) {
+  _band_field_left = field_left;
+  _band_field_right = field_right;
+  _band_lower = lower;
+  _band_upper = upper;
+}
+
 void JoinScan::addCombiningClause(const ExpressionType etype) {
   CompoundJoinExpression *c = new CompoundJoinExpression(etype);
   if (_join_condition == nullptr) {
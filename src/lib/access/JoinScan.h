@@ -21,13 +21,18 @@ struct JoinType {
   enum type {
     EQUI,
     INNER,
-    OUTER
+    OUTER,
+    BAND
   };
 };
 
 /// A join statement takes two tables as input. For all join types
 /// there must be predicates specifying the join condition for the
 /// input tables
+///
+/// A band join matches the rows for which lower <= left - right <= upper
+/// holds on a numeric field of each table. The right table is sorted on
+/// its field, so every left row only visits the right rows of its band.
 class JoinScan: public ParallelizablePlanOperation {
 public:
   JoinScan(const JoinType::type t);
@@ -36,6 +41,7 @@ public:
   void setupPlanOperation();
   void executePlanOperation();
   /// { type: "JoinScan", jtype: "EQUI", predicates: [{type: 0}, {type: 3, in: 0, f:0}, {type: "3"] }
+  /// { type: "JoinScan", join_type: 3, band: {field_left: 0, field_right: 0, lower: -1, upper: 1} }
   static std::shared_ptr<PlanOperation> parse(const Json::Value &v);
   const std::string vname();
   template<typename T>
@@ -46,12 +52,23 @@ public:
   template<typename T>
   void addJoinClause(const Json::Value &value);
   void addCombiningClause(const ExpressionType t);
+  void setBand(const storage::field_t field_left,
+               const storage::field_t field_right,
+               const double lower,
+               const double upper);
 
 private:
+  template<typename T>
+  void executeBandJoin();
+
   void addJoinExpression(JoinExpression *);
   JoinType::type _join_type;
   JoinExpression *_join_condition;
   std::stack<CompoundJoinExpression *> _compound_stack;
+  storage::field_t _band_field_left = 0;
+  storage::field_t _band_field_right = 0;
+  double _band_lower = 0;
+  double _band_upper = 0;
 };
 
 template<typename T>
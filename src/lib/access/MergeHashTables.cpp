@@ -3,6 +3,8 @@
 
 #include "access/system/QueryParser.h"
 
+#include "storage/DictionaryJoinTable.h"
+#include "storage/FlatHashTable.h"
 #include "storage/HashTable.h"
 
 namespace hyrise {
@@ -14,7 +16,14 @@ namespace {
 
 void MergeHashTables::executePlanOperation() {
   // get first HashTable and merge subsequent tables into HashTable
-  if (_key == "groupby" || _key == "selfjoin" ) {
+  const bool flat = std::dynamic_pointer_cast<const storage::AbstractFlatHashTable>(getInputHashTable(0)) != nullptr;
+  if (std::dynamic_pointer_cast<const storage::DictionaryJoinTable>(getInputHashTable(0))) {
+    addResult(std::make_shared<storage::DictionaryJoinTable>(input.getHashTables()));
+  } else if (flat && (_key == "groupby" || _key == "selfjoin")) {
+    addResult(storage::mergeFlatHashTables<storage::aggregate_single_key_t>(input.getHashTables()));
+  } else if (flat && _key == "join") {
+    addResult(storage::mergeFlatHashTables<storage::join_single_key_t>(input.getHashTables()));
+  } else if (_key == "groupby" || _key == "selfjoin" ) {
   	if (getInputHashTable(0)->getFieldCount() == 1)
   		addResult(std::make_shared<storage::SingleAggregateHashTable>(input.getHashTables()));
   	else
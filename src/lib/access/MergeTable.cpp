@@ -1,9 +1,13 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/MergeTable.h"
 
+#include <memory>
+
 #include "access/system/QueryParser.h"
 
 #include "helper/checked_cast.h"
+#include "io/RedoLog.h"
+#include "storage/ParallelMerger.h"
 #include "storage/Store.h"
 
 namespace hyrise {
@@ -22,6 +26,9 @@ void MergeTable::executePlanOperation() {
   for (auto& table: input.getTables()) {
     if (auto store = std::dynamic_pointer_cast<const storage::Store>(table)) {
       tables.push_back(store->getMainTable());
+      if (auto frozen = store->getFrozenDeltaTable()) {
+        tables.push_back(frozen);
+      }
       tables.push_back(store->getDeltaTable());
     } else {
       tables.push_back(table);
@@ -29,7 +36,10 @@ void MergeTable::executePlanOperation() {
   }
 
   // Call the Merge
-  storage::TableMerger merger(new storage::DefaultMergeStrategy(), new storage::SequentialHeapMerger());
+  storage::AbstractMerger *valueMerger = _parallel ?
+      static_cast<storage::AbstractMerger *>(new storage::ParallelMerger()) :
+      static_cast<storage::AbstractMerger *>(new storage::SequentialHeapMerger());
+  storage::TableMerger merger(new storage::DefaultMergeStrategy(), valueMerger);
   auto new_table = input.getTable(0)->copy_structure();
 
   // Switch the tables
@@ -40,13 +50,19 @@ void MergeTable::executePlanOperation() {
 }
 
 std::shared_ptr<PlanOperation> MergeTable::parse(const Json::Value& data) {
-  return std::make_shared<MergeTable>();
+  auto mt = std::make_shared<MergeTable>();
+  mt->setParallel(data.get("parallel", false).asBool());
+  return mt;
 }
 
 const std::string MergeTable::vname() {
   return "MergeTable";
 }
 
+void MergeTable::setParallel(bool parallel) {
+  _parallel = parallel;
+}
+
 namespace {
   auto _2 = QueryParser::registerPlanOperation<MergeStore>("MergeStore");
 }
@@ -57,12 +73,36 @@ MergeStore::~MergeStore() {
 void MergeStore::executePlanOperation() {
   auto t = checked_pointer_cast<const storage::Store>(getInputTable());
   auto store = std::const_pointer_cast<storage::Store>(t);
-  store->merge();
+  // The parallel merger only serves this merge, the store keeps its own
+  std::unique_ptr<storage::TableMerger> merger;
+  if (_parallel) {
+    merger.reset(new storage::TableMerger(new storage::DefaultMergeStrategy(), new storage::ParallelMerger(), false));
+  }
+  if (_online) {
+    if (merger)
+      store->mergeOnline(*merger);
+    else
+      store->mergeOnline();
+  } else {
+    // Blocking merges move rows, replaying later records depends on them
+    tx::RedoLog::getInstance().merge(store, merger.get());
+  }
   addResult(store);
 }
 
 std::shared_ptr<PlanOperation> MergeStore::parse(const Json::Value& data) {
-  return std::make_shared<MergeStore>();
+  auto ms = std::make_shared<MergeStore>();
+  ms->setParallel(data.get("parallel", false).asBool());
+  ms->setOnline(data.get("online", false).asBool());
+  return ms;
+}
+
+void MergeStore::setParallel(bool parallel) {
+  _parallel = parallel;
+}
+
+void MergeStore::setOnline(bool online) {
+  _online = online;
 }
 
 
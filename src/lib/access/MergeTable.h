@@ -14,6 +14,11 @@ public:
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
   const std::string vname();
+  /// Use the ParallelMerger instead of the SequentialHeapMerger
+  void setParallel(bool parallel);
+
+private:
+  bool _parallel = false;
 };
 
 class MergeStore : public PlanOperation {
@@ -21,6 +26,14 @@ public:
   virtual ~MergeStore();
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  /// Replaces the merger of the store with a ParallelMerger before merging
+  void setParallel(bool parallel);
+  /// Merge without blocking concurrent writers, see Store::mergeOnline
+  void setOnline(bool online);
+
+private:
+  bool _parallel = false;
+  bool _online = false;
 };
 
 
@@ -6,6 +6,7 @@
 
 #include "helper/vector_helpers.h"
 #include "helper/checked_cast.h"
+#include "helper/locking.h"
 
 #include "io/TransactionManager.h"
 
@@ -36,9 +37,11 @@ void PosUpdateScan::executePlanOperation() {
 
   // Get the offset for inserts into the delta and the size of the delta that
   // we need to increase by the positions we are inserting
+  // An online merge must not freeze the delta while we write to it
+  locking::SharedLockGuard deltaLock(store->deltaWriteLock());
   auto writeArea = store->appendToDelta(c_pc->getPositions()->size());
 
-  const size_t firstPosition = store->getMainTable()->size() + writeArea.first;
+  const size_t firstPosition = store->deltaOffset() + writeArea.first;
 
   // Get the modification record for the current transaction
   auto& txmgr = tx::TransactionManager::getInstance();
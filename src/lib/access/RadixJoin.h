@@ -34,31 +34,9 @@ protected:
 private:
   uint32_t _bits1;
   uint32_t _bits2;
-  static const size_t MaxParallelizationDegree = 24;
-
-void distributePartitions(
-          const int partitions,
-          const int join_count,
-          const int current_join,
-          int &first,
-          int &last) const;
 
 void copyTaskAttributesFromThis(std::shared_ptr<PlanOperation> to);
 
-std::vector<taskscheduler::task_ptr_t> build_probe_side(std::string prefix,
-                                                          field_t &fields,
-                                                          uint probe_par,
-                                                          uint32_t bits1,
-                                                          uint32_t bits2,
-                                                          taskscheduler::task_ptr_t input);
-
-std::vector<taskscheduler::task_ptr_t> build_hash_side(std::string prefix,
-                                                          field_t &fields,
-                                                          uint probe_par,
-                                                          uint32_t bits1,
-                                                          uint32_t bits2,
-                                                          taskscheduler::task_ptr_t input);
-
 };
 
 }
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/SimpleTableScan.h"
 
+#include <algorithm>
+
 #include "access/expressions/pred_buildExpression.h"
 
 #include "storage/Store.h"
@@ -8,6 +10,8 @@
 
 #include "helper/checked_cast.h"
 
+#include "taskscheduler/ParallelFor.h"
+
 namespace hyrise {
 namespace access {
 
@@ -30,14 +34,7 @@ void SimpleTableScan::setupPlanOperation() {
 void SimpleTableScan::executePositional() {
   auto tbl = input.getTable(0);
   storage::pos_list_t *pos_list = new pos_list_t();
-
-
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size(); row < input_size; ++row) {
-    if ((*_comparator)(row)) {
-      pos_list->push_back(row);
-    }
-  }
+  evaluate(*pos_list);
   addResult(storage::PointerCalculator::create(tbl, pos_list));
 }
 
@@ -46,21 +43,55 @@ void SimpleTableScan::executeMaterialized() {
   auto result_table = tbl->copy_structure_modifiable();
   size_t target_row = 0;
 
+  pos_list_t positions;
+  evaluate(positions);
+  result_table->resize(positions.size());
+  for (const auto& match : positions) {
+    result_table->copyRowFrom(input.getTable(0),
+                              match,
+                              target_row++,
+                              true /* Copy Value*/,
+                              false /* Use Memcpy */);
+  }
+  addResult(result_table);
+}
+
+void SimpleTableScan::evaluate(pos_list_t& positions) {
+  const auto& tbl = input.getTable(0);
   size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size();
-       row < input_size;
-       ++row) {
-    if ((*_comparator)(row)) {
-        // TODO materializing result set will make the allocation the boundary
-      result_table->resize(target_row + 1);
-      result_table->copyRowFrom(input.getTable(0),
-                                row,
-                                target_row++,
-                                true /* Copy Value*/,
-                                false /* Use Memcpy */);
+  evaluateRange(row, tbl->size(), positions);
+
+  // Checks only the matches against the cached snapshot visibility
+  if (_validate) {
+    if (const auto& store = std::dynamic_pointer_cast<const storage::Store>(tbl)) {
+      store->validatePositions(positions, _txContext.lastCid, _txContext.tid);
     }
   }
-  addResult(result_table);
+}
+
+void SimpleTableScan::evaluateRange(size_t start, size_t stop, pos_list_t& positions) {
+  if (_morselSize == 0 || stop - start <= _morselSize) {
+    _comparator->evaluate(start, stop, positions);
+    return;
+  }
+
+  // Every morsel writes its own position list, the result is their
+  // concatenation in morsel order
+  const size_t morselCount = (stop - start + _morselSize - 1) / _morselSize;
+  std::vector<pos_list_t> results(morselCount);
+  taskscheduler::parallelFor(morselCount, [&] (size_t morsel) {
+      const size_t begin = start + morsel * _morselSize;
+      _comparator->evaluate(begin, std::min(stop, begin + _morselSize), results[morsel]);
+    }, 0, _priority);
+
+  size_t total = positions.size();
+  for (const auto& result : results) {
+    total += result.size();
+  }
+  positions.reserve(total);
+  for (const auto& result : results) {
+    positions.insert(positions.end(), result.begin(), result.end());
+  }
 }
 
 void SimpleTableScan::executePlanOperation() {
@@ -86,6 +117,12 @@ std::shared_ptr<PlanOperation> SimpleTableScan::parse(const Json::Value &data) {
     pop->_ofDelta = data["ofDelta"].asBool();
   }
 
+  if (data.isMember("morselSize")) {
+    pop->setMorselSize(data["morselSize"].asUInt());
+  }
+
+  pop->setValidate(data.get("validate", false).asBool());
+
   return pop;
 }
 
@@ -97,5 +134,13 @@ void SimpleTableScan::setPredicate(SimpleExpression *c) {
   _comparator = c;
 }
 
+void SimpleTableScan::setMorselSize(size_t morselSize) {
+  _morselSize = morselSize;
+}
+
+void SimpleTableScan::setValidate(bool validate) {
+  _validate = validate;
+}
+
 }
 }
@@ -20,10 +20,24 @@ public:
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   void setPredicate(SimpleExpression *c);
+  /// Enables the morsel-driven mode: the scanned range is split into
+  /// morsels of morselSize rows that helper tasks pull from a shared
+  /// cursor, 0 scans the whole range in the calling task
+  void setMorselSize(size_t morselSize);
+  /// Only returns rows of a store input that are visible to the
+  /// transaction, which makes a following ValidatePositions unnecessary
+  void setValidate(bool validate);
 
 private:
+  /// Appends all matching rows in [start, stop) to positions in ascending order
+  void evaluateRange(size_t start, size_t stop, pos_list_t& positions);
+  /// Appends all matching and, if requested, visible rows of the input
+  void evaluate(pos_list_t& positions);
+
   SimpleExpression *_comparator;
   bool _ofDelta = false;
+  size_t _morselSize = 0;
+  bool _validate = false;
 };
 
 }
@@ -0,0 +1,240 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/SortMergeJoin.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "access/system/BasicParser.h"
+#include "access/system/QueryParser.h"
+
+#include "storage/BaseDictionary.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "taskscheduler/ParallelFor.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerPlanOperation<SortMergeJoin>("SortMergeJoin");
+
+  const size_t chunk_rows = 64 * 1024;
+  // Lower bound for the number of distinct keys merged by one task
+  const size_t min_range_groups = 1024;
+
+  // Rows of one join side grouped by ascending key, group i holds the
+  // rows positions[offsets[i], offsets[i + 1]) with key values[i]
+  template<typename T>
+  struct sorted_groups_t {
+    std::vector<T> values;
+    std::vector<size_t> offsets;
+    std::vector<pos_t> positions;
+
+    sorted_groups_t() : offsets(1, 0) {}
+
+    size_t size() const {
+      return values.size();
+    }
+
+    void append(const T &value, const pos_t *begin, const pos_t *end) {
+      values.push_back(value);
+      positions.insert(positions.end(), begin, end);
+      offsets.push_back(positions.size());
+    }
+  };
+
+  // Merges two groupings of the same side, rows of equal keys are combined
+  template<typename T>
+  sorted_groups_t<T> mergeGroups(const sorted_groups_t<T> &a, const sorted_groups_t<T> &b) {
+    sorted_groups_t<T> result;
+    result.positions.reserve(a.positions.size() + b.positions.size());
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+      if (j == b.size() || (i < a.size() && a.values[i] < b.values[j])) {
+        result.append(a.values[i], a.positions.data() + a.offsets[i], a.positions.data() + a.offsets[i + 1]);
+        ++i;
+      } else if (i == a.size() || b.values[j] < a.values[i]) {
+        result.append(b.values[j], b.positions.data() + b.offsets[j], b.positions.data() + b.offsets[j + 1]);
+        ++j;
+      } else {
+        result.append(a.values[i], a.positions.data() + a.offsets[i], a.positions.data() + a.offsets[i + 1]);
+        result.positions.insert(result.positions.end(), b.positions.data() + b.offsets[j], b.positions.data() + b.offsets[j + 1]);
+        result.offsets.back() = result.positions.size();
+        ++i;
+        ++j;
+      }
+    }
+    return result;
+  }
+
+  // Sorts the rows of a join side whose values of type T are keyed as K.
+  // Rows that refer to an order-preserving main dictionary are bucketed by
+  // value id, the remaining rows are sorted on their values.
+  template<typename T, typename K>
+  sorted_groups_t<K> sortSide(const storage::c_atable_ptr_t &table, const field_t field) {
+    const size_t rows = table->size();
+    const auto type = table->typeOfColumn(field);
+    std::shared_ptr<storage::BaseDictionary<T>> main;
+    if (type != IntegerNoDictType && type != FloatNoDictType) {
+      const auto &dictionary = table->dictionaryByTableId(field, 0);
+      if (dictionary && dictionary->isOrdered())
+        main = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(dictionary);
+    }
+
+    std::vector<ValueId> valueIds;
+    if (main) {
+      valueIds.resize(rows);
+      taskscheduler::parallelFor((rows + chunk_rows - 1) / chunk_rows, [&] (size_t chunk) {
+          for (size_t row = chunk * chunk_rows, end = std::min(rows, row + chunk_rows); row < end; ++row)
+            valueIds[row] = table->getValueId(field, row);
+        });
+    }
+
+    sorted_groups_t<K> coded;
+    std::vector<std::pair<K, pos_t>> uncoded;
+    if (main) {
+      const size_t domain = main->size();
+      std::vector<size_t> offsets(domain + 1, 0);
+      for (size_t row = 0; row < rows; ++row) {
+        if (valueIds[row].table == 0)
+          ++offsets[valueIds[row].valueId + 1];
+        else
+          uncoded.emplace_back(static_cast<K>(table->getValue<T>(field, row)), row);
+      }
+      for (size_t id = 0; id < domain; ++id)
+        offsets[id + 1] += offsets[id];
+
+      coded.positions.resize(offsets[domain]);
+      std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+      for (size_t row = 0; row < rows; ++row) {
+        if (valueIds[row].table == 0)
+          coded.positions[next[valueIds[row].valueId]++] = row;
+      }
+      for (size_t id = 0; id < domain; ++id) {
+        if (offsets[id + 1] > offsets[id]) {
+          coded.values.push_back(static_cast<K>(main->getValueForValueId(id)));
+          coded.offsets.push_back(offsets[id + 1]);
+        }
+      }
+    } else {
+      uncoded.reserve(rows);
+      for (size_t row = 0; row < rows; ++row)
+        uncoded.emplace_back(static_cast<K>(table->getValue<T>(field, row)), row);
+    }
+
+    if (uncoded.empty())
+      return coded;
+
+    std::sort(uncoded.begin(), uncoded.end());
+    sorted_groups_t<K> sorted;
+    sorted.positions.reserve(uncoded.size());
+    for (size_t i = 0; i < uncoded.size(); ++i) {
+      if (i == 0 || uncoded[i - 1].first < uncoded[i].first) {
+        sorted.values.push_back(uncoded[i].first);
+        sorted.offsets.push_back(i);
+      }
+      sorted.positions.push_back(uncoded[i].second);
+    }
+    sorted.offsets.erase(sorted.offsets.begin());
+    sorted.offsets.push_back(uncoded.size());
+    return coded.size() == 0 ? sorted : mergeGroups(coded, sorted);
+  }
+}
+
+void SortMergeJoin::executePlanOperation() {
+  const auto leftType = getInputTable(0)->typeOfColumn(_field_definition[0]);
+  const auto rightType = getInputTable(1)->typeOfColumn(_field_definition[1]);
+  if (!types::isCompatible(leftType, rightType))
+    throw std::runtime_error("SortMergeJoin requires join columns of the same type");
+
+  // Integer columns without a dictionary hold 32 bit values, the others
+  // 64 bit values, both may be joined with each other
+  switch(leftType) {
+  case IntegerType:
+  case IntegerTypeDelta:
+  case IntegerTypeDeltaConcurrent:
+    if (rightType == IntegerNoDictType)
+      return executeJoin<storage::hyrise_int_t, storage::hyrise_int32_t>();
+    return executeJoin<storage::hyrise_int_t>();
+  case IntegerNoDictType:
+    if (rightType != IntegerNoDictType)
+      return executeJoin<storage::hyrise_int32_t, storage::hyrise_int_t>();
+    return executeJoin<storage::hyrise_int32_t>();
+  case FloatType:
+  case FloatTypeDelta:
+  case FloatTypeDeltaConcurrent:
+  case FloatNoDictType:
+    return executeJoin<storage::hyrise_float_t>();
+  case StringType:
+  case StringTypeDelta:
+  case StringTypeDeltaConcurrent:
+    return executeJoin<storage::hyrise_string_t>();
+  }
+}
+
+template<typename L, typename R>
+void SortMergeJoin::executeJoin() {
+  typedef typename std::common_type<L, R>::type K;
+  const auto &leftTable = getInputTable(0);
+  const auto &rightTable = getInputTable(1);
+  const auto left = sortSide<L, K>(leftTable, _field_definition[0]);
+  const auto right = sortSide<R, K>(rightTable, _field_definition[1]);
+
+  // The left keys are split into ranges that start their merge at the
+  // first right key not smaller than their own first key
+  const size_t ranges = std::max<size_t>(1, left.size() / min_range_groups);
+  std::vector<pos_list_t> leftResults(ranges), rightResults(ranges);
+  taskscheduler::parallelFor(ranges, [&] (size_t range) {
+      size_t i = left.size() * range / ranges;
+      const size_t end = left.size() * (range + 1) / ranges;
+      if (i == end)
+        return;
+      size_t j = std::lower_bound(right.values.begin(), right.values.end(), left.values[i]) - right.values.begin();
+      auto &leftResult = leftResults[range];
+      auto &rightResult = rightResults[range];
+      while (i < end && j < right.size()) {
+        if (left.values[i] < right.values[j]) {
+          ++i;
+        } else if (right.values[j] < left.values[i]) {
+          ++j;
+        } else {
+          for (size_t l = left.offsets[i]; l < left.offsets[i + 1]; ++l) {
+            for (size_t r = right.offsets[j]; r < right.offsets[j + 1]; ++r) {
+              leftResult.push_back(left.positions[l]);
+              rightResult.push_back(right.positions[r]);
+            }
+          }
+          ++i;
+          ++j;
+        }
+      }
+    }, 0, _priority);
+
+  size_t matches = 0;
+  for (const auto &result : leftResults)
+    matches += result.size();
+  auto leftPositions = new pos_list_t;
+  auto rightPositions = new pos_list_t;
+  leftPositions->reserve(matches);
+  rightPositions->reserve(matches);
+  for (size_t range = 0; range < ranges; ++range) {
+    leftPositions->insert(leftPositions->end(), leftResults[range].begin(), leftResults[range].end());
+    rightPositions->insert(rightPositions->end(), rightResults[range].begin(), rightResults[range].end());
+  }
+
+  std::vector<storage::atable_ptr_t> parts;
+  parts.push_back(storage::PointerCalculator::create(leftTable, leftPositions));
+  parts.push_back(storage::PointerCalculator::create(rightTable, rightPositions));
+  addResult(std::make_shared<storage::MutableVerticalTable>(parts));
+}
+
+std::shared_ptr<PlanOperation> SortMergeJoin::parse(const Json::Value &data) {
+  return BasicParser<SortMergeJoin>::parse(data);
+}
+
+const std::string SortMergeJoin::vname() {
+  return "SortMergeJoin";
+}
+
+}
+}
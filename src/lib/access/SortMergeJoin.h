@@ -0,0 +1,55 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SORTMERGEJOIN_H_
+#define SRC_LIB_ACCESS_SORTMERGEJOIN_H_
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// The SortMergeJoin performs an equi join of two tables by sorting both
+/// sides on the join key and merging them.
+///
+/// Rows whose value ids refer to an order-preserving main dictionary are
+/// sorted with a counting sort on their value ids, so only the distinct
+/// values that occur are looked up and compared. All other rows, e.g.
+/// those of a delta, are sorted on their values. The merge is split into
+/// key ranges of the left side that are joined in parallel. The result
+/// is a vertical table of the matching left and right rows in key order.
+/// Integer columns with and without a dictionary may be joined with each
+/// other.
+///
+/// {
+///     "operators": {
+///         "left": {
+///             "type": "TableLoad",
+///             "table": "companies",
+///             "filename": "tables/companies.tbl"
+///         },
+///         "right": {
+///             "type": "TableLoad",
+///             "table": "employees",
+///             "filename": "tables/employees.tbl"
+///         },
+///         "join": {
+///             "type": "SortMergeJoin",
+///             "fields" : [0, 1]
+///         }
+///     },
+///     "edges": [["left", "join"], ["right", "join"]]
+/// }
+class SortMergeJoin : public PlanOperation {
+public:
+  void executePlanOperation();
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
+  const std::string vname();
+
+private:
+  template<typename L, typename R = L>
+  void executeJoin();
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_SORTMERGEJOIN_H_
@@ -115,6 +115,7 @@ std::vector<taskscheduler::task_ptr_t> TableScan::applyDynamicParallelization(si
     t->setTXContext(_txContext);
     t->setId(_txContext.tid);
     t->setEvent(_papiEvent);
+    t->setCalibration(_calibration);
 
     // set dependencies equal to current task
     for(auto d : _dependencies)
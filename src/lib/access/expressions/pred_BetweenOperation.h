@@ -11,12 +11,19 @@ template <typename T>
 class BetweenExpression : public SimpleFieldExpression {
  private:
   ValueId lower_bound;
+  // First value id greater than upper_value, only used if the
+  // dictionary is ordered
   ValueId upper_bound;
   T lower_value;
   T upper_value;
   std::shared_ptr<storage::BaseDictionary<T>> valueIdMap;
-  bool lower_value_exists;
-  bool upper_value_exists;
+  // Value id comparisons are only valid on order preserving dictionaries
+  bool ordered;
+
+  inline bool matchesValue(const T& value) const {
+    return (value <= upper_value) && (value >= lower_value);
+  }
+
  public:
 
   BetweenExpression(size_t i, field_t f, T _lower_value, T _upper_value):
@@ -35,13 +42,12 @@ class BetweenExpression : public SimpleFieldExpression {
     SimpleFieldExpression::walk(l);
 
     valueIdMap = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(table->dictionaryAt(field));
+    ordered = valueIdMap->isOrdered();
 
     lower_bound.table = 0;
     lower_bound.valueId = valueIdMap->getValueIdForValue(lower_value);
-    lower_value_exists = valueIdMap->isValueIdValid(lower_bound.valueId) && lower_value == valueIdMap->getValueForValueId(lower_bound.valueId);
     upper_bound.table = 0;
-    upper_bound.valueId = valueIdMap->getValueIdForValue(upper_value);
-    upper_value_exists = valueIdMap->isValueIdValid(upper_bound.valueId) && upper_value == valueIdMap->getValueForValueId(upper_bound.valueId);
+    upper_bound.valueId = ordered ? valueIdMap->getValueIdForValueGreater(upper_value) : 0;
   }
 
 
@@ -50,22 +56,44 @@ class BetweenExpression : public SimpleFieldExpression {
   inline virtual bool operator()(size_t row) {
     ValueId valueId = table->getValueId(field, row);
 
-    if ((valueId.table == lower_bound.table) && (valueId.table == upper_bound.table)) {
-      if ((valueId.valueId <= upper_bound.valueId) && (valueId.valueId >= lower_bound.valueId)) {
-        return true;
-      }
+    if (ordered && valueId.table == lower_bound.table) {
+      return (valueId.valueId >= lower_bound.valueId) && (valueId.valueId < upper_bound.valueId);
+    }
 
-      if ((valueId.valueId > upper_bound.valueId) || (valueId.valueId < lower_bound.valueId)) {
-        return false;
-      }
+    return matchesValue(table->getValueForValueId<T>(field, valueId, row));
+  }
 
-      if (upper_value_exists && lower_value_exists) {
-        return false;
+  virtual void evaluate(const size_t start, const size_t stop, pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::evaluate(start, stop, selection);
+      return;
+    }
+    for (const auto& partition : partitions) {
+      if (ordered && partition.table_id == lower_bound.table) {
+        if (lower_bound.valueId < upper_bound.valueId) {
+          scanValueIdRange(partition, lower_bound.valueId, upper_bound.valueId - 1, start, stop, selection);
+        }
+      } else {
+        auto dict = std::static_pointer_cast<storage::BaseDictionary<T>>(partition.dictionary);
+        scanValueIds(partition, start, stop, selection, [this, &dict] (value_id_t vid) {
+            return matchesValue(dict->getValueForValueId(vid));
+          });
       }
     }
+    evaluateUncovered(start, stop, selection);
+  }
 
-    T value = table->getValue<T>(field, row);
-    return (value <= upper_value) && (value >= lower_value);
+  virtual void refine(pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::refine(selection);
+      return;
+    }
+    refineValueIds(selection, [this] (const partition_t& partition, value_id_t vid) -> bool {
+        if (ordered && partition.table_id == lower_bound.table) {
+          return (vid >= lower_bound.valueId) && (vid < upper_bound.valueId);
+        }
+        return matchesValue(std::static_pointer_cast<storage::BaseDictionary<T>>(partition.dictionary)->getValueForValueId(vid));
+      });
   }
 };
 
@@ -1,6 +1,9 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+
 #include "pred_common.h"
 
 namespace hyrise {
@@ -11,6 +14,21 @@ class CompoundExpression : public SimpleExpression {
 
   ExpressionType type;
 
+  /// Stores all rows in [start, stop) that are not part of the sorted
+  /// list selected in rejected
+  static void complement(const size_t start, const size_t stop,
+                         const pos_list_t& selected, pos_list_t& rejected) {
+    rejected.clear();
+    auto next = selected.begin();
+    for (size_t row = start; row < stop; ++row) {
+      if (next != selected.end() && *next == row) {
+        ++next;
+      } else {
+        rejected.push_back(row);
+      }
+    }
+  }
+
  public:
 
   SimpleExpression *lhs;
@@ -63,6 +81,80 @@ class CompoundExpression : public SimpleExpression {
     }
   }
 
+  /// Evaluates the legs chunk by chunk so that the right leg of an AND
+  /// only sees the rows the left leg selected and the right leg of an
+  /// OR only the rows it rejected
+  virtual void evaluate(const size_t start, const size_t stop, pos_list_t& selection) {
+    pos_list_t selected;
+    pos_list_t rejected;
+    for (size_t chunk = start; chunk < stop; chunk += evaluation_chunk_size) {
+      const size_t chunk_stop = std::min(stop, chunk + evaluation_chunk_size);
+      selected.clear();
+      lhs->evaluate(chunk, chunk_stop, selected);
+
+      switch (type) {
+        case AND:
+          if (!selected.empty()) {
+            rhs->refine(selected);
+            selection.insert(selection.end(), selected.begin(), selected.end());
+          }
+          break;
+
+        case OR:
+          complement(chunk, chunk_stop, selected, rejected);
+          rhs->refine(rejected);
+          std::merge(selected.begin(), selected.end(), rejected.begin(), rejected.end(),
+                     std::back_inserter(selection));
+          break;
+
+        case NOT:
+          complement(chunk, chunk_stop, selected, rejected);
+          selection.insert(selection.end(), rejected.begin(), rejected.end());
+          break;
+
+        default:
+          throw std::runtime_error("Unknown Expression Type");
+      }
+    }
+  }
+
+  virtual void refine(pos_list_t& selection) {
+    switch (type) {
+      case AND:
+        lhs->refine(selection);
+        if (!selection.empty()) {
+          rhs->refine(selection);
+        }
+        break;
+
+      case OR: {
+        pos_list_t selected(selection);
+        lhs->refine(selected);
+        pos_list_t rejected;
+        std::set_difference(selection.begin(), selection.end(), selected.begin(), selected.end(),
+                            std::back_inserter(rejected));
+        rhs->refine(rejected);
+        selection.clear();
+        std::merge(selected.begin(), selected.end(), rejected.begin(), rejected.end(),
+                   std::back_inserter(selection));
+        break;
+      }
+
+      case NOT: {
+        pos_list_t selected(selection);
+        lhs->refine(selected);
+        pos_list_t rejected;
+        std::set_difference(selection.begin(), selection.end(), selected.begin(), selected.end(),
+                            std::back_inserter(rejected));
+        selection.swap(rejected);
+        break;
+      }
+
+      default:
+        throw std::runtime_error("Unknown Expression Type");
+    }
+  }
+
   inline void add(SimpleExpression *e) {
     if (!lhs) lhs = e;
     else if (!rhs) rhs = e;
@@ -54,6 +54,36 @@ class EqualsExpression : public SimpleFieldExpression {
   inline virtual bool operator()(size_t row) {
     return value_exists && table->getValueId(field, row) == lower_bound;
   }
+
+  virtual void evaluate(const size_t start, const size_t stop, pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::evaluate(start, stop, selection);
+      return;
+    }
+    if (!value_exists) {
+      return;
+    }
+    for (const auto& partition : partitions) {
+      if (partition.table_id == lower_bound.table) {
+        scanValueIdRange(partition, lower_bound.valueId, lower_bound.valueId, start, stop, selection);
+      }
+    }
+    evaluateUncovered(start, stop, selection);
+  }
+
+  virtual void refine(pos_list_t& selection) {
+    if (!value_exists) {
+      selection.clear();
+      return;
+    }
+    if (partitions.empty()) {
+      SimpleFieldExpression::refine(selection);
+      return;
+    }
+    refineValueIds(selection, [this] (const partition_t& partition, value_id_t vid) {
+        return partition.table_id == lower_bound.table && vid == lower_bound.valueId;
+      });
+  }
 };
 
 
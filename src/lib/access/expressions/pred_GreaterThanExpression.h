@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <limits>
+
 #include "pred_common.h"
 
 namespace hyrise {
@@ -58,6 +60,38 @@ class GreaterThanExpression : public SimpleFieldExpression {
 
     return table->getValue<T>(field, row) > value;
   }
+
+  virtual void evaluate(const size_t start, const size_t stop, pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::evaluate(start, stop, selection);
+      return;
+    }
+    for (const auto& partition : partitions) {
+      if (partition.table_id == lower_bound.table) {
+        scanValueIdRange(partition, lower_bound.valueId + (value_exists ? 1 : 0),
+                         std::numeric_limits<value_id_t>::max(), start, stop, selection);
+      } else {
+        auto dict = std::static_pointer_cast<storage::BaseDictionary<T>>(partition.dictionary);
+        scanValueIds(partition, start, stop, selection, [this, &dict] (value_id_t vid) {
+            return dict->getValueForValueId(vid) > value;
+          });
+      }
+    }
+    evaluateUncovered(start, stop, selection);
+  }
+
+  virtual void refine(pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::refine(selection);
+      return;
+    }
+    refineValueIds(selection, [this] (const partition_t& partition, value_id_t vid) -> bool {
+        if (partition.table_id == lower_bound.table) {
+          return vid > lower_bound.valueId || (vid == lower_bound.valueId && !value_exists);
+        }
+        return std::static_pointer_cast<storage::BaseDictionary<T>>(partition.dictionary)->getValueForValueId(vid) > value;
+      });
+  }
 };
 
 
@@ -46,6 +46,29 @@ class LessThanExpression : public SimpleFieldExpression {
     } else
       return false;
   }
+
+  virtual void evaluate(const size_t start, const size_t stop, pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::evaluate(start, stop, selection);
+      return;
+    }
+    if (lower_bound.valueId > 0) {
+      for (const auto& partition : partitions) {
+        scanValueIdRange(partition, 0, lower_bound.valueId - 1, start, stop, selection);
+      }
+    }
+    evaluateUncovered(start, stop, selection);
+  }
+
+  virtual void refine(pos_list_t& selection) {
+    if (partitions.empty()) {
+      SimpleFieldExpression::refine(selection);
+      return;
+    }
+    refineValueIds(selection, [this] (const partition_t&, value_id_t vid) {
+        return vid < lower_bound.valueId;
+      });
+  }
 };
 
 
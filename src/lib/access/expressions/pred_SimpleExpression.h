@@ -8,23 +8,47 @@
 namespace hyrise {
 namespace access {
 
+/// Number of rows evaluated at once when an expression processes a
+/// range in chunks, sized to keep the value id buffers in L1
+static const size_t evaluation_chunk_size = 1024;
+
 class SimpleExpression : public access::AbstractExpression {
  public:
   virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) = 0;
 
   virtual pos_list_t* match(const size_t start, const size_t stop) {
     auto pl = new pos_list_t;
-    for(size_t row=0; row < stop; ++row) {
-      if (operator()(row)) {
-        pl->push_back(row);
-      }
-    }
+    evaluate(start, stop, *pl);
     return pl;
   }
 
   inline virtual bool operator()(size_t row) {
     throw std::runtime_error("Cannot call base class");
   }
+
+  /// Appends all rows in [start, stop) that satisfy the expression to
+  /// selection in ascending order. Derived expressions override this
+  /// with tight loops over the underlying partitions, the default
+  /// evaluates operator() row by row.
+  virtual void evaluate(const size_t start, const size_t stop, pos_list_t& selection) {
+    for (size_t row = start; row < stop; ++row) {
+      if (operator()(row)) {
+        selection.push_back(row);
+      }
+    }
+  }
+
+  /// Removes all rows from selection that do not satisfy the
+  /// expression, keeping the order of the remaining rows.
+  virtual void refine(pos_list_t& selection) {
+    size_t matches = 0;
+    for (const auto& row : selection) {
+      if (operator()(row)) {
+        selection[matches++] = row;
+      }
+    }
+    selection.resize(matches);
+  }
 };
 
 } } // namespace hyrise::access
@@ -4,6 +4,11 @@
 #include "helper/types.h"
 #include "pred_common.h"
 
+#include "storage/BitCompressedVector.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/ZoneMap.h"
+
 namespace hyrise {
 namespace access {
 
@@ -13,6 +18,180 @@ class SimpleFieldExpression : public SimpleExpression {
   field_t field;
   field_name_t field_name;
   size_t input;
+
+  // A horizontal partition of the input (the main or delta of a Store
+  // or a plain table) with direct access to the attribute vector of field
+  struct partition_t {
+    std::shared_ptr<storage::BaseAttributeVector<value_id_t>> vector;
+    // Set if vector is bit-compressed, enables the block scan kernels
+    std::shared_ptr<storage::BitCompressedVector<value_id_t>> compressed;
+    storage::AbstractTable::SharedDictionaryPtr dictionary;
+    // Set if the partition maintains a zone map for field
+    std::shared_ptr<storage::ZoneMap> zone_map;
+    // Column of field inside vector
+    size_t column;
+    // First row of the partition in the input
+    size_t offset;
+    size_t size;
+    // Table id of the value ids that getValueId reports for this partition
+    table_id_t table_id;
+  };
+
+  // Partitions of the input determined by walk(), empty if the input
+  // does not expose its attribute vectors
+  std::vector<partition_t> partitions;
+  // Number of input rows covered by partitions
+  size_t partitioned_rows = 0;
+
+  void findPartitions() {
+    partitions.clear();
+    partitioned_rows = 0;
+
+    // Parts in row order, paired with the table id getValueId reports
+    std::vector<std::pair<storage::c_atable_ptr_t, table_id_t>> parts { {table, 0} };
+    if (auto store = std::dynamic_pointer_cast<const storage::Store>(table)) {
+      parts = { {store->getMainTable(), 0} };
+      if (auto frozen = store->getFrozenDeltaTable()) {
+        parts.emplace_back(frozen, 2);
+      }
+      parts.emplace_back(store->getDeltaTable(), 1);
+    }
+
+    for (const auto& entry : parts) {
+      const auto& part = entry.first;
+      if (!std::dynamic_pointer_cast<const storage::Table>(part) &&
+          !std::dynamic_pointer_cast<const storage::MutableVerticalTable>(part)) {
+        partitions.clear();
+        partitioned_rows = 0;
+        return;
+      }
+      const auto& avs = part->getAttributeVectors(field);
+      partition_t partition;
+      partition.vector = std::dynamic_pointer_cast<storage::BaseAttributeVector<value_id_t>>(avs.at(0).attribute_vector);
+      partition.compressed = std::dynamic_pointer_cast<storage::BitCompressedVector<value_id_t>>(partition.vector);
+      partition.dictionary = part->dictionaryAt(field);
+      partition.zone_map = part->zoneMapAt(field);
+      partition.column = avs.at(0).attribute_offset;
+      partition.offset = partitioned_rows;
+      partition.size = part->size();
+      partition.table_id = entry.second;
+      partitions.push_back(partition);
+      partitioned_rows += partition.size;
+    }
+  }
+
+  const partition_t& partitionFor(size_t row) const {
+    for (const auto& partition : partitions) {
+      if (row < partition.offset + partition.size) {
+        return partition;
+      }
+    }
+    throw std::out_of_range("Row " + std::to_string(row) + " is not covered by a partition");
+  }
+
+  /// Appends the rows of partition within [start, stop) whose value id
+  /// satisfies predicate to selection, decoding chunk by chunk
+  template <typename Predicate>
+  void scanValueIds(const partition_t& partition, const size_t start, const size_t stop,
+                    pos_list_t& selection, Predicate predicate) const {
+    const size_t begin = std::max(start, partition.offset);
+    const size_t end = std::min(stop, partition.offset + partition.size);
+
+    value_id_t buffer[evaluation_chunk_size];
+    for (size_t chunk = begin; chunk < end; chunk += evaluation_chunk_size) {
+      const size_t count = std::min(evaluation_chunk_size, end - chunk);
+      const size_t local = chunk - partition.offset;
+      if (partition.compressed) {
+        partition.compressed->decodeRange(partition.column, local, local + count, buffer);
+      } else {
+        for (size_t i = 0; i < count; ++i) {
+          buffer[i] = partition.vector->get(partition.column, local + i);
+        }
+      }
+
+      const size_t written = selection.size();
+      selection.resize(written + count);
+      pos_t* out = selection.data() + written;
+      size_t matches = 0;
+      for (size_t i = 0; i < count; ++i) {
+        out[matches] = chunk + i;
+        matches += predicate(buffer[i]);
+      }
+      selection.resize(written + matches);
+    }
+  }
+
+  /// Appends the rows of partition within [start, stop) whose value id
+  /// lies in [low, high] to selection, skipping blocks that the zone map
+  /// of the partition rules out
+  void scanValueIdRange(const partition_t& partition, const value_id_t low, const value_id_t high,
+                        const size_t start, const size_t stop, pos_list_t& selection) const {
+    const size_t begin = std::max(start, partition.offset);
+    const size_t end = std::min(stop, partition.offset + partition.size);
+    if (low > high || begin >= end) {
+      return;
+    }
+    if (partition.zone_map) {
+      partition.zone_map->forEachCandidate(begin - partition.offset, end - partition.offset, low, high,
+                                           [&] (size_t candidate_begin, size_t candidate_end) {
+        scanValueIdCandidates(partition, low, high, candidate_begin + partition.offset,
+                              candidate_end + partition.offset, selection);
+      });
+    } else {
+      scanValueIdCandidates(partition, low, high, begin, end, selection);
+    }
+  }
+
+  /// Appends the rows in [begin, end), which must lie inside partition,
+  /// whose value id lies in [low, high] to selection
+  void scanValueIdCandidates(const partition_t& partition, const value_id_t low, const value_id_t high,
+                             const size_t begin, const size_t end, pos_list_t& selection) const {
+    if (partition.compressed) {
+      const size_t written = selection.size();
+      partition.compressed->scanBetween(partition.column, low, high,
+                                        begin - partition.offset, end - partition.offset, selection);
+      if (partition.offset > 0) {
+        for (size_t i = written; i < selection.size(); ++i) {
+          selection[i] += partition.offset;
+        }
+      }
+    } else {
+      const value_id_t range = high - low;
+      scanValueIds(partition, begin, end, selection, [low, range] (value_id_t vid) {
+          return static_cast<value_id_t>(vid - low) <= range;
+        });
+    }
+  }
+
+  /// Evaluates the rows in [start, stop) that were added to the input
+  /// after walk() and are thus not covered by partitions
+  void evaluateUncovered(const size_t start, const size_t stop, pos_list_t& selection) {
+    for (size_t row = std::max(start, partitioned_rows); row < stop; ++row) {
+      if (operator()(row)) {
+        selection.push_back(row);
+      }
+    }
+  }
+
+  /// Removes the rows from selection for which predicate(partition,
+  /// value id) does not hold
+  template <typename Predicate>
+  void refineValueIds(pos_list_t& selection, Predicate predicate) {
+    size_t matches = 0;
+    for (const auto& row : selection) {
+      bool match;
+      if (row < partitioned_rows) {
+        const auto& partition = partitionFor(row);
+        match = predicate(partition, partition.vector->get(partition.column, row - partition.offset));
+      } else {
+        match = operator()(row);
+      }
+      selection[matches] = row;
+      matches += match;
+    }
+    selection.resize(matches);
+  }
+
  public:
 
   SimpleFieldExpression(size_t input_index, field_t field_index): field(field_index),
@@ -42,6 +221,8 @@ class SimpleFieldExpression : public SimpleExpression {
     if ((field == 0) && (field_name.size() > 0)) {
       field = table->numberOfColumn(field_name);
     }
+
+    findPartitions();
   }
 
   inline virtual bool operator()(size_t row) {
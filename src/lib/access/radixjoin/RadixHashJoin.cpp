@@ -0,0 +1,306 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "RadixHashJoin.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include "access/system/BasicParser.h"
+#include "access/system/QueryParser.h"
+
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "taskscheduler/ParallelFor.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerPlanOperation<RadixHashJoin>("RadixHashJoin");
+
+  // Partitions of the build side are sized to half of the L2 cache, the
+  // other half is left for the partition's hash table and the probe tuples
+  const size_t l2_cache_bytes = 256 * 1024;
+  // Fan-out per pass is bounded by the TLB entries and the write-combining
+  // buffers that stay cached during a scatter
+  const uint32_t max_pass_bits = 10;
+  const size_t tuples_per_line = 64 / sizeof(radix_tuple_t);
+  const size_t chunk_rows = 64 * 1024;
+  const uint32_t no_tuple = std::numeric_limits<uint32_t>::max();
+
+  // Finalizer of MurmurHash3, spreads std::hash of integers, which is the
+  // identity, over the low order bits used for the partitioning
+  inline uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  void histogram(const radix_tuple_t *begin, const radix_tuple_t *end,
+                 uint32_t shift, uint64_t mask, size_t *counts) {
+    for (auto tuple = begin; tuple != end; ++tuple) {
+      ++counts[(tuple->hash >> shift) & mask];
+    }
+  }
+
+  // Scatters [begin, end) to out starting at the given partition offsets,
+  // which are advanced. Tuples are collected in a cache line per partition
+  // that is written out as a whole once it is full.
+  void scatter(const radix_tuple_t *begin, const radix_tuple_t *end,
+               uint32_t shift, uint64_t mask, radix_tuple_t *out, size_t *offsets) {
+    const size_t partitions = mask + 1;
+    std::vector<radix_tuple_t> lines(partitions * tuples_per_line);
+    std::vector<uint8_t> fill(partitions, 0);
+    for (auto tuple = begin; tuple != end; ++tuple) {
+      const size_t p = (tuple->hash >> shift) & mask;
+      radix_tuple_t *line = &lines[p * tuples_per_line];
+      line[fill[p]++] = *tuple;
+      if (fill[p] == tuples_per_line) {
+        std::memcpy(out + offsets[p], line, sizeof(radix_tuple_t) * tuples_per_line);
+        offsets[p] += tuples_per_line;
+        fill[p] = 0;
+      }
+    }
+    for (size_t p = 0; p < partitions; ++p) {
+      std::memcpy(out + offsets[p], &lines[p * tuples_per_line], sizeof(radix_tuple_t) * fill[p]);
+      offsets[p] += fill[p];
+    }
+  }
+
+  // Hashes the values of type T as key type K, so that both sides of a
+  // join of different integer widths agree on the hashes
+  template<typename T, typename K>
+  std::vector<radix_tuple_t> hashRows(const storage::c_atable_ptr_t &table, const field_t field, size_t parallelism) {
+    const size_t rows = table->size();
+    std::vector<radix_tuple_t> tuples(rows);
+    taskscheduler::parallelFor((rows + chunk_rows - 1) / chunk_rows, [&] (size_t chunk) {
+        const std::hash<K> hasher;
+        for (size_t row = chunk * chunk_rows, end = std::min(rows, row + chunk_rows); row < end; ++row) {
+          tuples[row].hash = mix(hasher(static_cast<K>(table->getValue<T>(field, row))));
+          tuples[row].pos = row;
+        }
+      }, parallelism);
+    return tuples;
+  }
+
+  // Joins one partition of both sides with a bucket-chained hash table on
+  // the build tuples, keys of hash matches are compared as K before
+  // emitting
+  template<typename P, typename B, typename K>
+  void joinPartition(const storage::c_atable_ptr_t &probe, const field_t probeField,
+                     const radix_tuple_t *probeTuples, size_t probeCount,
+                     const storage::c_atable_ptr_t &build, const field_t buildField,
+                     const radix_tuple_t *buildTuples, size_t buildCount,
+                     uint32_t shift, pos_list_t &probeResult, pos_list_t &buildResult) {
+    if (probeCount == 0 || buildCount == 0)
+      return;
+
+    size_t buckets = 1;
+    while (buckets < buildCount)
+      buckets <<= 1;
+    const uint64_t mask = buckets - 1;
+
+    // chains are built back to front so that they list the build rows in
+    // ascending order
+    std::vector<uint32_t> head(buckets, no_tuple), next(buildCount);
+    std::vector<K> keys(buildCount);
+    for (size_t i = buildCount; i-- > 0;) {
+      const size_t bucket = (buildTuples[i].hash >> shift) & mask;
+      keys[i] = static_cast<K>(build->getValue<B>(buildField, buildTuples[i].pos));
+      next[i] = head[bucket];
+      head[bucket] = i;
+    }
+
+    for (size_t j = 0; j < probeCount; ++j) {
+      const radix_tuple_t &tuple = probeTuples[j];
+      bool fetched = false;
+      K key;
+      for (uint32_t i = head[(tuple.hash >> shift) & mask]; i != no_tuple; i = next[i]) {
+        if (buildTuples[i].hash != tuple.hash)
+          continue;
+        if (!fetched) {
+          key = static_cast<K>(probe->getValue<P>(probeField, tuple.pos));
+          fetched = true;
+        }
+        if (keys[i] == key) {
+          probeResult.push_back(tuple.pos);
+          buildResult.push_back(buildTuples[i].pos);
+        }
+      }
+    }
+  }
+}
+
+std::vector<size_t> radixPartition(std::vector<radix_tuple_t> &tuples, uint32_t bits1, uint32_t bits2, size_t parallelism) {
+  const size_t rows = tuples.size();
+  const size_t fanout1 = size_t(1) << bits1;
+  const uint64_t mask1 = fanout1 - 1;
+  std::vector<radix_tuple_t> out(rows);
+
+  // First pass: every chunk scatters into its own slice of each partition
+  const size_t chunks = std::max<size_t>(1, (rows + chunk_rows - 1) / chunk_rows);
+  std::vector<size_t> offsets(chunks * fanout1, 0);
+  taskscheduler::parallelFor(chunks, [&] (size_t chunk) {
+      const size_t begin = chunk * chunk_rows, end = std::min(rows, begin + chunk_rows);
+      histogram(tuples.data() + begin, tuples.data() + end, 0, mask1, &offsets[chunk * fanout1]);
+    }, parallelism);
+
+  std::vector<size_t> bounds(fanout1 + 1);
+  size_t sum = 0;
+  for (size_t p = 0; p < fanout1; ++p) {
+    bounds[p] = sum;
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+      const size_t count = offsets[chunk * fanout1 + p];
+      offsets[chunk * fanout1 + p] = sum;
+      sum += count;
+    }
+  }
+  bounds[fanout1] = rows;
+
+  taskscheduler::parallelFor(chunks, [&] (size_t chunk) {
+      const size_t begin = chunk * chunk_rows, end = std::min(rows, begin + chunk_rows);
+      scatter(tuples.data() + begin, tuples.data() + end, 0, mask1, out.data(), &offsets[chunk * fanout1]);
+    }, parallelism);
+  tuples.swap(out);
+
+  if (bits2 == 0)
+    return bounds;
+
+  // Second pass: every partition of the first pass is split on its own
+  const size_t fanout2 = size_t(1) << bits2;
+  const uint64_t mask2 = fanout2 - 1;
+  std::vector<size_t> bounds2(fanout1 * fanout2 + 1);
+  taskscheduler::parallelFor(fanout1, [&] (size_t p) {
+      const radix_tuple_t *begin = tuples.data() + bounds[p], *end = tuples.data() + bounds[p + 1];
+      std::vector<size_t> counts(fanout2, 0);
+      histogram(begin, end, bits1, mask2, counts.data());
+      size_t offset = bounds[p];
+      for (size_t q = 0; q < fanout2; ++q) {
+        bounds2[p * fanout2 + q] = offset;
+        offset += counts[q];
+        counts[q] = bounds2[p * fanout2 + q];
+      }
+      scatter(begin, end, bits1, mask2, out.data(), counts.data());
+    }, parallelism);
+  bounds2[fanout1 * fanout2] = rows;
+  tuples.swap(out);
+  return bounds2;
+}
+
+void RadixHashJoin::executePlanOperation() {
+  const auto probeType = getInputTable(0)->typeOfColumn(_field_definition[0]);
+  const auto buildType = getInputTable(1)->typeOfColumn(_field_definition[1]);
+  if (!types::isCompatible(probeType, buildType))
+    throw std::runtime_error("RadixHashJoin requires join columns of the same type");
+
+  // Integer columns without a dictionary hold 32 bit values, the others
+  // 64 bit values, both may be joined with each other
+  switch(probeType) {
+  case IntegerType:
+  case IntegerTypeDelta:
+  case IntegerTypeDeltaConcurrent:
+    if (buildType == IntegerNoDictType)
+      return executeJoin<storage::hyrise_int_t, storage::hyrise_int32_t>();
+    return executeJoin<storage::hyrise_int_t>();
+  case IntegerNoDictType:
+    if (buildType != IntegerNoDictType)
+      return executeJoin<storage::hyrise_int32_t, storage::hyrise_int_t>();
+    return executeJoin<storage::hyrise_int32_t>();
+  case FloatType:
+  case FloatTypeDelta:
+  case FloatTypeDeltaConcurrent:
+  case FloatNoDictType:
+    return executeJoin<storage::hyrise_float_t>();
+  case StringType:
+  case StringTypeDelta:
+  case StringTypeDeltaConcurrent:
+    return executeJoin<storage::hyrise_string_t>();
+  }
+}
+
+template<typename P, typename B>
+void RadixHashJoin::executeJoin() {
+  typedef typename std::common_type<P, B>::type K;
+  const auto &probe = getInputTable(0);
+  const auto &build = getInputTable(1);
+  const field_t probeField = _field_definition[0], buildField = _field_definition[1];
+
+  auto probeTuples = hashRows<P, K>(probe, probeField, _parallelism);
+  auto buildTuples = hashRows<B, K>(build, buildField, _parallelism);
+
+  uint32_t bits1 = _bits1, bits2 = _bits2;
+  if (bits1 == 0) {
+    uint32_t bits = 0;
+    while ((l2_cache_bytes / 2 << bits) < buildTuples.size() * sizeof(radix_tuple_t))
+      ++bits;
+    bits1 = std::min(bits, max_pass_bits);
+    bits2 = std::min(bits - bits1, max_pass_bits);
+  }
+
+  const auto probeBounds = radixPartition(probeTuples, bits1, bits2, _parallelism);
+  const auto buildBounds = radixPartition(buildTuples, bits1, bits2, _parallelism);
+  const size_t partitions = probeBounds.size() - 1;
+
+  std::vector<pos_list_t> probeResults(partitions), buildResults(partitions);
+  taskscheduler::parallelFor(partitions, [&] (size_t p) {
+      joinPartition<P, B, K>(probe, probeField, probeTuples.data() + probeBounds[p], probeBounds[p + 1] - probeBounds[p],
+                             build, buildField, buildTuples.data() + buildBounds[p], buildBounds[p + 1] - buildBounds[p],
+                             bits1 + bits2, probeResults[p], buildResults[p]);
+    }, _parallelism, _priority);
+
+  size_t matches = 0;
+  for (const auto &result : probeResults)
+    matches += result.size();
+  auto probePositions = new pos_list_t;
+  auto buildPositions = new pos_list_t;
+  probePositions->reserve(matches);
+  buildPositions->reserve(matches);
+  for (size_t p = 0; p < partitions; ++p) {
+    probePositions->insert(probePositions->end(), probeResults[p].begin(), probeResults[p].end());
+    buildPositions->insert(buildPositions->end(), buildResults[p].begin(), buildResults[p].end());
+  }
+
+  std::vector<storage::atable_ptr_t> vc;
+  vc.push_back(storage::PointerCalculator::create(probe, probePositions));
+  vc.push_back(storage::PointerCalculator::create(build, buildPositions));
+  addResult(std::make_shared<storage::MutableVerticalTable>(vc));
+}
+
+std::shared_ptr<PlanOperation> RadixHashJoin::parse(const Json::Value &data) {
+  auto instance = BasicParser<RadixHashJoin>::parse(data);
+  instance->setBits1(data["bits1"].asUInt());
+  instance->setBits2(data["bits2"].asUInt());
+  return instance;
+}
+
+const std::string RadixHashJoin::vname() {
+  return "RadixHashJoin";
+}
+
+void RadixHashJoin::setBits1(const uint32_t b) {
+  _bits1 = b;
+}
+
+void RadixHashJoin::setBits2(const uint32_t b) {
+  _bits2 = b;
+}
+
+uint32_t RadixHashJoin::bits1() const {
+  return _bits1;
+}
+
+uint32_t RadixHashJoin::bits2() const {
+  return _bits2;
+}
+
+void RadixHashJoin::setParallelism(const size_t parallelism) {
+  _parallelism = parallelism;
+}
+
+}
+}
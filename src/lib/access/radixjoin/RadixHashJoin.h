@@ -0,0 +1,71 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_RADIXHASHJOIN_H_
+#define SRC_LIB_ACCESS_RADIXHASHJOIN_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Hash and position of a row as it is moved through the radix passes
+struct radix_tuple_t {
+  uint64_t hash;
+  pos_t pos;
+};
+
+/// Partitions tuples on bits1 + bits2 low order bits of their hashes in
+/// one or two passes and returns the partition boundaries, partition p
+/// spans [bounds[p], bounds[p + 1]). Scatters go through write-combining
+/// buffers of one cache line per partition. Uses up to parallelism
+/// helper tasks, 0 uses one per worker.
+std::vector<size_t> radixPartition(std::vector<radix_tuple_t> &tuples, uint32_t bits1, uint32_t bits2,
+                                   size_t parallelism = 0);
+
+/// This is a self-contained radix hash join on contiguous (hash, pos)
+/// tuple buffers. Both inputs are partitioned on the low order bits of a
+/// 64 bit hash of the join key so that a partition of the build side fits
+/// into L2, then every partition is joined with a small bucket-chained
+/// hash table on the next bits of the hash. Hash matches are verified
+/// against the actual key values.
+///
+/// The following input tables are expected:
+/// input table 0: probe table
+/// input table 1: build table
+///
+/// The fields list the probe and the build column, the result is a
+/// vertical table of the matching probe and build rows. The number of
+/// radix bits is derived from the size of the build table unless it is
+/// given as bits1 (and bits2 for a second pass).
+///
+/// Integer columns with and without a dictionary may be joined with each
+/// other. RadixJoinTransformation and the dynamic parallelization of
+/// RadixJoin rewrite a RadixJoin into this operation.
+class RadixHashJoin : public PlanOperation {
+public:
+  void executePlanOperation();
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
+  const std::string vname();
+  void setBits1(const uint32_t b);
+  void setBits2(const uint32_t b);
+  uint32_t bits1() const;
+  uint32_t bits2() const;
+  /// Number of helper tasks the phases of the join are run with, 0 uses
+  /// one per worker
+  void setParallelism(const size_t parallelism);
+
+private:
+  template<typename P, typename B = P>
+  void executeJoin();
+
+  uint32_t _bits1 = 0;
+  uint32_t _bits2 = 0;
+  size_t _parallelism = 0;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_RADIXHASHJOIN_H_
@@ -7,6 +7,7 @@
 #include <helper/vector_helpers.h>
 #include <helper/stringhelpers.h>
 
+#include <io/RedoLog.h>
 #include <io/TransactionManager.h>
 
 #include <storage/storage_types.h>
@@ -126,7 +127,7 @@ void JsonTable::executePlanOperation() {
 			std::dynamic_pointer_cast<storage::Store>(result)->commitPositions(pl,tx::UNKNOWN_CID, true);
 			
 			if (_mergeFlag)
-				std::dynamic_pointer_cast<storage::Store>(result)->merge();
+				tx::RedoLog::getInstance().merge(std::dynamic_pointer_cast<storage::Store>(result));
 		}
 	}
 
@@ -4,9 +4,11 @@
 
 #include <io/CSVLoader.h>
 #include <io/EmptyLoader.h>
+#include <io/BinaryTableDump.h>
 #include <io/Loader.h>
 #include <io/shortcuts.h>
 #include <io/TableDump.h>
+#include <io/RedoLog.h>
 
 #include <storage/Store.h>
 
@@ -23,11 +25,27 @@ void DumpTable::executePlanOperation() {
 
   const auto& c_tab = checked_pointer_cast<const storage::Store>(getInputTable(0));
 
-  // First merge to avoid trouble
+  // First merge to avoid trouble, the merged main contains exactly the
+  // redo records up to the merge record. Commits and merges may resume
+  // afterwards, so the dump is taken of this main and not of the store.
   const auto& tab = std::const_pointer_cast<storage::Store>(c_tab);
-  tab->merge();
-  storage::SimpleTableDump dump(Settings::getInstance()->getDBPath());
-  dump.dump(_name, tab);
+  auto& log = tx::RedoLog::getInstance();
+  storage::atable_ptr_t main;
+  const auto lsn = log.merge(tab, nullptr, &main);
+  const auto logName = log.tableName(tab);
+  const auto snapshot = std::make_shared<storage::Store>(main);
+  // A checkpoint must not be ahead of the log it is replayed from
+  log.waitForDurable(lsn);
+
+  if (_binary) {
+    storage::BinaryTableDump dump(Settings::getInstance()->getDBPath());
+    dump.dump(_name, snapshot, lsn, logName);
+  } else {
+    storage::SimpleTableDump dump(Settings::getInstance()->getDBPath());
+    dump.dump(_name, snapshot, lsn, logName);
+  }
+  // Records the checkpoint contains may be dropped from the log
+  log.checkpointed(logName, lsn);
 
   // No Output here
 }
@@ -35,10 +53,18 @@ void DumpTable::executePlanOperation() {
 std::shared_ptr<PlanOperation> DumpTable::parse(const Json::Value& data) {
   const auto& pop = std::make_shared<DumpTable>();
   pop->_name = data["name"].asString(); 
+  pop->_binary = data.get("binary", false).asBool();
   return pop;
 }
 
 void LoadDumpedTable::executePlanOperation() {
+  if (_binary) {
+    // The checkpoint carries its own schema and is adopted as is
+    io::BinaryDumpLoader input(Settings::getInstance()->getDBPath(), _name);
+    addResult(checked_pointer_cast<storage::Store>(io::Loader::load(io::Loader::params().setInput(input))));
+    return;
+  }
+
   io::TableDumpLoader input(Settings::getInstance()->getDBPath(), _name);
   io::CSVHeader header(Settings::getInstance()->getDBPath() + "/" + _name + "/header.dat", io::CSVHeader::params().setCSVParams(io::csv::HYRISE_FORMAT));
 
@@ -49,6 +75,7 @@ void LoadDumpedTable::executePlanOperation() {
 std::shared_ptr<PlanOperation> LoadDumpedTable::parse(const Json::Value& data) {
   const auto& pop = std::make_shared<LoadDumpedTable>();
   pop->_name = data["name"].asString();
+  pop->_binary = data.get("binary", false).asBool();
   return pop;
 }
 
@@ -10,6 +10,7 @@ namespace access {
 class DumpTable : public PlanOperation {
 
   std::string _name;
+  bool _binary = false;
 
 public:
   virtual ~DumpTable() = default;
@@ -22,6 +23,7 @@ public:
 class LoadDumpedTable : public PlanOperation {
 
   std::string _name;
+  bool _binary = false;
 
 public:
   virtual ~LoadDumpedTable() = default;
@@ -6,6 +6,7 @@
 #include "io/loaders.h"
 #include "io/shortcuts.h"
 #include "io/StorageManager.h"
+#include "storage/AbstractTable.h"
 
 #include "log4cxx/logger.h"
 
@@ -20,7 +21,8 @@ namespace {
 TableLoad::TableLoad(): _hasDelimiter(false),
                         _binary(false),
                         _unsafe(false),
-                        _raw(false) {
+                        _raw(false),
+                        _numaNode(storage::AbstractTable::NO_NUMA_NODE) {
 }
 
 TableLoad::~TableLoad() {
@@ -58,6 +60,9 @@ void TableLoad::executePlanOperation() {
       sm->loadTable(_table_name, p);
     }
 
+    if (_numaNode != storage::AbstractTable::NO_NUMA_NODE && sm->exists(_table_name))
+      sm->getTable(_table_name)->placeOnNode(_numaNode);
+
     // We don't load unless the necessary prerequisites are met,
     // let StorageManager error if table does not exist
   } else {
@@ -79,6 +84,9 @@ std::shared_ptr<PlanOperation> TableLoad::parse(const Json::Value &data) {
   if (data.isMember("delimiter")) {
     s->setDelimiter(data["delimiter"].asString());
   }
+  if (data.isMember("numa_node")) {
+    s->setNumaNode(data["numa_node"].asInt());
+  }
   return s;
 }
 
@@ -119,5 +127,9 @@ void TableLoad::setDelimiter(const std::string &d) {
   _hasDelimiter = true;
 }
 
+void TableLoad::setNumaNode(const int node) {
+  _numaNode = node;
+}
+
 }
 }
@@ -29,6 +29,8 @@ public:
   void setUnsafe(const bool unsafe);
   void setRaw(const bool raw);
   void setDelimiter(const std::string &d);
+  // node the attribute vectors of a freshly loaded table are placed on
+  void setNumaNode(const int node);
 
 private:
   std::string _table_name;
@@ -40,6 +42,7 @@ private:
   bool _binary;
   bool _unsafe;
   bool _raw;
+  int _numaNode;
 };
 
 }
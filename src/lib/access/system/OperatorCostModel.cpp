@@ -0,0 +1,101 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/OperatorCostModel.h"
+
+#include <cmath>
+
+namespace hyrise {
+namespace access {
+
+namespace {
+// the model works on runtimes per 100k rows like the static coefficients
+const double rowsPerUnit = 100000.0;
+// share of the prior weight that pulls the estimate towards the scale of
+// the static coefficients, the rest keeps the ratio of a and b
+const double scalePriorShare = 0.01;
+}
+
+OperatorCostModel::OperatorCostModel(double decay, double priorWeight) : _decay(decay), _priorWeight(priorWeight) {}
+
+void OperatorCostModel::record(size_t tableSize, size_t instances, double runtime) {
+  if (instances == 0 || tableSize < MIN_TABLE_SIZE)
+    return;
+  const double u = 1.0 / instances;
+  const double y = runtime / (tableSize / rowsPerUnit);
+  std::lock_guard<std::mutex> lk(_mutex);
+  _w = _decay * _w + 1;
+  _u = _decay * _u + u;
+  _y = _decay * _y + y;
+  _uu = _decay * _uu + u * u;
+  _uy = _decay * _uy + u * y;
+}
+
+void OperatorCostModel::estimate(size_t tableSize, double priorA, double priorB, double &a, double &b) const {
+  a = priorA;
+  b = priorB;
+  if (tableSize == 0)
+    return;
+  const double units = tableSize / rowsPerUnit;
+  const double a0 = priorA / units;
+  const double b0 = priorB / units;
+
+  // ridge penalty P: strong across the direction of the prior, weak along
+  // it, so scarce samples rescale the static model rather than reshape it
+  double p11 = _priorWeight, p12 = 0, p22 = _priorWeight;
+  const double norm = std::sqrt(a0 * a0 + b0 * b0);
+  if (norm > 0) {
+    const double n1 = a0 / norm, n2 = b0 / norm;
+    const double d = _priorWeight * scalePriorShare - _priorWeight;
+    p11 += d * n1 * n1;
+    p12 += d * n1 * n2;
+    p22 += d * n2 * n2;
+  }
+
+  // solve (W + P) theta = r + P theta0 for theta = (a, b) per unit
+  double m11, m12, m22, r1, r2;
+  {
+    std::lock_guard<std::mutex> lk(_mutex);
+    m11 = _uu + p11;
+    m12 = _u + p12;
+    m22 = _w + p22;
+    r1 = _uy;
+    r2 = _y;
+  }
+  r1 += p11 * a0 + p12 * b0;
+  r2 += p12 * a0 + p22 * b0;
+  const double det = m11 * m22 - m12 * m12;
+  if (det <= 0)
+    return;
+  a = (r1 * m22 - r2 * m12) / det * units;
+  b = (m11 * r2 - m12 * r1) / det * units;
+}
+
+double OperatorCostModel::weight() const {
+  std::lock_guard<std::mutex> lk(_mutex);
+  return _w;
+}
+
+void OperatorCostModel::reset() {
+  std::lock_guard<std::mutex> lk(_mutex);
+  _w = _u = _y = _uu = _uy = 0;
+}
+
+OperatorCostModels &OperatorCostModels::getInstance() {
+  static OperatorCostModels models;
+  return models;
+}
+
+OperatorCostModel &OperatorCostModels::get(const std::string &op) {
+  std::lock_guard<std::mutex> lk(_mutex);
+  auto &model = _models[op];
+  if (!model)
+    model.reset(new OperatorCostModel());
+  return *model;
+}
+
+void OperatorCostModels::reset() {
+  std::lock_guard<std::mutex> lk(_mutex);
+  for (auto &model : _models)
+    model.second->reset();
+}
+
+} } // namespace hyrise::access
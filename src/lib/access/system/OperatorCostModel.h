@@ -0,0 +1,79 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hyrise {
+namespace access {
+
+/// Identifies the cost model a task calibrates: the operator type, its
+/// input size and the number of instances it was split into
+typedef struct {
+  std::string op;
+  size_t tableSize;
+  size_t instances;
+} calibration_t;
+
+/// Online estimate of the mean task execution time mts(x) = a / x + b of
+/// an operator type, x being the number of instances created by dynamic
+/// parallelization.
+///
+/// a and b are assumed to grow linearly with the input size, so runtimes
+/// per 100k input rows are fitted by least squares with exponentially
+/// decaying sample weights. The static coefficients of the operator act
+/// as prior: without samples they are returned unchanged, and as long as
+/// all samples share one instance count both parameters are scaled by the
+/// same factor.
+class OperatorCostModel {
+ public:
+  /// Inputs with fewer rows are dominated by fixed overheads and ignored
+  static const size_t MIN_TABLE_SIZE = 10000;
+
+  /// @param decay       Weight of the previous samples when adding one
+  /// @param priorWeight Weight of the static coefficients, in samples
+  explicit OperatorCostModel(double decay = 0.98, double priorWeight = 1.0);
+
+  /// Records the runtime in ms of one of instances tasks that processed
+  /// tableSize input rows together
+  void record(size_t tableSize, size_t instances, double runtime);
+
+  /// Estimates a and b in ms for tableSize input rows, priorA and priorB
+  /// being the static estimates of the operator
+  void estimate(size_t tableSize, double priorA, double priorB, double &a, double &b) const;
+
+  /// Sum of the decayed sample weights
+  double weight() const;
+
+  /// Drops all samples
+  void reset();
+
+ private:
+  const double _decay;
+  const double _priorWeight;
+  mutable std::mutex _mutex;
+  // decayed sums over the samples of u = 1 / instances and y = runtime
+  // per 100k rows
+  double _w = 0, _u = 0, _y = 0, _uu = 0, _uy = 0;
+};
+
+/// Cost models of all operator types run by this process, i.e. calibrated
+/// for the host it runs on
+class OperatorCostModels {
+ public:
+  static OperatorCostModels &getInstance();
+
+  /// Returns the model of an operator type, creating it on first use
+  OperatorCostModel &get(const std::string &op);
+
+  /// Drops the samples of all models
+  void reset();
+
+ private:
+  std::mutex _mutex;
+  std::map<std::string, std::unique_ptr<OperatorCostModel> > _models;
+};
+
+} } // namespace hyrise::access
@@ -33,9 +33,9 @@ double PlanOperation::calcA(double  totalTblSizeIn100k) {
   return a_a() * totalTblSizeIn100k + a_b();
 }
 
-size_t PlanOperation::determineDynamicCount(size_t maxTaskRunTime) {
+size_t PlanOperation::determineDynamicCount(size_t maxTaskRunTime, size_t idleWorkers) {
   // this can never be satisfied. Default to NO parallelization.
-  if (maxTaskRunTime == 0) {
+  if (maxTaskRunTime == 0 && idleWorkers == 0) {
     return 1;
   }
   
@@ -49,22 +49,40 @@ size_t PlanOperation::determineDynamicCount(size_t maxTaskRunTime) {
   
   auto totalTblSizeIn100k = totalTableSize / 100000.0;
 
-  // this is the b of the mts = a / instances + b  model
-  auto minMts = calcMinMts(totalTblSizeIn100k);
-  
-  if (maxTaskRunTime < minMts) {
-    LOG4CXX_ERROR(logger, planOperationName() << ": Could not honor MTS request. Too small.");
-    return 1024;
-  } 
+  // a and b of the mts = a / instances + b model, the static coefficients
+  // adapted to the runtimes measured on this host
+  double a, minMts;
+  OperatorCostModels::getInstance().get(vname()).estimate(totalTableSize, calcA(totalTblSizeIn100k), calcMinMts(totalTblSizeIn100k), a, minMts);
+
+  size_t numTasks = 1;
+  if (maxTaskRunTime > 0) {
+    if (maxTaskRunTime < minMts) {
+      LOG4CXX_ERROR(logger, planOperationName() << ": Could not honor MTS request. Too small.");
+      return 1024;
+    }
+    numTasks = std::max(1, static_cast<int>(round(a/(maxTaskRunTime - minMts))));
+  }
 
-  auto a = calcA(totalTblSizeIn100k);
-  size_t numTasks = std::max(1, static_cast<int>(round(a/(maxTaskRunTime - minMts))));
+  // idle workers take further instances as long as the share of an
+  // instance still outweighs the fixed cost b of every instance
+  if (idleWorkers > numTasks && a > 0 && minMts > 0) {
+    numTasks = std::max(numTasks, std::min(idleWorkers, static_cast<size_t>(round(a / minMts))));
+  }
 
-  LOG4CXX_DEBUG(logger, planOperationName() << ": tts(in 100k): " << totalTblSizeIn100k << ", numTasks: " << numTasks);
+  LOG4CXX_DEBUG(logger, planOperationName() << ": tts(in 100k): " << totalTblSizeIn100k << ", a: " << a << ", b: " << minMts << ", numTasks: " << numTasks);
 
+  _calibration = {vname(), totalTableSize, numTasks};
   return numTasks;
 }
 
+void PlanOperation::setCalibration(const calibration_t &calibration) {
+  _calibration = calibration;
+}
+
+const calibration_t &PlanOperation::getCalibration() const {
+  return _calibration;
+}
+
 PlanOperation::~PlanOperation() = default;
 
 void PlanOperation::addResult(storage::c_aresource_ptr_t result) {
@@ -180,10 +198,11 @@ void PlanOperation::operator()() noexcept {
 
 const PlanOperation * PlanOperation::execute() {
   const bool recordPerformance = _performance_attr != nullptr;
+  const bool calibrate = _calibration.instances > 0;
 
   // Check if we really need this
-  epoch_t startTime;
-  if (recordPerformance)
+  epoch_t startTime = 0;
+  if (recordPerformance || calibrate)
     startTime = get_epoch_nanoseconds();
 
   PapiTracer pt;
@@ -204,8 +223,18 @@ const PlanOperation * PlanOperation::execute() {
 
   teardownPlanOperation();
 
+  // successors without a placement of their own follow the output
+  if (output.numberOfTables() > 0 && output.getTable(0))
+    _actualNode = output.getTable(0)->numaNode();
+
+  epoch_t endTime = 0;
+  if (recordPerformance || calibrate)
+    endTime = get_epoch_nanoseconds();
+
+  if (calibrate)
+    OperatorCostModels::getInstance().get(_calibration.op).record(_calibration.tableSize, _calibration.instances, (endTime - startTime) / 1000000.0);
+
   if (recordPerformance) {
-    epoch_t endTime = get_epoch_nanoseconds();
     std::string threadId = boost::lexical_cast<std::string>(std::this_thread::get_id());
     *_performance_attr = (performance_attributes_t) {
       pt.value("PAPI_TOT_CYC"), pt.value(getEvent()), getEvent() , planOperationName(), _operatorId, startTime, endTime, threadId
@@ -230,6 +259,10 @@ void PlanOperation::setTXContext(tx::TXContext ctx) {
 
 void PlanOperation::addInput(storage::c_aresource_ptr_t t) {
   input.addResource(t);
+  // run close to the memory of the input unless told otherwise
+  const auto table = std::dynamic_pointer_cast<const storage::AbstractTable>(t);
+  if (table && _preferredCore == NO_PREFERRED_CORE && _preferredNode == NO_PREFERRED_NODE)
+    _preferredNode = table->numaNode();
 }
 
 void PlanOperation::setPlanId(std::string i) {
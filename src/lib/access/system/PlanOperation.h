@@ -4,6 +4,7 @@
 
 #include "access/system/OutputTask.h"
 #include "access/system/OperationData.h"
+#include "access/system/OperatorCostModel.h"
 #include "access/system/QueryParser.h"
 #include "io/TXContext.h"
 
@@ -64,6 +65,8 @@ class PlanOperation : public OutputTask {
    * a straight line model with a*x + b.
    * You can either override the following parameters in your operator
    * or you can supply your calc* methods.
+   * They are the static prior of the operator's OperatorCostModel, which
+   * adapts them to the measured runtimes.
    */
   virtual double min_mts_a() { return 0; }
   virtual double min_mts_b() { return 0; }
@@ -73,7 +76,12 @@ class PlanOperation : public OutputTask {
  public:
   virtual ~PlanOperation();
 
-  virtual size_t determineDynamicCount(size_t maxTaskRunTime);
+  virtual size_t determineDynamicCount(size_t maxTaskRunTime, size_t idleWorkers = 0);
+
+  /// Set on all tasks created by the dynamic parallelization of an
+  /// operator, their runtimes calibrate the operator's cost model
+  void setCalibration(const calibration_t &calibration);
+  const calibration_t &getCalibration() const;
 
   void setLimit(uint64_t l);
   void setProducesPositions(bool p);
@@ -128,6 +136,8 @@ class PlanOperation : public OutputTask {
   
   tx::TXContext _txContext;
 
+  /// Cost model sample this task contributes, if instances is set
+  calibration_t _calibration {"", 0, 0};
 };
 
 
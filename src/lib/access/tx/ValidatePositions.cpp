@@ -1,5 +1,9 @@
 #include "ValidatePositions.h"
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
 #include <storage/PointerCalculator.h>
 #include <storage/Store.h>
 #include <access/system/QueryParser.h>
@@ -22,9 +26,28 @@ void ValidatePositions::executePlanOperation() {
   // Allow to operate directly on the store
   if (std::dynamic_pointer_cast<const storage::Store>(getInputTable(0))) {
 
+    // The snapshot visibility is shared by all transactions that started
+    // at the same commit id, only our own changes have to be applied
     const auto& tab = checked_pointer_cast<const storage::Store>(getInputTable(0));
-    auto pc = tab->buildValidPositions(_txContext.lastCid, _txContext.tid);
-    addResult(std::make_shared<storage::PointerCalculator>(tab, new pos_list_t(std::move(pc))));
+    const auto visible = tab->snapshotVisibility(_txContext.lastCid);
+    auto pc = new pos_list_t();
+    pc->reserve(visible->count());
+    visible->appendPositions(0, tab->size(), *pc);
+
+    const auto& modifications = tx::TransactionManager::getInstance()[_txContext.tid];
+    if (modifications.hasDeleted(tab)) {
+      std::unordered_set<pos_t> deleted(modifications.getDeleted(tab).begin(), modifications.getDeleted(tab).end());
+      pc->erase(std::remove_if(pc->begin(), pc->end(), [&deleted] (pos_t p) { return deleted.count(p) != 0u; }), pc->end());
+    }
+    if (modifications.hasInserted(tab)) {
+      pos_list_t inserted(modifications.getInserted(tab));
+      std::sort(inserted.begin(), inserted.end());
+      pos_list_t merged;
+      merged.reserve(pc->size() + inserted.size());
+      std::set_union(pc->begin(), pc->end(), inserted.begin(), inserted.end(), std::back_inserter(merged));
+      pc->swap(merged);
+    }
+    addResult(std::make_shared<storage::PointerCalculator>(tab, pc));
 
   } else {
     // If it's no store it has to be a pointer calculator otherwise there is
@@ -8,6 +8,7 @@
 
 #include <hwloc.h>
 #include "HwlocHelper.h"
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <stdexcept>
@@ -37,11 +38,12 @@ std::vector<unsigned> getCoresForNode(hwloc_topology_t topology, unsigned node){
   // get all cores and check whether core is in subtree of node, if yes, push to vector
   // get number of cores by type
   number_of_cores = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_CORE);
-  // iterate over cores and check whether in subtree
+  // iterate over cores and check whether their cpus belong to the node;
+  // newer hwloc versions do not place cores below numa nodes
   hwloc_obj_t core;
   for(unsigned i = 0; i < number_of_cores; i++){
     core = hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE, i);
-    if(hwloc_obj_is_in_subtree(topology, core, obj)){
+    if(obj == nullptr || hwloc_bitmap_isincluded(core->cpuset, obj->cpuset)){
       children.push_back(core->logical_index);
     }
   }
@@ -49,27 +51,48 @@ std::vector<unsigned> getCoresForNode(hwloc_topology_t topology, unsigned node){
 }
 
 unsigned getNumberOfNodes(hwloc_topology_t topology){
-  return hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
+  // machines without numa nodes are treated as a single node
+  return std::max(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE), 1);
 }
 
 unsigned getNodeForCore(unsigned core){
-  hwloc_topology_t topology = getHWTopology();
-  unsigned nodes = getNumberOfNodes(topology);
+  return getNodeForCore(getHWTopology(), core);
+}
+
+unsigned getNodeForCore(hwloc_topology_t topology, unsigned core){
+  unsigned nodes = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
+  if (nodes == 0)
+    return 0;
   hwloc_obj_t obj;
   hwloc_obj_t core_obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE, core);
+  if (core_obj == nullptr)
+    throw std::runtime_error("expected to find core " + std::to_string(core));
   for(unsigned i = 0; i < nodes; i++){
     obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, i);
-    if (hwloc_obj_is_in_subtree(topology, core_obj, obj)){
+    if (hwloc_bitmap_isincluded(core_obj->cpuset, obj->cpuset)){
       return i;
     }
   }
   throw std::runtime_error("expected to find node for core");
 }
+
+bool bindMemoryToNode(hwloc_topology_t topology, const void *address, size_t bytes, unsigned node){
+  if (getNumberOfNodes(topology) <= 1 || bytes == 0)
+    return true;
+  hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, node);
+  if (obj == nullptr)
+    throw std::runtime_error("expected to find node " + std::to_string(node));
+#if HWLOC_API_VERSION >= 0x00020000
+  return hwloc_set_area_membind(topology, address, bytes, obj->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE | HWLOC_MEMBIND_BYNODESET) == 0;
+#else
+  return hwloc_set_area_membind_nodeset(topology, address, bytes, obj->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE) == 0;
+#endif
+}
 //assumes equal number of cores per node
 unsigned getNumberOfCoresPerNumaNode(){
   hwloc_topology_t topology = getHWTopology();
   unsigned number_of_cores, number_of_nodes;
   number_of_cores = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_CORE);
-  number_of_nodes = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
+  number_of_nodes = getNumberOfNodes(topology);
   return number_of_cores/number_of_nodes;
 };
@@ -13,8 +13,13 @@
 
 int getNumberOfCoresOnSystem();
 unsigned getNodeForCore(unsigned core);
+// node of core in topology; machines without NUMA nodes have node 0 only
+unsigned getNodeForCore(hwloc_topology_t topology, unsigned core);
 hwloc_topology_t getHWTopology();
 std::vector<unsigned> getCoresForNode(hwloc_topology_t topology, unsigned node);
 unsigned getNumberOfNodes(hwloc_topology_t topology);
 unsigned getNumberOfCoresPerNumaNode();
+// migrates the pages of [address, address + bytes) to node and binds them
+// there; does nothing and succeeds if topology has a single node
+bool bindMemoryToNode(hwloc_topology_t topology, const void *address, size_t bytes, unsigned node);
 
@@ -34,5 +34,69 @@ class Spinlock {
   }
 };
 
+/// Reader-writer spinlock. Shared holders may enter concurrently, an
+/// exclusive holder waits until all shared holders have left. A pending
+/// exclusive request blocks new shared holders so that it cannot starve.
+class SharedSpinlock {
+ private:
+  static const unsigned Exclusive = 1u << 31;
+  static const unsigned Pending = 1u << 30;
+  std::atomic<unsigned> _state;
+
+ public:
+  SharedSpinlock() : _state(0) {}
+
+  void lock_shared() {
+    unsigned state = _state.load(std::memory_order_relaxed);
+    while (true) {
+      if ((state & (Exclusive | Pending)) == 0 &&
+          _state.compare_exchange_weak(state, state + 1, std::memory_order_acquire)) {
+        return;
+      }
+      std::this_thread::yield();
+      state = _state.load(std::memory_order_relaxed);
+    }
+  }
+
+  void unlock_shared() {
+    _state.fetch_sub(1, std::memory_order_release);
+  }
+
+  void lock() {
+    // Announce the request, concurrent exclusive requests take turns
+    while ((_state.fetch_or(Pending, std::memory_order_relaxed) & Pending) != 0) {
+      std::this_thread::yield();
+    }
+    unsigned expected = Pending;
+    while (!_state.compare_exchange_weak(expected, Exclusive, std::memory_order_acquire)) {
+      expected = Pending;
+      std::this_thread::yield();
+    }
+  }
+
+  void unlock() {
+    // Keep the Pending bit of an exclusive request made during the hold
+    _state.fetch_and(~Exclusive, std::memory_order_release);
+  }
+};
+
+/// Holds a SharedSpinlock in shared mode for the lifetime of the guard
+class SharedLockGuard {
+ public:
+  explicit SharedLockGuard(SharedSpinlock& lock) : _lock(lock) {
+    _lock.lock_shared();
+  }
+
+  ~SharedLockGuard() {
+    _lock.unlock_shared();
+  }
+
+  SharedLockGuard(const SharedLockGuard&) = delete;
+  SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+
+ private:
+  SharedSpinlock& _lock;
+};
+
 }}
 
@@ -0,0 +1,339 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/BinaryTableDump.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "helper/checked_cast.h"
+
+#include "io/RedoLog.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/BaseAttributeVector.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/ColumnMetadata.h"
+#include "storage/MappedDictionary.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/meta_storage.h"
+#include "storage/storage_types.h"
+
+namespace hyrise { namespace storage {
+
+namespace BinaryDumpHelper {
+  static const char MAGIC[8] = {'H', 'Y', 'R', 'C', 'K', 'P', 'T', '2'};
+  static const std::string HEADER_FILE = "checkpoint.dat";
+  static const std::string DICT_EXT = ".dict.bin";
+  static const std::string ATTR_EXT = ".attr.bin";
+
+  typedef BitCompressedVector<value_id_t> vector_t;
+
+  static inline std::string buildPath(const std::string& base, const std::string& table, const std::string& file) {
+    return base + "/" + table + "/" + file;
+  }
+
+  static inline void write(std::ofstream& out, uint64_t value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  static inline uint64_t read(std::ifstream& in) {
+    uint64_t value = 0;
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    if (!in.good()) throw std::runtime_error("Truncated checkpoint header");
+    return value;
+  }
+
+  // Only main tables with order preserving dictionaries can be written
+  static inline void checkType(DataType type) {
+    if (type != IntegerType && type != FloatType && type != StringType)
+      throw std::runtime_error("Binary checkpoints only support dictionary encoded main columns");
+  }
+
+  template <typename T>
+  void writeValues(std::ofstream& out, BaseDictionary<T>& dict, size_t size) {
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i) {
+      values[i] = dict.getValueForValueId(i);
+    }
+    out.write(reinterpret_cast<const char *>(values.data()), size * sizeof(T));
+  }
+
+  template <>
+  void writeValues<std::string>(std::ofstream& out, BaseDictionary<std::string>& dict, size_t size) {
+    std::vector<uint64_t> offsets(size + 1, 0);
+    std::string heap;
+    for (size_t i = 0; i < size; ++i) {
+      offsets[i] = heap.size();
+      heap += dict.getValueForValueId(i);
+    }
+    offsets[size] = heap.size();
+    out.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    out.write(heap.data(), heap.size());
+  }
+}
+
+/**
+ * Writes the size and all values of a dictionary in value id order
+ */
+struct write_dictionary_functor {
+  typedef void value_type;
+  std::ofstream& out;
+  const adict_ptr_t& dict;
+
+  write_dictionary_functor(std::ofstream& o, const adict_ptr_t& d): out(o), dict(d) {}
+
+  template <typename R>
+  void operator()() {
+    auto d = checked_pointer_cast<BaseDictionary<R>>(dict);
+    size_t size = d->size();
+    BinaryDumpHelper::write(out, size);
+    BinaryDumpHelper::writeValues<R>(out, *d, size);
+  }
+};
+
+void BinaryTableDump::prepare(std::string name) {
+  struct stat buffer;
+  if (stat(_baseDirectory.c_str(), &buffer) != 0)
+    if (mkdir(_baseDirectory.c_str(), 0755) != 0 && errno != EEXIST)
+      throw std::runtime_error(strerror(errno));
+
+  std::string fullPath = _baseDirectory + "/" + name;
+  if (stat(fullPath.c_str(), &buffer) != 0)
+    if (mkdir(fullPath.c_str(), 0755) != 0 && errno != EEXIST)
+      throw std::runtime_error(strerror(errno));
+}
+
+void BinaryTableDump::dumpDictionary(std::string name, std::shared_ptr<AbstractTable> table, size_t col) {
+  std::ofstream out(BinaryDumpHelper::buildPath(_baseDirectory, name, table->nameOfColumn(col) + BinaryDumpHelper::DICT_EXT),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+  write_dictionary_functor fun(out, table->dictionaryAt(col));
+  type_switch<hyrise_basic_types> ts;
+  ts(table->typeOfColumn(col), fun);
+  if (!out.good()) throw std::runtime_error("Could not write dictionary of " + table->nameOfColumn(col));
+}
+
+std::vector<uint64_t> BinaryTableDump::dumpPartition(std::string name, std::shared_ptr<AbstractTable> table, size_t part, size_t first, size_t width) {
+  const auto av = table->getAttributeVectors(first).at(0).attribute_vector;
+  auto vector = std::dynamic_pointer_cast<BinaryDumpHelper::vector_t>(av);
+
+  // Uncompressed mains are bit-packed with the smallest widths their
+  // dictionaries allow, so restart always adopts a BitCompressedVector
+  if (!vector) {
+    auto values = checked_pointer_cast<BaseAttributeVector<value_id_t>>(av);
+    std::vector<uint64_t> bits(width);
+    for (size_t i = 0; i < width; ++i) {
+      size_t dictSize = table->dictionaryAt(first + i)->size();
+      bits[i] = dictSize <= 2 ? 1 : ceil(log(dictSize) / log(2.0));
+    }
+    vector = std::make_shared<BinaryDumpHelper::vector_t>(width, table->size(), bits);
+    vector->resize(table->size());
+    for (size_t i = 0; i < width; ++i) {
+      for (size_t row = 0; row < table->size(); ++row) {
+        vector->set(i, row, values->get(i, row));
+      }
+    }
+  }
+
+  std::ofstream out(BinaryDumpHelper::buildPath(_baseDirectory, name, std::to_string(part) + BinaryDumpHelper::ATTR_EXT),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(vector->blocks()), vector->blockCount() * sizeof(BinaryDumpHelper::vector_t::storage_t));
+  // Padding block for the unaligned loads of the unpacking kernels
+  BinaryDumpHelper::write(out, 0);
+  if (!out.good()) throw std::runtime_error("Could not write partition " + std::to_string(part));
+  return vector->bits();
+}
+
+void BinaryTableDump::dumpHeader(std::string name, std::shared_ptr<AbstractTable> table, const std::vector<std::vector<uint64_t>>& partitions,
+                                 uint64_t lsn, const std::string& logName) {
+  std::ofstream out(BinaryDumpHelper::buildPath(_baseDirectory, name, BinaryDumpHelper::HEADER_FILE),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(BinaryDumpHelper::MAGIC, sizeof(BinaryDumpHelper::MAGIC));
+  BinaryDumpHelper::write(out, lsn);
+  BinaryDumpHelper::write(out, logName.size());
+  out.write(logName.data(), logName.size());
+  BinaryDumpHelper::write(out, table->size());
+  BinaryDumpHelper::write(out, table->columnCount());
+  for (size_t i = 0; i < table->columnCount(); ++i) {
+    const auto& column = table->nameOfColumn(i);
+    BinaryDumpHelper::write(out, table->typeOfColumn(i));
+    BinaryDumpHelper::write(out, column.size());
+    out.write(column.data(), column.size());
+  }
+
+  BinaryDumpHelper::write(out, partitions.size());
+  for (const auto& bits : partitions) {
+    BinaryDumpHelper::write(out, bits.size());
+    for (const auto& b : bits) {
+      BinaryDumpHelper::write(out, b);
+    }
+  }
+  if (!out.good()) throw std::runtime_error("Could not write checkpoint header");
+}
+
+bool BinaryTableDump::dump(std::string name, std::shared_ptr<AbstractTable> table, uint64_t lsn, const std::string& logName) {
+  auto store = std::dynamic_pointer_cast<Store>(table);
+  if (!store) throw std::runtime_error("Can only dump Stores");
+  if (store->subtableCount() != 2) throw std::runtime_error("Cannot dump a store during an online merge");
+
+  auto mainTable = store->getMainTable();
+  prepare(name);
+  for (size_t i = 0; i < mainTable->columnCount(); ++i) {
+    BinaryDumpHelper::checkType(mainTable->typeOfColumn(i));
+    dumpDictionary(name, mainTable, i);
+  }
+
+  // Partitions are runs of consecutive columns sharing an attribute vector
+  std::vector<std::vector<uint64_t>> partitions;
+  for (size_t first = 0; first < mainTable->columnCount();) {
+    const auto av = mainTable->getAttributeVectors(first).at(0).attribute_vector;
+    size_t width = 0;
+    for (; first + width < mainTable->columnCount(); ++width) {
+      const auto column = mainTable->getAttributeVectors(first + width).at(0);
+      if (column.attribute_vector != av) break;
+      if (column.attribute_offset != width)
+        throw std::runtime_error("Binary checkpoints require partitions in column order");
+    }
+    partitions.push_back(dumpPartition(name, mainTable, partitions.size(), first, width));
+    first += width;
+  }
+
+  // The header is written last, an incomplete checkpoint cannot be loaded
+  dumpHeader(name, mainTable, partitions, lsn, logName);
+  return true;
+}
+
+} // namespace storage
+
+namespace io {
+
+namespace {
+
+/**
+ * Private, writable mapping of a whole file. Writes are copy on write
+ * and never reach the file.
+ */
+class MappedFile {
+  char *_data;
+  size_t _size;
+
+public:
+  explicit MappedFile(const std::string& path) : _data(nullptr), _size(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Could not open " + path + ": " + strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      throw std::runtime_error("Could not map empty or unreadable file " + path);
+    }
+    _size = st.st_size;
+    void *data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) throw std::runtime_error("Could not map " + path + ": " + strerror(errno));
+    _data = static_cast<char *>(data);
+  }
+
+  ~MappedFile() {
+    munmap(_data, _size);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  char *data() const { return _data; }
+  size_t size() const { return _size; }
+};
+
+/**
+ * Adopts a mapped dictionary file as dictionary of the column type
+ */
+struct map_dictionary_functor {
+  typedef storage::adict_ptr_t value_type;
+  const std::shared_ptr<MappedFile>& file;
+
+  explicit map_dictionary_functor(const std::shared_ptr<MappedFile>& f): file(f) {}
+
+  template <typename R>
+  value_type operator()() {
+    if (file->size() < sizeof(uint64_t)) throw std::runtime_error("Truncated checkpoint dictionary");
+    uint64_t size = *reinterpret_cast<const uint64_t *>(file->data());
+    const char *values = file->data() + sizeof(uint64_t);
+    if (!storage::MappedValues<R>::fits(values, size, file->size() - sizeof(uint64_t)))
+      throw std::runtime_error("Truncated checkpoint dictionary");
+    return std::make_shared<storage::MappedDictionary<R>>(values, size, file);
+  }
+};
+
+}
+
+std::shared_ptr<storage::AbstractTable> BinaryDumpLoader::load(std::shared_ptr<storage::AbstractTable>,
+                                                               const storage::compound_metadata_list *,
+                                                               const Loader::params &args) {
+  using storage::BinaryDumpHelper::read;
+  typedef storage::BinaryDumpHelper::vector_t vector_t;
+
+  std::ifstream header(storage::BinaryDumpHelper::buildPath(_base, _table, storage::BinaryDumpHelper::HEADER_FILE), std::ios::binary);
+  char magic[sizeof(storage::BinaryDumpHelper::MAGIC)];
+  header.read(magic, sizeof(magic));
+  if (!header.good() || memcmp(magic, storage::BinaryDumpHelper::MAGIC, sizeof(magic)) != 0)
+    throw std::runtime_error("Not a binary checkpoint: " + _base + "/" + _table);
+
+  const tx::RedoLog::lsn_t lsn = read(header);
+  std::string logName(read(header), '\0');
+  header.read(&logName[0], logName.size());
+
+  const size_t rows = read(header);
+  std::vector<storage::ColumnMetadata> metadata(read(header));
+  for (auto& column : metadata) {
+    auto type = static_cast<DataType>(read(header));
+    storage::BinaryDumpHelper::checkType(type);
+    std::string name(read(header), '\0');
+    header.read(&name[0], name.size());
+    column = storage::ColumnMetadata(name, type);
+  }
+
+  std::vector<storage::atable_ptr_t> partitions(read(header));
+  size_t column = 0;
+  for (size_t part = 0; part < partitions.size(); ++part) {
+    std::vector<uint64_t> bits(read(header));
+    for (auto& b : bits) b = read(header);
+    if (column + bits.size() > metadata.size())
+      throw std::runtime_error("Checkpoint partitions exceed the columns");
+
+    std::vector<storage::ColumnMetadata> partMetadata;
+    std::vector<storage::adict_ptr_t> dicts;
+    for (size_t i = 0; i < bits.size(); ++i, ++column) {
+      auto file = std::make_shared<MappedFile>(storage::BinaryDumpHelper::buildPath(_base, _table, metadata[column].getName() + storage::BinaryDumpHelper::DICT_EXT));
+      map_dictionary_functor fun(file);
+      storage::type_switch<hyrise_basic_types> ts;
+      dicts.push_back(ts(metadata[column].getType(), fun));
+      partMetadata.push_back(metadata[column]);
+    }
+
+    auto file = std::make_shared<MappedFile>(storage::BinaryDumpHelper::buildPath(_base, _table, std::to_string(part) + storage::BinaryDumpHelper::ATTR_EXT));
+    auto data = reinterpret_cast<vector_t::storage_t *>(file->data());
+    auto vector = std::make_shared<vector_t>(bits.size(), rows, bits, data, file);
+    if ((vector->blockCount() + 1) * sizeof(vector_t::storage_t) > file->size())
+      throw std::runtime_error("Truncated checkpoint partition " + std::to_string(part));
+    partitions[part] = std::make_shared<storage::Table>(partMetadata, vector, dicts);
+  }
+  if (column != metadata.size())
+    throw std::runtime_error("Checkpoint partitions do not cover all columns");
+
+  auto main = std::make_shared<storage::MutableVerticalTable>(partitions, rows);
+  if (lsn != 0) {
+    tx::RedoLog::getInstance().skipCheckpointed(logName, lsn);
+  }
+  return std::make_shared<storage::Store>(main);
+}
+
+} } // namespace hyrise::io
@@ -0,0 +1,93 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/AbstractLoader.h"
+
+namespace hyrise { namespace storage {
+
+class AbstractTable;
+
+/**
+ * Writes the main table of a store as a binary checkpoint that can be
+ * adopted on restart without parsing any value.
+ *
+ * Like the SimpleTableDump, every table gets a directory. It contains
+ * a header file with the number of rows, the column names and types and
+ * the bit widths of every partition, one file per partition with the
+ * raw blocks of its BitCompressedVector (including the padding block)
+ * and one file per dictionary. Dictionaries are stored as the number of
+ * values followed by the sorted values; strings are stored as offsets
+ * into a string heap that follows them. The delta is not written.
+ *
+ * The header also records the redo log sequence number of the merge the
+ * checkpoint was taken after and the name the table is logged as, so
+ * that restart only replays the records written after the checkpoint.
+ */
+class BinaryTableDump {
+  std::string _baseDirectory;
+
+  void prepare(std::string name);
+
+  void dumpDictionary(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
+
+  /**
+   * Writes the attribute vector holding the width columns starting at
+   * first and returns their bit widths
+   */
+  std::vector<uint64_t> dumpPartition(std::string name, std::shared_ptr<AbstractTable> t, size_t part, size_t first, size_t width);
+
+  void dumpHeader(std::string name, std::shared_ptr<AbstractTable> t, const std::vector<std::vector<uint64_t>>& partitions,
+                  uint64_t lsn, const std::string& logName);
+
+public:
+
+  explicit BinaryTableDump(std::string outputDir): _baseDirectory(outputDir) {
+  }
+
+  /**
+   * For a table identified by name and table perform the dump. lsn is
+   * the log sequence number of the last redo record of the table logged
+   * as logName that the main contains, 0 if it is not logged.
+   */
+  bool dump(std::string name, std::shared_ptr<AbstractTable> table, uint64_t lsn = 0, const std::string& logName = "");
+};
+
+} // namespace storage
+
+namespace io {
+
+/**
+ * Restores a store from a binary checkpoint written by the
+ * BinaryTableDump. The files are mapped privately and adopted as
+ * dictionaries and attribute vectors of the main table, so the restart
+ * cost is bounded by the page faults of the first accesses. Pages that
+ * are written to are copied, the files are never modified. The redo
+ * records the checkpoint contains are skipped when the table is replayed.
+ */
+class BinaryDumpLoader : public AbstractInput {
+  std::string _base;
+  std::string _table;
+
+public:
+  BinaryDumpLoader(std::string base, std::string table) :
+    _base(base), _table(table) {
+  }
+
+  std::shared_ptr<storage::AbstractTable> load(std::shared_ptr<storage::AbstractTable>,
+                                               const storage::compound_metadata_list *,
+                                               const Loader::params &args);
+
+  bool needs_store_wrap() {
+    return false;
+  }
+
+  BinaryDumpLoader *clone() const {
+    return new BinaryDumpLoader(*this);
+  }
+};
+
+} } // namespace hyrise::io
@@ -5,6 +5,7 @@
 
 #include "io/EmptyLoader.h"
 #include "io/LoaderException.h"
+#include "io/RedoLog.h"
 #include "storage/AbstractTable.h"
 #include "storage/AbstractMergeStrategy.h"
 #include "storage/SequentialHeapMerger.h"
@@ -131,7 +132,7 @@ std::shared_ptr<storage::AbstractTable> Loader::load(const params &args) {
     auto s = std::make_shared<storage::Store>(result);
     auto merger = new storage::TableMerger(new storage::DefaultMergeStrategy(), new storage::SequentialHeapMerger(), args.getCompressed());
     s->setMerger(merger);
-    s->merge();
+    tx::RedoLog::getInstance().merge(s);
     result = s;
   }
 
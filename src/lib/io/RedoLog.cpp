@@ -0,0 +1,645 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/RedoLog.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "helper/locking.h"
+#include "io/TransactionManager.h"
+#include "storage/AbstractTable.h"
+#include "storage/Store.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace tx {
+
+namespace {
+
+// Record types
+static const char COMMIT_RECORD = 'C';
+static const char MERGE_RECORD = 'M';
+// First record of a trimmed log, holds the sequence number it starts at
+static const char BASE_RECORD = 'B';
+
+// Every record is framed by its payload length and checksum
+static const size_t frame_header_size = 2 * sizeof(uint32_t);
+
+uint32_t checksum(const char *data, size_t size) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template <typename T>
+void write(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void write(std::string& out, const std::string& value) {
+  write<uint32_t>(out, value.size());
+  out.append(value);
+}
+
+std::string frame(const std::string& record) {
+  std::string result;
+  result.reserve(frame_header_size + record.size());
+  write<uint32_t>(result, record.size());
+  write<uint32_t>(result, checksum(record.data(), record.size()));
+  result.append(record);
+  return result;
+}
+
+class Reader {
+ public:
+  Reader(const char *data, size_t size) : _cursor(data), _end(data + size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string readString() {
+    const uint32_t size = read<uint32_t>();
+    return std::string(take(size), size);
+  }
+
+ private:
+  const char *take(size_t size) {
+    if (static_cast<size_t>(_end - _cursor) < size) {
+      throw std::runtime_error("Corrupt redo log record");
+    }
+    const char *result = _cursor;
+    _cursor += size;
+    return result;
+  }
+
+  const char *_cursor;
+  const char *_end;
+};
+
+template <>
+std::string Reader::read<std::string>() {
+  return readString();
+}
+
+struct encode_value_functor {
+  typedef void value_type;
+
+  std::string& out;
+  const storage::AbstractTable& table;
+  const storage::Store *store;
+  size_t col;
+  size_t row;
+
+  encode_value_functor(std::string& o, const storage::AbstractTable& t, size_t r) :
+      out(o), table(t), store(dynamic_cast<const storage::Store *>(&t)), col(0), row(r) {}
+
+  template <typename T>
+  value_type operator()() {
+    // Stores read value id and dictionary from one layout, an online
+    // merge may install a new main meanwhile
+    write(out, store ? store->getValue<T>(col, row) : table.getValue<T>(col, row));
+  }
+};
+
+struct decode_value_functor {
+  typedef void value_type;
+
+  Reader& in;
+  storage::AbstractTable& table;
+  size_t col;
+  size_t row;
+
+  decode_value_functor(Reader& i, storage::AbstractTable& t, size_t r) :
+      in(i), table(t), col(0), row(r) {}
+
+  template <typename T>
+  value_type operator()() {
+    table.setValue<T>(col, row, in.read<T>());
+  }
+};
+
+std::string encodeRow(const storage::AbstractTable& table, pos_t row) {
+  std::string result;
+  encode_value_functor fun(result, table, row);
+  storage::type_switch<hyrise_basic_types> ts;
+  for (size_t col = 0; col < table.columnCount(); ++col) {
+    fun.col = col;
+    ts(table.typeOfColumn(col), fun);
+  }
+  return result;
+}
+
+void decodeRow(const std::string& data, storage::AbstractTable& table, size_t row) {
+  Reader in(data.data(), data.size());
+  decode_value_functor fun(in, table, row);
+  storage::type_switch<hyrise_basic_types> ts;
+  for (size_t col = 0; col < table.columnCount(); ++col) {
+    fun.col = col;
+    ts(table.typeOfColumn(col), fun);
+  }
+}
+
+}
+
+RedoLog& RedoLog::getInstance() {
+  static RedoLog log;
+  return log;
+}
+
+RedoLog::RedoLog() :
+    _fd(-1),
+    _window(default_group_commit_window),
+    _baseLsn(0),
+    _startLsn(0),
+    _appendedLsn(0),
+    _durableLsn(0),
+    _flushes(0),
+    _stopping(false),
+    _failed(false) {
+}
+
+RedoLog::~RedoLog() {
+  close();
+}
+
+void RedoLog::open(const std::string& path, std::chrono::microseconds group_commit_window) {
+  if (isOpen()) {
+    throw std::runtime_error("Redo log is already open");
+  }
+  _path = path;
+  _window = group_commit_window;
+  {
+    std::lock_guard<std::mutex> lock(_checkpointsMutex);
+    _checkpoints.clear();
+  }
+  readLog();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+  if (_fd < 0) {
+    throw std::runtime_error("Cannot open redo log " + path + ": " + std::strerror(errno));
+  }
+  struct stat info;
+  if (::fstat(_fd, &info) != 0) {
+    throw std::runtime_error("Cannot stat redo log " + path + ": " + std::strerror(errno));
+  }
+  _appendedLsn = _durableLsn = _baseLsn + info.st_size;
+  _flushes = 0;
+  _stopping = false;
+  _failed = false;
+  _flusher = std::thread(&RedoLog::flushLoop, this);
+}
+
+void RedoLog::close() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_fd < 0) {
+      return;
+    }
+    _stopping = true;
+  }
+  _appended.notify_all();
+  _flusher.join();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  ::close(_fd);
+  _fd = -1;
+}
+
+bool RedoLog::isOpen() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _fd >= 0;
+}
+
+void RedoLog::readLog() {
+  _baseLsn = _startLsn = 0;
+  std::ifstream file(_path, std::ios::binary);
+  if (!file) {
+    return;
+  }
+  file.seekg(0, std::ios::end);
+  const size_t fileSize = file.tellg();
+  file.seekg(0);
+
+  // Records are read one at a time, only the parsed operations are kept
+  size_t offset = 0;
+  std::string payload;
+  while (fileSize - offset >= frame_header_size) {
+    char header[frame_header_size];
+    file.read(header, frame_header_size);
+    uint32_t size, sum;
+    std::memcpy(&size, header, sizeof(size));
+    std::memcpy(&sum, header + sizeof(size), sizeof(sum));
+    if (fileSize - offset - frame_header_size < size) {
+      break;
+    }
+    payload.resize(size);
+    file.read(&payload[0], size);
+    if (!file || checksum(payload.data(), size) != sum) {
+      break;
+    }
+    offset += frame_header_size + size;
+    if (offset == frame_header_size + size && size > 0 && payload[0] == BASE_RECORD) {
+      Reader in(payload.data(), payload.size());
+      in.read<char>();
+      _startLsn = in.read<uint64_t>();
+      _baseLsn = _startLsn - offset;
+      continue;
+    }
+    parseRecord(payload, _baseLsn + offset);
+  }
+
+  // Drop a record that was torn by a crash, otherwise it would hide all
+  // records appended behind it
+  if (offset != fileSize && ::truncate(_path.c_str(), offset) != 0) {
+    throw std::runtime_error("Cannot truncate redo log " + _path + ": " + std::strerror(errno));
+  }
+}
+
+void RedoLog::parseRecord(const std::string& payload, lsn_t lsn) {
+  Reader in(payload.data(), payload.size());
+  const char type = in.read<char>();
+
+  std::lock_guard<std::mutex> lock(_pendingMutex);
+  if (type == MERGE_RECORD) {
+    const std::string name = in.readString();
+    noteLogged(name);
+    _pending[name].push_back({lsn, true, {}, {}});
+  } else if (type == COMMIT_RECORD) {
+    const uint32_t tables = in.read<uint32_t>();
+    for (uint32_t t = 0; t < tables; ++t) {
+      pending_op_t op {lsn, false, {}, {}};
+      const std::string name = in.readString();
+      noteLogged(name);
+      const uint64_t inserted = in.read<uint64_t>();
+      for (uint64_t i = 0; i < inserted; ++i) {
+        const pos_t pos = in.read<uint64_t>();
+        op.inserted.emplace_back(pos, in.readString());
+      }
+      const uint64_t deleted = in.read<uint64_t>();
+      for (uint64_t i = 0; i < deleted; ++i) {
+        op.deleted.push_back(in.read<uint64_t>());
+      }
+      _pending[name].push_back(std::move(op));
+    }
+  } else {
+    throw std::runtime_error("Unknown redo log record type");
+  }
+}
+
+void RedoLog::registerTable(const std::string& name, const storage::c_atable_ptr_t& table) {
+  unregisterTable(name);
+  std::lock_guard<std::mutex> lock(_namesMutex);
+  _names[table.get()] = {table, name};
+}
+
+void RedoLog::unregisterTable(const std::string& name) {
+  std::lock_guard<std::mutex> lock(_namesMutex);
+  for (auto it = _names.begin(); it != _names.end();) {
+    if (it->second.second == name || it->second.first.expired()) {
+      it = _names.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::string RedoLog::tableName(const storage::c_atable_ptr_t& table) const {
+  std::lock_guard<std::mutex> lock(_namesMutex);
+  auto it = _names.find(table.get());
+  // An expired entry belongs to a freed table at the same address
+  if (it == _names.end() || it->second.first.expired()) {
+    return std::string();
+  }
+  return it->second.second;
+}
+
+std::string RedoLog::serializeCommit(const TXModifications& modifications) const {
+  // Collect inserted and deleted positions per registered table
+  std::map<std::string, std::pair<storage::c_atable_ptr_t, std::pair<const pos_list_t*, const pos_list_t*>>> tables;
+  for (const auto& kv : modifications.inserted) {
+    auto table = kv.first.lock();
+    std::string name = table ? tableName(table) : "";
+    if (!name.empty() && !kv.second.empty()) {
+      tables[name].first = table;
+      tables[name].second.first = &kv.second;
+    }
+  }
+  for (const auto& kv : modifications.deleted) {
+    auto table = kv.first.lock();
+    std::string name = table ? tableName(table) : "";
+    if (!name.empty() && !kv.second.empty()) {
+      tables[name].first = table;
+      tables[name].second.second = &kv.second;
+    }
+  }
+  if (tables.empty()) {
+    return std::string();
+  }
+
+  std::string record;
+  write(record, COMMIT_RECORD);
+  write<uint32_t>(record, tables.size());
+  for (const auto& kv : tables) {
+    const auto& table = *kv.second.first;
+    const pos_list_t *inserted = kv.second.second.first;
+    const pos_list_t *deleted = kv.second.second.second;
+
+    noteLogged(kv.first);
+    write(record, kv.first);
+    write<uint64_t>(record, inserted ? inserted->size() : 0);
+    if (inserted) {
+      for (const auto& pos : *inserted) {
+        write<uint64_t>(record, pos);
+        write(record, encodeRow(table, pos));
+      }
+    }
+    write<uint64_t>(record, deleted ? deleted->size() : 0);
+    if (deleted) {
+      for (const auto& pos : *deleted) {
+        write<uint64_t>(record, pos);
+      }
+    }
+  }
+  return record;
+}
+
+RedoLog::lsn_t RedoLog::append(const std::string& record) {
+  const std::string framed = frame(record);
+
+  lsn_t lsn;
+  bool wake;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_fd < 0) {
+      throw std::runtime_error("Redo log is not open");
+    }
+    wake = _buffer.empty() || _buffer.size() + framed.size() >= group_commit_max_bytes;
+    _buffer.append(framed);
+    _appendedLsn += framed.size();
+    lsn = _appendedLsn;
+  }
+  if (wake) {
+    _appended.notify_one();
+  }
+  return lsn;
+}
+
+void RedoLog::waitForDurable(lsn_t lsn) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _flushed.wait(lock, [&] { return _durableLsn >= lsn || _failed || _fd < 0; });
+  if (_durableLsn < lsn) {
+    throw std::runtime_error("Redo log " + _path + " failed, commit is not durable");
+  }
+}
+
+RedoLog::lsn_t RedoLog::merge(const storage::store_ptr_t& store, const storage::TableMerger* tableMerger,
+                              storage::atable_ptr_t* merged) {
+  auto run = [&] () {
+    auto main = tableMerger ? store->merge(*tableMerger) : store->merge();
+    if (merged)
+      *merged = main;
+  };
+  if (!isOpen() || tableName(store).empty()) {
+    run();
+    return 0;
+  }
+  std::lock_guard<locking::SharedSpinlock> lock(TransactionManager::getInstance().commitLock());
+  run();
+  return logMerge(store);
+}
+
+RedoLog::lsn_t RedoLog::logMerge(const storage::c_atable_ptr_t& table) {
+  if (!isOpen()) {
+    return 0;
+  }
+  const std::string name = tableName(table);
+  if (name.empty()) {
+    return 0;
+  }
+  std::string record;
+  write(record, MERGE_RECORD);
+  write(record, name);
+  noteLogged(name);
+  return append(record);
+}
+
+void RedoLog::skipCheckpointed(const std::string& name, lsn_t lsn) {
+  {
+    std::lock_guard<std::mutex> lock(_checkpointsMutex);
+    auto& checkpoint = _checkpoints[name];
+    checkpoint = std::max(checkpoint, lsn);
+  }
+  std::lock_guard<std::mutex> lock(_pendingMutex);
+  auto it = _pending.find(name);
+  if (it == _pending.end()) {
+    return;
+  }
+  // Records are read in log order
+  auto& ops = it->second;
+  ops.erase(ops.begin(), std::find_if(ops.begin(), ops.end(), [lsn] (const pending_op_t& op) {
+        return op.lsn > lsn;
+      }));
+}
+
+void RedoLog::checkpointed(const std::string& name, lsn_t lsn) {
+  if (name.empty() || lsn == 0) {
+    return;
+  }
+  lsn_t oldest;
+  {
+    std::lock_guard<std::mutex> lock(_checkpointsMutex);
+    auto& checkpoint = _checkpoints[name];
+    checkpoint = std::max(checkpoint, lsn);
+    oldest = checkpoint;
+    for (const auto& kv : _checkpoints) {
+      oldest = std::min(oldest, kv.second);
+    }
+  }
+  if (!isOpen()) {
+    return;
+  }
+
+  // Holds off appends while the log is rewritten
+  std::lock_guard<locking::SharedSpinlock> lock(TransactionManager::getInstance().commitLock());
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (oldest <= _startLsn) {
+      return;
+    }
+  }
+  trim(oldest);
+}
+
+void RedoLog::noteLogged(const std::string& name) const {
+  std::lock_guard<std::mutex> lock(_checkpointsMutex);
+  _checkpoints.emplace(name, 0);
+}
+
+void RedoLog::trim(lsn_t lsn) {
+  lsn_t appended;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    appended = _appendedLsn;
+  }
+  waitForDurable(appended);
+
+  // The records behind lsn are copied to a new file that starts with a
+  // base record, so they keep their sequence numbers
+  std::string base;
+  write(base, BASE_RECORD);
+  write<uint64_t>(base, lsn);
+  const std::string header = frame(base);
+  const std::string path = _path + ".trim";
+  {
+    std::ifstream in(_path, std::ios::binary);
+    in.seekg(lsn - _baseLsn);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(header.data(), header.size());
+    std::vector<char> chunk(1 << 16);
+    while (in.read(chunk.data(), chunk.size()) || in.gcount() > 0) {
+      out.write(chunk.data(), in.gcount());
+    }
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Cannot write trimmed redo log " + path);
+    }
+  }
+  const int fd = ::open(path.c_str(), O_WRONLY);
+  if (fd < 0 || ::fdatasync(fd) != 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    throw std::runtime_error("Cannot sync trimmed redo log " + path + ": " + std::strerror(errno));
+  }
+  ::close(fd);
+
+  // The flusher is idle, all records are durable and no appends happen
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (::rename(path.c_str(), _path.c_str()) != 0) {
+    throw std::runtime_error("Cannot replace redo log " + _path + ": " + std::strerror(errno));
+  }
+  ::close(_fd);
+  _fd = ::open(_path.c_str(), O_WRONLY | O_APPEND);
+  if (_fd < 0) {
+    _failed = true;
+    throw std::runtime_error("Cannot open redo log " + _path + ": " + std::strerror(errno));
+  }
+  _startLsn = lsn;
+  _baseLsn = lsn - header.size();
+}
+
+size_t RedoLog::flushCount() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _flushes;
+}
+
+void RedoLog::flushLoop() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _appended.wait(lock, [&] { return !_buffer.empty() || _stopping; });
+    if (_buffer.empty()) {
+      break;
+    }
+
+    // Give concurrent committers the chance to join this flush
+    _appended.wait_for(lock, _window, [&] {
+        return _stopping || _buffer.size() >= group_commit_max_bytes;
+      });
+
+    std::string batch;
+    batch.swap(_buffer);
+    const lsn_t lsn = _appendedLsn;
+    lock.unlock();
+
+    bool ok = true;
+    for (size_t written = 0; ok && written < batch.size();) {
+      const ssize_t result = ::write(_fd, batch.data() + written, batch.size() - written);
+      if (result < 0 && errno != EINTR) {
+        ok = false;
+      } else if (result > 0) {
+        written += result;
+      }
+    }
+    ok = ok && ::fdatasync(_fd) == 0;
+
+    lock.lock();
+    if (ok) {
+      _durableLsn = lsn;
+    } else {
+      _failed = true;
+    }
+    ++_flushes;
+    _flushed.notify_all();
+  }
+}
+
+void RedoLog::replay(const std::string& name, const storage::atable_ptr_t& table) {
+  std::vector<pending_op_t> ops;
+  {
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    auto it = _pending.find(name);
+    if (it == _pending.end()) {
+      return;
+    }
+    ops = std::move(it->second);
+    _pending.erase(it);
+  }
+
+  auto store = std::dynamic_pointer_cast<storage::Store>(table);
+  if (!store) {
+    throw std::runtime_error("Redo log records of " + name + " can only be replayed into a store");
+  }
+
+  // Replayed commits are not logged again since the table is not yet
+  // registered under its name
+  for (const auto& op : ops) {
+    if (op.merge) {
+      store->merge();
+      continue;
+    }
+
+    auto ctx = TransactionManager::beginTransaction();
+    auto& modifications = TransactionManager::getInstance()[ctx.tid];
+    {
+      locking::SharedLockGuard deltaLock(store->deltaWriteLock());
+      for (const auto& insert : op.inserted) {
+        const pos_t pos = insert.first;
+        if (pos < store->deltaOffset()) {
+          throw std::runtime_error("Redo log of " + name + " inserts into the main at " + std::to_string(pos));
+        }
+        // Rows of aborted transactions were not logged, the gaps stay invisible
+        if (pos >= store->size()) {
+          store->appendToDelta(pos + 1 - store->size());
+        }
+        decodeRow(insert.second, *store->getDeltaTable(), pos - store->deltaOffset());
+        store->setTid(pos, ctx.tid);
+        modifications.insertPos(store, pos);
+      }
+    }
+    for (const auto& pos : op.deleted) {
+      if (store->markForDeletion(pos, ctx.tid) != TX_CODE::TX_OK) {
+        throw std::runtime_error("Redo log of " + name + " deletes locked row " + std::to_string(pos));
+      }
+      modifications.deletePos(store, pos);
+    }
+    TransactionManager::commitTransaction(ctx);
+  }
+}
+
+}}
@@ -0,0 +1,187 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+class TableMerger;
+}
+
+namespace tx {
+
+class TXModifications;
+
+/// Default time the flusher waits for further commits before it syncs
+static const std::chrono::microseconds default_group_commit_window(200);
+
+/// A batch is flushed early once this many bytes are pending
+static const size_t group_commit_max_bytes = 1 << 20;
+
+/**
+ * Write-ahead redo log with group commit.
+ *
+ * Every committing transaction appends one record with the rows it
+ * inserted (position and values) and the positions it deleted in tables
+ * that are registered with the StorageManager. A record is appended after
+ * its commit can no longer abort but before it becomes visible, so
+ * aborted commits are never logged. The committer then waits until a
+ * background flusher has written and synced the batch that contains its
+ * record. The flusher waits up to the group commit window for further
+ * records, so concurrent commits share a single fdatasync. Changes become
+ * visible to other transactions before they are durable, but no commit is
+ * acknowledged before all commits it could have read from are durable,
+ * as those were appended before it.
+ *
+ * Appends are not serialized with drawing commit ids, so the log is not
+ * ordered by commit id. Records of concurrent commits may appear in any
+ * order, they cannot touch the same rows. Replay applies the records in
+ * log order and draws new commit ids, which keeps every commit behind
+ * the commits it read from.
+ *
+ * Opening an existing log reads all complete records. They are replayed
+ * table by table when a table of the same name is loaded into the
+ * StorageManager, before the table becomes visible to queries. Replay
+ * restores rows at their logged positions, so positions in later records
+ * and in blocking merges (which are logged as well) stay consistent.
+ * A checkpoint stores the log sequence number of the merge it was taken
+ * after; loading it skips the records it already contains. Once every
+ * table with records in the log has a checkpoint, the log is rewritten
+ * without the records all checkpoints contain. The rewritten log starts
+ * with a base record, so the remaining records keep their sequence
+ * numbers.
+ */
+class RedoLog {
+ public:
+  typedef uint64_t lsn_t;
+
+  static RedoLog& getInstance();
+
+  ~RedoLog();
+
+  /// Reads the committed records of an existing log at path for replay
+  /// and opens it for appending. A torn record at the end is truncated.
+  void open(const std::string& path,
+            std::chrono::microseconds group_commit_window = default_group_commit_window);
+
+  /// Flushes all pending records and closes the log
+  void close();
+
+  bool isOpen() const;
+
+  /// Serializes the modifications of a transaction, returns an empty
+  /// record if none of the modified tables is registered
+  std::string serializeCommit(const TXModifications& modifications) const;
+
+  /// Appends a serialized record and returns the log sequence number
+  /// that has to be durable for the record to be durable
+  lsn_t append(const std::string& record);
+
+  /// Blocks until all records up to lsn are synced to disk
+  void waitForDurable(lsn_t lsn);
+
+  /// Runs a blocking merge of store, which changes row positions, and
+  /// logs it if the store is registered. All blocking merges outside of
+  /// replay go through here. Commits are held off while a logged store is
+  /// merged, so the merge record follows exactly the commit records the
+  /// new main contains. Returns the log sequence number of the merge
+  /// record, 0 if the store is not logged. Uses tableMerger if given,
+  /// the merger of the store otherwise. If merged is given, it receives
+  /// the new main, which contains exactly the records up to the returned
+  /// position even if the store is merged again meanwhile.
+  lsn_t merge(const storage::store_ptr_t& store, const storage::TableMerger* tableMerger = nullptr,
+              storage::atable_ptr_t* merged = nullptr);
+
+  /// Logs the commits to table under name from now on. Called by the
+  /// StorageManager once the table is loaded or replaced.
+  void registerTable(const std::string& name, const storage::c_atable_ptr_t& table);
+
+  /// Stops logging the commits to the table registered as name
+  void unregisterTable(const std::string& name);
+
+  /// Name the table is logged as, empty if it is not registered
+  std::string tableName(const storage::c_atable_ptr_t& table) const;
+
+  /// Drops the pending records of the table logged as name up to lsn,
+  /// they are contained in a checkpoint of the table that is loaded
+  void skipCheckpointed(const std::string& name, lsn_t lsn);
+
+  /// Notes that the table logged as name has a checkpoint containing all
+  /// records up to lsn. Once every table with records in the log has a
+  /// checkpoint, the records before the oldest one are trimmed.
+  void checkpointed(const std::string& name, lsn_t lsn);
+
+  /// Applies the pending records of the table registered as name
+  void replay(const std::string& name, const storage::atable_ptr_t& table);
+
+  /// Number of syncs issued since the log was opened
+  size_t flushCount() const;
+
+ private:
+  struct pending_op_t {
+    // Log sequence number of the record the operation was read from
+    lsn_t lsn;
+    bool merge;
+    std::vector<std::pair<pos_t, std::string>> inserted;
+    pos_list_t deleted;
+  };
+
+  RedoLog();
+  RedoLog(const RedoLog&) = delete;
+  RedoLog& operator=(const RedoLog&) = delete;
+
+  void readLog();
+  void parseRecord(const std::string& payload, lsn_t lsn);
+  lsn_t logMerge(const storage::c_atable_ptr_t& table);
+  void flushLoop();
+  // Records that the log holds records of the table logged as name
+  void noteLogged(const std::string& name) const;
+  // Rewrites the log without the records up to lsn, appends are held off
+  void trim(lsn_t lsn);
+
+  std::string _path;
+  int _fd;
+  std::chrono::microseconds _window;
+  // Sequence number of the start of the file and of its first record,
+  // both are 0 unless the log was trimmed
+  lsn_t _baseLsn;
+  lsn_t _startLsn;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _appended;
+  std::condition_variable _flushed;
+  std::string _buffer;
+  lsn_t _appendedLsn;
+  lsn_t _durableLsn;
+  size_t _flushes;
+  bool _stopping;
+  bool _failed;
+  std::thread _flusher;
+
+  // Logged operations per table name that wait for the table to be loaded
+  std::map<std::string, std::vector<pending_op_t>> _pending;
+  std::mutex _pendingMutex;
+
+  // Checkpointed position per table with records in the log, 0 if the
+  // table has no checkpoint yet
+  mutable std::map<std::string, lsn_t> _checkpoints;
+  mutable std::mutex _checkpointsMutex;
+
+  // Registered name of logged tables, entries of freed tables are stale
+  std::map<const storage::AbstractTable*, std::pair<std::weak_ptr<const storage::AbstractTable>, std::string>> _names;
+  mutable std::mutex _namesMutex;
+};
+
+}}
@@ -18,6 +18,7 @@
 #include "helper/Environment.h"
 #include "io/Loader.h"
 #include "io/CSVLoader.h"
+#include "io/RedoLog.h"
 #include "storage/AbstractIndex.h"
 #include "storage/AbstractTable.h"
 #include "storage/ColumnMetadata.h"
@@ -28,7 +29,10 @@ namespace io {
 
 template<typename... Args>
 void StorageManager::addStorageTable(std::string name, Args && ... args) {
-  add(name, Loader::load(std::forward<Args>(args)...));
+  auto table = Loader::load(std::forward<Args>(args)...);
+  tx::RedoLog::getInstance().replay(name, table);
+  add(name, table);
+  tx::RedoLog::getInstance().registerTable(name, table);
 }
 
 StorageManager *StorageManager::getInstance() {
@@ -39,11 +43,14 @@ StorageManager *StorageManager::getInstance() {
 }
 
 void StorageManager::loadTable(std::string name, std::shared_ptr<storage::AbstractTable> table) {
+  tx::RedoLog::getInstance().replay(name, table);
   add(name, table);
+  tx::RedoLog::getInstance().registerTable(name, table);
 }
 
 void StorageManager::replaceTable(std::string name, std::shared_ptr<storage::AbstractTable> table) {
   replace(name, table);
+  tx::RedoLog::getInstance().registerTable(name, table);
 }
 
 void StorageManager::loadTable(std::string name, const Loader::params &parameters) {
@@ -90,6 +97,7 @@ std::shared_ptr<storage::AbstractTable> StorageManager::getTable(std::string nam
 void StorageManager::removeTable(std::string name) {
   if (exists(name))
     remove(name);
+  tx::RedoLog::getInstance().unregisterTable(name);
 }
 
 std::vector<std::string> StorageManager::getTableNames() const {
@@ -101,6 +109,8 @@ std::vector<std::string> StorageManager::getTableNames() const {
 }
 
 void StorageManager::removeAll() {
+  for (const auto& name : getTableNames())
+    tx::RedoLog::getInstance().unregisterTable(name);
   ResourceManager::clear();
 }
 
@@ -16,6 +16,7 @@
 #include "io/LoaderException.h"
 #include "io/GenericCSV.h"
 #include "io/CSVLoader.h"
+#include "io/RedoLog.h"
 
 #include "helper/stringhelpers.h"
 #include "helper/vector_helpers.h"
@@ -180,10 +181,13 @@ void SimpleTableDump::dumpHeader(std::string name, std::shared_ptr<AbstractTable
   data.close();
 }
 
-void SimpleTableDump::dumpMetaData(std::string name, std::shared_ptr<AbstractTable> table) {
+void SimpleTableDump::dumpMetaData(std::string name, std::shared_ptr<AbstractTable> table, uint64_t lsn, const std::string& logName) {
   std::string fullPath = _baseDirectory + "/" + name + "/metadata.dat";
   std::ofstream data (fullPath, std::ios::out | std::ios::binary);
   data << table->size();
+  // Dumps without a log position only contain the size
+  if (lsn != 0)
+    data << "\n" << lsn << "\n" << logName;
   data.close();
 }
 
@@ -195,7 +199,7 @@ void SimpleTableDump::verify(std::shared_ptr<AbstractTable> table) {
   if (res->subtableCount() != 2) throw std::runtime_error("Multi-generation stores are not supported for dumping");
 }
 
-bool SimpleTableDump::dump(std::string name, std::shared_ptr<AbstractTable> table) {
+bool SimpleTableDump::dump(std::string name, std::shared_ptr<AbstractTable> table, uint64_t lsn, const std::string& logName) {
   verify(table);
   auto mainTable = std::dynamic_pointer_cast<Store>(table)->getMainTable();
   prepare(name);
@@ -206,7 +210,7 @@ bool SimpleTableDump::dump(std::string name, std::shared_ptr<AbstractTable> tabl
   }
 
   dumpHeader(name, mainTable);
-  dumpMetaData(name, mainTable);
+  dumpMetaData(name, mainTable, lsn, logName);
   
   return true;
 }
@@ -224,6 +228,19 @@ size_t TableDumpLoader::getSize() {
   return numRows;
 }
 
+uint64_t TableDumpLoader::getCheckpoint(std::string &logName) {
+  std::string path = storage::DumpHelper::buildPath({_base, _table, storage::DumpHelper::META_DATA_EXT});
+  std::ifstream data (path, std::ios::binary);
+  size_t numRows;
+  uint64_t lsn = 0;
+  data >> numRows;
+  if (!(data >> lsn))
+    return 0;
+  data >> std::ws;
+  std::getline(data, logName);
+  return lsn;
+}
+
 
 void TableDumpLoader::loadDictionary(std::string name, size_t col, std::shared_ptr<storage::AbstractTable> intable) {
   std::string path = storage::DumpHelper::buildPath({_base, _table, name}) + storage::DumpHelper::DICT_EXT;
@@ -270,6 +287,10 @@ std::shared_ptr<storage::AbstractTable> TableDumpLoader::load(std::shared_ptr<st
     loadAttribute(name, i, tableSize, intable);
   }
 
+  std::string logName;
+  if (auto lsn = getCheckpoint(logName)) {
+    tx::RedoLog::getInstance().skipCheckpointed(logName, lsn);
+  }
   return intable;
 }
 
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,8 +47,9 @@ class SimpleTableDump {
   void dumpAttribute(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
 
   /**
+   * Stores the size of the table and the redo log position of the dump
    */
-  void dumpMetaData(std::string name, std::shared_ptr<AbstractTable> t);
+  void dumpMetaData(std::string name, std::shared_ptr<AbstractTable> t, uint64_t lsn, const std::string& logName);
 
   /**
    */
@@ -65,9 +67,12 @@ public:
   }
 
   /**
-   * For a table identified by name and table perform the dump
+   * For a table identified by name and table perform the dump. lsn is
+   * the redo log position the main table contains all records up to,
+   * logName the name the table is logged under. Loading the dump skips
+   * these records of the redo log.
    */
-  bool dump(std::string name, std::shared_ptr<AbstractTable> table);
+  bool dump(std::string name, std::shared_ptr<AbstractTable> table, uint64_t lsn = 0, const std::string& logName = "");
 };
 
 } // namespace storage
@@ -80,6 +85,9 @@ class TableDumpLoader : public AbstractInput {
 
   size_t getSize();
 
+  /// Reads the redo log position stored with the dump, 0 if there is none
+  uint64_t getCheckpoint(std::string &logName);
+
   void loadDictionary(std::string name, size_t col, std::shared_ptr<storage::AbstractTable> intable);
 
   void loadAttribute(std::string name,
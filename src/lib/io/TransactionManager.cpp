@@ -4,24 +4,24 @@
 #include <limits>
 #include <stdexcept>
 #include <map>
+#include <thread>
 
 #include "optional.hpp"
 #include "helper/make_unique.h"
 #include "helper/checked_cast.h"
 #include "helper/vector_helpers.h"
+#include "io/RedoLog.h"
 #include "storage/Store.h"
 
 namespace hyrise {
 namespace tx {
 
 void TXModifications::insertPos(const storage::c_atable_ptr_t& tab, pos_t pos) {
-  static locking::Spinlock _mtx;
-  _handle(_mtx, inserted, tab, pos);
+  _handle(_insertedMutex, inserted, tab, pos);
 }
 
 void TXModifications::deletePos(const storage::c_atable_ptr_t& tab, pos_t pos) {
-  static locking::Spinlock _mtx;
-  _handle(_mtx, deleted, tab, pos);
+  _handle(_deletedMutex, deleted, tab, pos);
 }
 
 bool TXModifications::hasDeleted(const storage::c_atable_ptr_t& tab) const {
@@ -55,7 +55,13 @@ void TXModifications::_handle(locking::Spinlock& mtx, map_t& data, const storage
 
 TransactionManager::TransactionManager() :
     _transactionCount(ATOMIC_VAR_INIT(tx::START_TID)),
-    _commitId(ATOMIC_VAR_INIT(tx::UNKNOWN_CID)) {}
+    _commitId(ATOMIC_VAR_INIT(tx::UNKNOWN_CID)),
+    _nextCommitId(ATOMIC_VAR_INIT(tx::UNKNOWN_CID)),
+    _completed(new std::atomic<transaction_cid_t>[max_pending_commits]) {
+  for (size_t i = 0; i < max_pending_commits; ++i) {
+    _completed[i] = UNKNOWN_CID;
+  }
+}
 
 TransactionManager& TransactionManager::getInstance() {
   static TransactionManager tm;
@@ -78,23 +84,63 @@ TXContext TransactionManager::buildContext() {
   return {getTransactionId(), getLastCommitId()};
 }
 
-transaction_cid_t TransactionManager::prepareCommit() {
-  transaction_id_t result;
-  while((result = tryPrepareCommit()) == 0) {
+transaction_cid_t TransactionManager::prepareCommit(transaction_id_t tid) {
+  transaction_cid_t result;
+  while((result = tryPrepareCommit(tid)) == UNKNOWN_CID) {
     std::this_thread::yield();
   }
   return result;
 }
 
-void TransactionManager::abort() {
-  if (!_txLock.is_locked())
+void TransactionManager::abort(transaction_id_t tid) {
+  auto cid = takeCommitId(tid);
+  if (cid == UNKNOWN_CID)
     throw std::runtime_error("Cannot abort a not running transaction.");
-  _txLock.unlock();
+  _completed[cid % max_pending_commits] = cid;
+  publishCommits();
 }
 
-transaction_cid_t TransactionManager::tryPrepareCommit() {
-  _txLock.lock();
-  return getLastCommitId() + 1;
+transaction_cid_t TransactionManager::tryPrepareCommit(transaction_id_t tid) {
+  auto cid = _nextCommitId.load();
+  do {
+    // The slot of the new commit id must have been published before, the
+    // last published commit id never exceeds the last allocated one
+    if (static_cast<size_t>(cid + 1 - _commitId.load()) > max_pending_commits)
+      return UNKNOWN_CID;
+  } while (!_nextCommitId.compare_exchange_weak(cid, cid + 1));
+
+  _txData([&tid, &cid] (map_t& txData) {
+      auto& data = txData[tid];
+      if (!data) {
+        data = make_unique<TransactionData>();
+      }
+      data->_context.tid = tid;
+      data->_context.cid = cid + 1;
+    });
+  return cid + 1;
+}
+
+transaction_cid_t TransactionManager::takeCommitId(transaction_id_t tid) {
+  return _txData([&tid] (map_t& txData) -> transaction_cid_t {
+      auto it = txData.find(tid);
+      if (it == txData.end()) {
+        return UNKNOWN_CID;
+      }
+      auto cid = it->second->_context.cid;
+      it->second->_context.cid = UNKNOWN_CID;
+      return cid;
+    });
+}
+
+void TransactionManager::publishCommits() {
+  auto last = _commitId.load();
+  while (_completed[(last + 1) % max_pending_commits].load() == last + 1) {
+    // On failure another committer advanced the commit id, last is
+    // updated to its value
+    if (_commitId.compare_exchange_weak(last, last + 1)) {
+      ++last;
+    }
+  }
 }
 
 TXModifications& TransactionManager::operator[](const transaction_id_t& key) {
@@ -118,10 +164,16 @@ std::optional<const TXModifications&> TransactionManager::getModifications(const
 
 
 void TransactionManager::commit(transaction_id_t tid) {
-  if (!_txLock.is_locked())
+  auto cid = takeCommitId(tid);
+  if (cid == UNKNOWN_CID)
     throw std::runtime_error("Double commit detected, possible TX corruption");
-  ++_commitId;
-  _txLock.unlock();
+  _completed[cid % max_pending_commits] = cid;
+
+  // If a lower commit is still running, its committer publishes ours
+  publishCommits();
+  while (_commitId.load() < cid) {
+    std::this_thread::yield();
+  }
 
   endTransaction(tid);
 }
@@ -130,6 +182,10 @@ void TransactionManager::commit(transaction_id_t tid) {
 void TransactionManager::reset() {
   _transactionCount = START_TID;
   _commitId = UNKNOWN_CID;
+  _nextCommitId = UNKNOWN_CID;
+  for (size_t i = 0; i < max_pending_commits; ++i) {
+    _completed[i] = UNKNOWN_CID;
+  }
   _txData([] (map_t& txData) { txData.clear(); });
 }
 
@@ -177,45 +233,81 @@ void TransactionManager::rollbackTransaction(TXContext ctx) {
 
 transaction_cid_t TransactionManager::commitTransaction(TXContext ctx) {
   auto& txmgr = getInstance();
-  ctx.cid = txmgr.prepareCommit();
-  if (auto mods = txmgr.getModifications(ctx.tid)) {
-    const auto& modifications = *mods;
-    // Only update the required positions
-    for (auto& kv: modifications.deleted) {
-      auto weak_table = kv.first;
-      // Only deleted records have to be checked for validity as newly inserted
-      // records will be always only written by us
-      if (auto store = getStore(weak_table.lock())) {
+  auto& log = RedoLog::getInstance();
+
+  // Serialize the redo record before drawing a commit id, our rows
+  // cannot change anymore
+  std::string record;
+  if (log.isOpen()) {
+    if (auto mods = txmgr.getModifications(ctx.tid)) {
+      record = log.serializeCommit(*mods);
+    }
+  }
+
+  RedoLog::lsn_t lsn = 0;
+  auto mods = txmgr.getModifications(ctx.tid);
+  if (mods) {
+    // Only deleted records have to be checked for validity as newly
+    // inserted records will be always only written by us. Rows we marked
+    // for deletion cannot be committed by anybody else, so this is checked
+    // before a commit id is drawn.
+    for (auto& kv: (*mods).deleted) {
+      if (auto store = getStore(kv.first.lock())) {
         if (TX_CODE::TX_OK != store->checkForConcurrentCommit(kv.second, ctx.tid)) {
-          txmgr.abort();
           throw std::runtime_error("Aborted TX with Last Commit ID != New Commit ID");
         }
       }
     }
+  }
 
-    for (auto& kv: modifications.inserted) {
-      auto weak_table = kv.first;
-      if (auto store = getStore(weak_table.lock())) {
-        auto result = store->commitPositions(kv.second, ctx.cid, true);
-        if (result != TX_CODE::TX_OK) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+  {
+    // Held until the commit is visible, so that no commit is in flight
+    // while a checkpoint is taken
+    locking::SharedLockGuard commitLock(txmgr.commitLock());
+    ctx.cid = txmgr.prepareCommit(ctx.tid);
+    if (mods) {
+      const auto& modifications = *mods;
+
+      for (auto& kv: modifications.inserted) {
+        auto weak_table = kv.first;
+        if (auto store = getStore(weak_table.lock())) {
+          auto result = store->commitPositions(kv.second, ctx.cid, true);
+          if (result != TX_CODE::TX_OK) {
+            txmgr.abort(ctx.tid);
+            throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+          }
+        }
+      }
+
+      for (auto& kv: modifications.deleted) {
+        auto weak_table = kv.first;
+        if (auto store = getStore(weak_table.lock())) {
+          auto result = store->commitPositions(kv.second, ctx.cid, false);
+          if (result != TX_CODE::TX_OK) {
+            txmgr.abort(ctx.tid);
+            throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+          }
         }
       }
-    }
 
-    for (auto& kv: modifications.deleted) {
-      auto weak_table = kv.first;
-      if (auto store = getStore(weak_table.lock())) {
-        auto result = store->commitPositions(kv.second, ctx.cid, false);
-        if (result != TX_CODE::TX_OK) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
+      // The record is appended once the commit cannot abort anymore, but
+      // before it becomes visible, so every transaction that reads our
+      // changes is logged after us
+      if (!record.empty()) {
+        try {
+          lsn = log.append(record);
+        } catch (...) {
+          // Release the commit id, later commits wait for it otherwise
+          txmgr.abort(ctx.tid);
+          throw;
         }
       }
     }
+    txmgr.commit(ctx.tid);
   }
-  txmgr.commit(ctx.tid);
+
+  // Group commit: concurrent committers share a flush
+  log.waitForDurable(lsn);
   return ctx.cid;
 }
 
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -54,8 +55,15 @@ private:
 
   // Abstraction to the specific inserted and deleted row processes.
   void _handle(locking::Spinlock& mtx, map_t& data, const storage::c_atable_ptr_t& key, pos_t pos);
+
+  // Protect the maps of this transaction against parallel operators
+  locking::Spinlock _insertedMutex;
+  locking::Spinlock _deletedMutex;
 };
 
+/// Maximum number of commits that have a commit id but are not visible yet
+static const size_t max_pending_commits = 4096;
+
 typedef struct TXData {
   TXContext _context;
   TXModifications _modifications;
@@ -109,23 +117,27 @@ class TransactionManager {
   TXContext buildContext();
 
   /*
+   * Starts the commit of the transaction tid
+   *
+   * Allocates the next commit ID for the transaction. Commits are not
+   * serialized: any number of transactions may write their commit IDs
+   * concurrently between prepareCommit() and commit(). Blocks while
+   * max_pending_commits commits are still waiting to become visible.
+   */
+  transaction_cid_t prepareCommit(transaction_id_t tid);
 
-   * Starts the Synchronized Transaction Process
-  *
-  * The call to prepare commit retrieves the next possible commit ID from the
-  * list and locks the call to serialized all incoming transactions. We
-  * protect this method using a spin lock. The lock is released in the
-  * @commit() method.
-  */
-  transaction_cid_t prepareCommit();
+  /**
+   * Completes the commit ID of a transaction that cannot commit, without
+   * waiting for it to become visible. The transaction stays registered
+   * so that it can be rolled back.
+   */
+  void abort(transaction_id_t tid);
 
-  void abort();
   /**
-  * Tries to acquire the spin lock for the prepare commit call and returns
-  * UNKNOWN in case of failure or the next commit ID in case of
-  * success
-  */
-  transaction_cid_t tryPrepareCommit();
+   * Tries to allocate a commit ID for tid and returns UNKNOWN_CID if too
+   * many commits are pending, the next commit ID otherwise
+   */
+  transaction_cid_t tryPrepareCommit(transaction_id_t tid);
 
   /*
   * Returns the modifications set for the given transaction id
@@ -133,13 +145,21 @@ class TransactionManager {
   TXModifications& operator[](const transaction_id_t& key);
 
   /**
-  * This call relases the prepare commit lock and increments the commit ID
-  * counter;
+  * Marks the commit ID of tid as complete and waits until it is visible.
+  * Commit IDs are published in order: the last commit ID only advances
+  * over commit IDs whose transactions have all completed, and any
+  * committer advances it as far as possible, including over the commits
+  * of others.
   */
   void commit(transaction_id_t tid);
 
   void endTransaction(transaction_id_t tid);
 
+  /// commitTransaction() holds this lock in shared mode from
+  /// prepareCommit() until its commit is visible. Holding it exclusively
+  /// waits for running commits and keeps new ones from starting.
+  locking::SharedSpinlock& commitLock() { return _commitLock; }
+
   void reset();
 
 
@@ -147,7 +167,15 @@ class TransactionManager {
   std::optional<const TXModifications&> getModifications(const transaction_id_t key) const;
 
   std::atomic<transaction_id_t> _transactionCount;
+  // Last published commit id, all lower commit ids are complete
   std::atomic<transaction_cid_t> _commitId;
+  // Last allocated commit id
+  std::atomic<transaction_cid_t> _nextCommitId;
+  // Slot cid % max_pending_commits holds cid once its commit completed
+  std::unique_ptr<std::atomic<transaction_cid_t>[]> _completed;
+
+  // Excludes checkpoints from running commits
+  locking::SharedSpinlock _commitLock;
 
   using map_t = std::unordered_map<transaction_id_t,
                                    std::unique_ptr<TransactionData>>;
@@ -155,11 +183,14 @@ class TransactionManager {
   // Keeping track of all transactions and their modifications
   Synchronized<map_t, locking::Spinlock> _txData;
 
-  // Spin Lock for transactions
-  locking::Spinlock _txLock;
-
   TransactionManager();
 
+  // Removes and returns the commit id allocated for tid
+  transaction_cid_t takeCommitId(transaction_id_t tid);
+
+  // Advances the last commit id over all completed commits
+  void publishCommits();
+
   // Get next transaction id
   transaction_id_t getTransactionId();
 };
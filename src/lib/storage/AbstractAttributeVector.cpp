@@ -5,5 +5,9 @@ namespace storage {
 
 AbstractAttributeVector::~AbstractAttributeVector() {}
 
+bool AbstractAttributeVector::placeOnNode(unsigned node) {
+  return false;
+}
+
 } } // namespace hyrise::storage
 
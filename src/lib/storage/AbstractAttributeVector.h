@@ -14,6 +14,13 @@ class AbstractAttributeVector {
   virtual void *data() = 0;
   virtual void setNumRows(size_t s) = 0;
 
+  /*
+   * Migrates the memory currently holding the values to the given NUMA
+   * node and binds it there. Returns false if the vector does not support
+   * placement or the migration failed.
+   */
+  virtual bool placeOnNode(unsigned node);
+
 };
 
 } } // namespace hyrise::storage
@@ -311,6 +311,20 @@ const attr_vectors_t AbstractTable::getAttributeVectors(size_t column) const {
   throw std::runtime_error("getAttributeVectors not implemented");
 }
 
+std::shared_ptr<ZoneMap> AbstractTable::zoneMapAt(size_t column) const {
+  return nullptr;
+}
+
+void AbstractTable::buildZoneMaps(size_t block_size) {
+}
+
+int AbstractTable::numaNode() const {
+  return NO_NUMA_NODE;
+}
+
+void AbstractTable::placeOnNode(unsigned node) {
+}
+
 void AbstractTable::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "AbstractTable " << this << std::endl;
 }
@@ -29,6 +29,7 @@ namespace storage {
 class ColumnMetadata;
 class AbstractDictionary;
 class AbstractAttributeVector;
+class ZoneMap;
 
 typedef struct {
   std::shared_ptr<AbstractAttributeVector> attribute_vector;
@@ -449,6 +450,42 @@ public:
   */
   virtual const attr_vectors_t getAttributeVectors(size_t column) const;
 
+  /**
+   * Returns the zone map of a column, or nullptr if the table does not
+   * maintain one for it.
+   *
+   * @param column Column of which to retrieve the zone map.
+   */
+  virtual std::shared_ptr<ZoneMap> zoneMapAt(size_t column) const;
+
+  /**
+   * Builds zone maps for all columns that are stored in an attribute
+   * vector of the table. Tables that cannot maintain zone maps ignore
+   * the call.
+   *
+   * @param block_size Number of rows summarized per zone map entry.
+   */
+  virtual void buildZoneMaps(size_t block_size);
+
+  //* Returned by numaNode() if the table was not placed on a node
+  static const int NO_NUMA_NODE = -1;
+
+  /**
+   * Returns the NUMA node the attribute vectors of the table were placed
+   * on, or NO_NUMA_NODE if they were never placed or are spread over
+   * several nodes.
+   */
+  virtual int numaNode() const;
+
+  /**
+   * Migrates the attribute vectors of the table to the given NUMA node.
+   * Dictionaries stay where they are. Tables that cannot be placed ignore
+   * the call.
+   *
+   * @param node Node to place the table on.
+   */
+  virtual void placeOnNode(unsigned node);
+
   virtual void debugStructure(size_t level=0) const;
 
   unique_id getUuid() const;
@@ -6,12 +6,17 @@
 #include <cstdint>
 #include <cstring>
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
+#include "helper/HwlocHelper.h"
+#include "helper/types.h"
 #include "storage/BaseAttributeVector.h"
+#include "storage/bit_unpacking.h"
 
 #ifndef WORD_LENGTH
 #define WORD_LENGTH 64
@@ -33,8 +38,11 @@ T maxValueForBits(const std::size_t bits) {
 */
 template <typename T>
 class BitCompressedVector : public BaseAttributeVector<T> {
+public:
   // Typedef for the data
   typedef uint64_t storage_t;
+
+private:
   typedef std::vector<uint64_t> bit_size_list_t;
 
   // Number of bits per storage element
@@ -57,6 +65,16 @@ class BitCompressedVector : public BaseAttributeVector<T> {
   // The bits used for each column
   bit_size_list_t _bits;
 
+  // Bit offset of each column inside a tuple, cached from _bits
+  bit_size_list_t _offsets;
+
+  // Number of bits per tuple, cached from _bits
+  uint64_t _width;
+
+  // Keeps adopted external memory alive, e.g. a mapped checkpoint file;
+  // _data is only freed by the vector itself if this is unset
+  std::shared_ptr<void> _owner;
+
 public:
   typedef T value_type;
 
@@ -65,11 +83,27 @@ public:
                       std::vector<uint64_t> bits={}): _data(nullptr), _size(0), _allocatedBlocks(0), _columns(columns), _bits(bits) {
     // When bits is unset, behave like a fixed length vector
     if (bits.size() == 0) { _bits = std::vector<uint64_t>(_columns, sizeof(T) * 8); }
+    _updateLayout();
     reserve(rows);
   }
 
+  /*
+    Adopts the blocks of rows tuples laid out for bits from external
+    memory that is kept alive by owner. The memory must be writable and
+    include the padding block; it is copied as soon as the vector grows.
+   */
+  BitCompressedVector(size_t columns,
+                      size_t rows,
+                      std::vector<uint64_t> bits,
+                      storage_t *blocks,
+                      std::shared_ptr<void> owner): _data(blocks), _size(rows), _allocatedBlocks(0), _columns(columns), _bits(bits), _owner(owner) {
+    _updateLayout();
+    _allocatedBlocks = _blocks(rows);
+  }
+
   virtual ~BitCompressedVector() {
-    free(_data);
+    if (!_owner)
+      free(_data);
   }
 
   void *data() {
@@ -146,8 +180,10 @@ public:
 
       std::swap(_data, newMemory);
 
-      // Only deallocate if there was something allocated
-      if (newMemory != nullptr)
+      // Only deallocate if there was something allocated by us
+      if (_owner)
+        _owner.reset();
+      else if (newMemory != nullptr)
         free(newMemory);
 
       // set new allocarted blocks
@@ -161,8 +197,12 @@ public:
    */
   void clear() {
     _size = 0;
-    free(_data);
+    if (_owner)
+      _owner.reset();
+    else
+      free(_data);
     _data = nullptr;
+    _allocatedBlocks = 0;
   }
 
   size_t size() {
@@ -186,11 +226,60 @@ public:
   void rewriteColumn(const size_t column, const size_t bits) {
     //uint64_t oldBits = _bits[column];
     _bits[column] = bits;
+    _updateLayout();
     if (_size > 0) {
       throw std::runtime_error("Bad rewrite");
     }
   }
 
+  /*
+    Decodes the values of column for the rows [begin, end) into out,
+    which must provide space for end - begin values.
+   */
+  void decodeRange(size_t column, size_t begin, size_t end, T *out) const {
+    if (begin >= end) return;
+    checkAccess(column, end - 1);
+    bit_unpacking::unpack<T>(_bits[column], _data, _width, _offsets[column], begin, end, out);
+  }
+
+  /*
+    Appends the positions of all rows in [begin, end) whose value in
+    column lies within [low, high] to positions.
+   */
+  void scanBetween(size_t column, T low, T high, size_t begin, size_t end, pos_list_t &positions) const {
+    if (begin >= end) return;
+    checkAccess(column, end - 1);
+    bit_unpacking::scanBetween<T>(_bits[column], _data, _width, _offsets[column], low, high, begin, end, positions);
+  }
+
+  /*
+    Appends the positions of all rows in [begin, end) whose value in
+    column equals value to positions.
+   */
+  void scanEquals(size_t column, T value, size_t begin, size_t end, pos_list_t &positions) const {
+    scanBetween(column, value, value, begin, end, positions);
+  }
+
+  /*
+    Raw access to the blocks holding the tuples, used to write binary
+    checkpoints. blockCount() excludes the padding block.
+   */
+  const storage_t *blocks() const {
+    return _data;
+  }
+
+  uint64_t blockCount() const {
+    return _blocks(_size);
+  }
+
+  const std::vector<uint64_t>& bits() const {
+    return _bits;
+  }
+
+  bool placeOnNode(unsigned node) {
+    return bindMemoryToNode(getHWTopology(), _data, _allocatedBlocks * sizeof(storage_t), node);
+  }
+
   std::shared_ptr<BaseAttributeVector<T>> copy() {
     std::shared_ptr<BitCompressedVector> b = std::make_shared<BitCompressedVector>(_columns, _size, _bits);
     b->resize(_size);
@@ -219,10 +308,7 @@ private:
     row in bits
    */
   inline uint64_t _offsetForColumn(uint64_t column) const {
-    uint64_t offset = 0;
-    for (uint64_t i = 0; i < column; ++i)
-      offset += _bits[i];
-    return offset;
+    return _offsets[column];
   }
 
   /*
@@ -249,24 +335,34 @@ private:
     Calculate the number of required bits for the tuple
    */
   inline uint64_t _tupleWidth() const {
-    uint64_t sum = 0;
-    if (sum == 0) {
-      for (uint64_t i = 0; i < _bits.size(); ++i)
-        sum += _bits[i];
+    return _width;
+  }
+
+  /*
+    Recalculates the cached column offsets and the tuple width, must be
+    called whenever _bits changes
+   */
+  void _updateLayout() {
+    _offsets.resize(_bits.size());
+    _width = 0;
+    for (uint64_t i = 0; i < _bits.size(); ++i) {
+      _offsets[i] = _width;
+      _width += _bits[i];
     }
-    return sum;
   }
 
   /*
-  * Allocate memory given by the number of blocks
+  * Allocate memory given by the number of blocks. One additional block
+  * is allocated as padding for the unaligned loads of the block
+  * unpacking kernels.
   */
   inline storage_t *_allocate(uint64_t numBlocks) {
 
-    auto data = static_cast<storage_t *>(malloc(numBlocks * sizeof(storage_t)));
+    auto data = static_cast<storage_t *>(malloc((numBlocks + 1) * sizeof(storage_t)));
     if (data == nullptr) {
       throw std::bad_alloc();
     }
-    std::memset(data, 0, numBlocks * sizeof(storage_t));
+    std::memset(data, 0, (numBlocks + 1) * sizeof(storage_t));
     return data;
   }
 
@@ -0,0 +1,64 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/BloomFilter.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/HashTable.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+// Finalizer of MurmurHash3, the hashes of integer values are the values
+// themselves and would only set the lowest bits
+uint64_t mix(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+}
+
+BloomFilter::BloomFilter(size_t keys, size_t bitsPerKey) {
+  resize(keys, bitsPerKey);
+}
+
+BloomFilter::BloomFilter(const c_atable_ptr_t& table, const field_list_t& fields, size_t bitsPerKey) :
+    _fieldCount(fields.size()) {
+  resize(table->size(), bitsPerKey);
+  for (pos_t row = 0, rows = table->size(); row < rows; ++row) {
+    insert(hashRow(table, fields, row));
+  }
+}
+
+void BloomFilter::resize(size_t keys, size_t bitsPerKey) {
+  size_t bits = 0;
+  while ((size_t(64) << bits) < keys * bitsPerKey) {
+    ++bits;
+  }
+  _shift = 64 - bits;
+  _blocks.assign(size_t(1) << bits, 0);
+}
+
+uint64_t BloomFilter::hashRow(const c_atable_ptr_t& table, const field_list_t& fields, pos_t row) {
+  uint64_t seed = 0;
+  for (const auto& field : fields) {
+    // compare boost hash_combine
+    seed ^= hash_value(table, field, table->getValueId(field, row)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return mix(seed);
+}
+
+void BloomFilter::filter(const c_atable_ptr_t& table, const field_list_t& fields,
+                         pos_t start, pos_t stop, pos_list_t& positions) const {
+  for (pos_t row = start; row < stop; ++row) {
+    if (mayContain(hashRow(table, fields, row))) {
+      positions.push_back(row);
+    }
+  }
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,84 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractResource.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/**
+ * Register blocked Bloom filter over the join keys of a table. Every key
+ * sets four bits in a single 64 bit block, so a test loads one word and
+ * compares it against a mask. Keys are the hashed values of the key
+ * columns, the filter of a build table can therefore be tested with the
+ * rows of any table with the same column types. A negative test means
+ * the row has no join partner, positive tests may be false positives.
+ */
+class BloomFilter : public AbstractResource {
+ public:
+  /// Sizes the filter for keys distinct keys with about bitsPerKey bits each
+  explicit BloomFilter(size_t keys, size_t bitsPerKey = 8);
+
+  /// Inserts the keys of all rows of table
+  BloomFilter(const c_atable_ptr_t& table, const field_list_t& fields, size_t bitsPerKey = 8);
+
+  virtual ~BloomFilter() {}
+
+  /// Combined hash of the values of the given columns of row
+  static uint64_t hashRow(const c_atable_ptr_t& table, const field_list_t& fields, pos_t row);
+
+  void insert(uint64_t hash) {
+    _blocks[block(hash)] |= mask(hash);
+  }
+
+  bool mayContain(uint64_t hash) const {
+    const uint64_t m = mask(hash);
+    return (_blocks[block(hash)] & m) == m;
+  }
+
+  bool mayContain(const c_atable_ptr_t& table, const field_list_t& fields, pos_t row) const {
+    return mayContain(hashRow(table, fields, row));
+  }
+
+  /// Appends all rows in [start, stop) of table that may have a key in the
+  /// filter to positions
+  void filter(const c_atable_ptr_t& table, const field_list_t& fields,
+              pos_t start, pos_t stop, pos_list_t& positions) const;
+
+  size_t blockCount() const {
+    return _blocks.size();
+  }
+
+  /// Number of key columns the filter was built over, 0 if unknown
+  size_t getFieldCount() const {
+    return _fieldCount;
+  }
+
+ private:
+  // The high bits of the hash select the block, the low 24 bits the four
+  // bits inside the block
+  size_t block(uint64_t hash) const {
+    return _shift == 64 ? 0 : static_cast<size_t>(hash >> _shift);
+  }
+
+  static uint64_t mask(uint64_t hash) {
+    return (1ull << (hash & 63)) | (1ull << ((hash >> 6) & 63)) |
+        (1ull << ((hash >> 12) & 63)) | (1ull << ((hash >> 18) & 63));
+  }
+
+  void resize(size_t keys, size_t bitsPerKey);
+
+  std::vector<uint64_t> _blocks;
+  size_t _shift;
+  size_t _fieldCount = 0;
+};
+
+typedef std::shared_ptr<const BloomFilter> c_bloom_filter_ptr_t;
+
+} } // namespace hyrise::storage
@@ -0,0 +1,194 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/DictionaryJoinTable.h"
+
+#include <sstream>
+
+#include "storage/AbstractTable.h"
+#include "storage/BaseDictionary.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+struct translation_functor {
+  typedef std::shared_ptr<std::vector<size_t> > value_type;
+  const adict_ptr_t &from;
+  const adict_ptr_t &to;
+
+  translation_functor(const adict_ptr_t &f, const adict_ptr_t &t) : from(f), to(t) {}
+
+  template<typename R>
+  value_type operator()() {
+    const auto &source = checked_pointer_cast<BaseDictionary<R>>(from);
+    const auto &target = checked_pointer_cast<BaseDictionary<R>>(to);
+    auto result = std::make_shared<std::vector<size_t> >(source->size(), AbstractFlatHashTable::npos);
+    auto &translation = *result;
+    if (source->isOrdered() && target->isOrdered()) {
+      // both dictionaries are sorted, so a single merge finds all values
+      // they have in common
+      const size_t sourceSize = source->size(), targetSize = target->size();
+      value_id_t i = 0, j = 0;
+      while (i < sourceSize && j < targetSize) {
+        const R value = source->getValueForValueId(i), other = target->getValueForValueId(j);
+        if (value < other) {
+          ++i;
+        } else if (other < value) {
+          ++j;
+        } else {
+          translation[i++] = j++;
+        }
+      }
+    } else {
+      for (value_id_t i = 0; i < translation.size(); ++i) {
+        const R value = source->getValueForValueId(i);
+        if (target->valueExists(value))
+          translation[i] = target->getValueIdForValue(value);
+      }
+    }
+    return result;
+  }
+};
+
+bool isDictionaryColumn(DataType type) {
+  return type != IntegerNoDictType && type != FloatNoDictType;
+}
+
+}
+
+DictionaryJoinTable::DictionaryJoinTable(c_atable_ptr_t table, field_t field, adict_ptr_t dictionary) :
+    _table(table), _field(field), _dictionary(dictionary) {
+}
+
+std::shared_ptr<DictionaryJoinTable> DictionaryJoinTable::build(const c_atable_ptr_t &table,
+                                                                const field_t field,
+                                                                const size_t row_offset) {
+  if (!isDictionaryColumn(table->typeOfColumn(field)))
+    return nullptr;
+  const auto &dictionary = table->dictionaryByTableId(field, 0);
+  if (!dictionary)
+    return nullptr;
+
+  const size_t rows = table->size();
+  std::vector<value_id_t> valueIds(rows);
+  for (pos_t row = 0; row < rows; ++row) {
+    const auto valueId = table->getValueId(field, row);
+    if (valueId.table != 0)
+      return nullptr;
+    valueIds[row] = valueId.valueId;
+  }
+
+  std::shared_ptr<DictionaryJoinTable> result(new DictionaryJoinTable(table, field, dictionary));
+  const size_t domain = dictionary->size();
+  result->_offsets.assign(domain + 1, 0);
+  for (const auto &valueId : valueIds)
+    ++result->_offsets[valueId + 1];
+  for (size_t valueId = 0; valueId < domain; ++valueId)
+    result->_offsets[valueId + 1] += result->_offsets[valueId];
+
+  result->_positions.resize(rows);
+  std::vector<size_t> cursor(result->_offsets.begin(), result->_offsets.end() - 1);
+  for (pos_t row = 0; row < rows; ++row)
+    result->_positions[cursor[valueIds[row]]++] = row + row_offset;
+  return result;
+}
+
+DictionaryJoinTable::DictionaryJoinTable(const std::vector<std::shared_ptr<const AbstractHashTable> > &hashTables) {
+  if (hashTables.empty())
+    throw std::runtime_error("No hash tables to merge");
+  std::vector<std::shared_ptr<const DictionaryJoinTable> > tables;
+  for (const auto &nextElement : hashTables) {
+    tables.push_back(checked_pointer_cast<const DictionaryJoinTable>(nextElement));
+    if (tables.back()->_dictionary != tables.front()->_dictionary)
+      throw std::runtime_error("Dictionary join tables can only be merged on the same dictionary");
+  }
+  _table = tables.front()->_table;
+  _field = tables.front()->_field;
+  _dictionary = tables.front()->_dictionary;
+
+  const size_t domain = tables.front()->numKeys();
+  _offsets.assign(domain + 1, 0);
+  for (size_t valueId = 0; valueId < domain; ++valueId) {
+    for (const auto &table : tables)
+      _positions.insert(_positions.end(), table->groupBegin(valueId), table->groupEnd(valueId));
+    _offsets[valueId + 1] = _positions.size();
+  }
+}
+
+std::shared_ptr<const std::vector<size_t> > DictionaryJoinTable::translation(const adict_ptr_t &dictionary) const {
+  if (dictionary == _dictionary)
+    return nullptr;
+  std::lock_guard<std::mutex> lock(_translationMutex);
+  // dictionaries of a delta grow, their translations are redone once
+  // they miss values
+  for (auto &entry : _translations) {
+    if (entry.first == dictionary) {
+      if (entry.second->size() < dictionary->size()) {
+        translation_functor fun(dictionary, _dictionary);
+        type_switch<hyrise_basic_types> ts;
+        entry.second = ts(_table->typeOfColumn(_field), fun);
+      }
+      return entry.second;
+    }
+  }
+  translation_functor fun(dictionary, _dictionary);
+  type_switch<hyrise_basic_types> ts;
+  std::shared_ptr<const std::vector<size_t> > result = ts(_table->typeOfColumn(_field), fun);
+  _translations.emplace_back(dictionary, result);
+  return result;
+}
+
+size_t DictionaryJoinTable::find(const c_atable_ptr_t &table,
+                                 const field_list_t &columns,
+                                 const pos_t row) const {
+  const auto valueId = table->getValueId(columns[0], row);
+  const auto map = translation(table->dictionaryByTableId(columns[0], valueId.table));
+  const size_t group = map ? (*map)[valueId.valueId] : valueId.valueId;
+  if (group == npos || groupBegin(group) == groupEnd(group))
+    return npos;
+  return group;
+}
+
+void DictionaryJoinTable::probe(const c_atable_ptr_t &table,
+                                const field_list_t &columns,
+                                pos_t first,
+                                pos_t last,
+                                pos_list_t &buildPositions,
+                                pos_list_t &probePositions) const {
+  if (!isDictionaryColumn(table->typeOfColumn(columns[0])))
+    throw std::runtime_error("Dictionary join tables can only be probed with dictionary encoded columns");
+
+  // translations of the dictionaries met so far, indexed by table id
+  std::vector<std::shared_ptr<const std::vector<size_t> > > maps;
+  std::vector<bool> resolved;
+  for (pos_t row = first; row < last; ++row) {
+    const auto valueId = table->getValueId(columns[0], row);
+    if (valueId.table >= resolved.size()) {
+      maps.resize(valueId.table + 1);
+      resolved.resize(valueId.table + 1, false);
+    }
+    if (!resolved[valueId.table] || (maps[valueId.table] && valueId.valueId >= maps[valueId.table]->size())) {
+      maps[valueId.table] = translation(table->dictionaryByTableId(columns[0], valueId.table));
+      resolved[valueId.table] = true;
+    }
+    const auto &map = maps[valueId.table];
+    const size_t group = map ? (*map)[valueId.valueId] : valueId.valueId;
+    if (group == npos)
+      continue;
+    const pos_t *begin = groupBegin(group), *end = groupEnd(group);
+    buildPositions.insert(buildPositions.end(), begin, end);
+    probePositions.insert(probePositions.end(), end - begin, row);
+  }
+}
+
+std::string DictionaryJoinTable::stats() const {
+  std::lock_guard<std::mutex> lock(_translationMutex);
+  std::stringstream s;
+  s << "Value Ids " << numKeys() << " / ";
+  s << "Rows " << _positions.size() << " / ";
+  s << "Translations " << _translations.size();
+  return s.str();
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,97 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/FlatHashTable.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Join table on a single build column whose rows all refer to its main
+/// dictionary. Groups are addressed directly by value id, so building it
+/// is a counting sort and nothing is hashed.
+///
+/// A probe row is resolved by translating its value id into the build
+/// dictionary: not at all if both columns share the dictionary, through
+/// a merge of both dictionaries if they are ordered and through value
+/// lookups otherwise. Translations are computed once per probe
+/// dictionary and kept with the table.
+class DictionaryJoinTable : public AbstractFlatHashTable {
+public:
+  /// Groups the rows of field, row_offset is added to every position as
+  /// for the HashTable. Returns nullptr if the column is not dictionary
+  /// encoded or a row refers to another dictionary, e.g. of a delta.
+  static std::shared_ptr<DictionaryJoinTable> build(const c_atable_ptr_t &table,
+                                                    const field_t field,
+                                                    const size_t row_offset = 0);
+
+  /// Merges tables built on the same dictionary, the positions of a value
+  /// id keep the order of the tables
+  explicit DictionaryJoinTable(const std::vector<std::shared_ptr<const AbstractHashTable> > &hashTables);
+
+  virtual ~DictionaryJoinTable() {}
+
+  size_t find(const c_atable_ptr_t &table,
+              const field_list_t &columns,
+              const pos_t row) const;
+
+  void probe(const c_atable_ptr_t &table,
+             const field_list_t &columns,
+             pos_t first,
+             pos_t last,
+             pos_list_t &buildPositions,
+             pos_list_t &probePositions) const;
+
+  const pos_t *groupBegin(size_t group) const {
+    return _positions.data() + _offsets[group];
+  }
+
+  const pos_t *groupEnd(size_t group) const {
+    return _positions.data() + _offsets[group + 1];
+  }
+
+  std::string stats() const;
+
+  size_t size() const {
+    return _positions.size();
+  }
+
+  c_atable_ptr_t getTable() const {
+    return _table;
+  }
+
+  field_list_t getFields() const {
+    return field_list_t {_field};
+  }
+
+  size_t getFieldCount() const {
+    return 1;
+  }
+
+  uint64_t numKeys() const {
+    return _offsets.size() - 1;
+  }
+
+  /// Returns the value ids of dictionary translated into value ids of the
+  /// build dictionary or nullptr if dictionary is the build dictionary.
+  /// Values missing in the build dictionary are translated to npos.
+  std::shared_ptr<const std::vector<size_t> > translation(const adict_ptr_t &dictionary) const;
+
+private:
+  DictionaryJoinTable(c_atable_ptr_t table, field_t field, adict_ptr_t dictionary);
+
+  c_atable_ptr_t _table;
+  field_t _field;
+  adict_ptr_t _dictionary;
+  std::vector<size_t> _offsets;
+  pos_list_t _positions;
+
+  mutable std::mutex _translationMutex;
+  mutable std::vector<std::pair<adict_ptr_t, std::shared_ptr<const std::vector<size_t> > > > _translations;
+};
+
+} } // namespace hyrise::storage
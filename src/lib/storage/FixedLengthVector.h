@@ -7,6 +7,7 @@
 #include <vector>
 
 
+#include "helper/HwlocHelper.h"
 #include "helper/not_implemented.h"
 #include "storage/BaseAttributeVector.h"
 
@@ -76,6 +77,10 @@ class FixedLengthVector : public AbstractFixedLengthVector<T> {
   virtual void clear() { _values.clear(); }
   virtual void rewriteColumn(const size_t, const size_t) {}
   virtual void *data() override { return _values.data();}
+
+  virtual bool placeOnNode(unsigned node) override {
+    return bindMemoryToNode(getHWTopology(), _values.data(), _values.capacity() * sizeof(T), node);
+  }
  private:
   void check_access(std::size_t columns, std::size_t rows) const {
 #ifdef EXPENSIVE_ASSERTIONS
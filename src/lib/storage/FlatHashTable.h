@@ -0,0 +1,571 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "helper/checked_cast.h"
+#include "helper/types.h"
+
+#include "storage/AbstractHashTable.h"
+#include "storage/AbstractTable.h"
+#include "storage/HashTable.h"
+#include "storage/storage_types.h"
+#include "taskscheduler/ParallelFor.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Maximum number of key columns of a flat hash table, HashBuild falls
+/// back to the node based HashTable for wider keys.
+static const size_t max_flat_key_columns = 4;
+
+/// Hash table with contiguous storage that groups the rows of a table
+/// by key. Distinct keys are numbered in order of their first
+/// appearance; the positions of a group are stored back to back, so the
+/// group of a key is found with a single open addressing lookup and its
+/// rows are read as one range. The key width is resolved by the derived
+/// FlatHashTable, users that only iterate groups or probe rows of
+/// another table work on this interface.
+class AbstractFlatHashTable : public AbstractHashTable {
+public:
+  static const size_t npos = std::numeric_limits<size_t>::max();
+
+  virtual ~AbstractFlatHashTable() {}
+
+  /// Returns the group of the key built from the given row and columns of
+  /// table or npos if there is none.
+  virtual size_t find(const c_atable_ptr_t &table,
+                      const field_list_t &columns,
+                      const pos_t row) const = 0;
+
+  /// Positions of group g are stored in [groupBegin(g), groupEnd(g))
+  virtual const pos_t *groupBegin(size_t group) const = 0;
+
+  virtual const pos_t *groupEnd(size_t group) const = 0;
+
+  virtual std::string stats() const = 0;
+
+  /// Probes rows [first, last) of table and appends the build positions
+  /// of every match to buildPositions and the probe row to
+  /// probePositions. Keys are hashed and prefetched a batch ahead of
+  /// their lookups.
+  virtual void probe(const c_atable_ptr_t &table,
+                     const field_list_t &columns,
+                     pos_t first,
+                     pos_t last,
+                     pos_list_t &buildPositions,
+                     pos_list_t &probePositions) const = 0;
+
+  pos_list_t get(const c_atable_ptr_t &table,
+                 const field_list_t &columns,
+                 const pos_t row) const {
+    auto group = find(table, columns, row);
+    if (group == npos)
+      return pos_list_t();
+    return pos_list_t(groupBegin(group), groupEnd(group));
+  }
+};
+
+/// Number of probe rows that are hashed and prefetched together
+static const size_t probe_batch_rows = 16;
+
+// Probes in batches of probe_batch_rows. The keys of the next batch are
+// hashed and their slots prefetched before the lookups of the current
+// batch are resolved, so the cache misses of a batch overlap with the
+// work on the previous one.
+template <typename Table>
+void probeInBatches(const Table &hashTable,
+                    const c_atable_ptr_t &table,
+                    const field_list_t &columns,
+                    pos_t first,
+                    pos_t last,
+                    pos_list_t &buildPositions,
+                    pos_list_t &probePositions) {
+  typename Table::key_t keys[2][probe_batch_rows];
+  uint64_t hashes[2][probe_batch_rows];
+
+  auto prepare = [&] (size_t buffer, pos_t batch) {
+    for (size_t i = 0, rows = std::min<size_t>(probe_batch_rows, last - batch); i < rows; ++i) {
+      keys[buffer][i] = Table::getGroupKey(table, columns, batch + i);
+      hashes[buffer][i] = Table::hashOf(keys[buffer][i]);
+      hashTable.prefetch(hashes[buffer][i]);
+    }
+  };
+
+  size_t buffer = 0;
+  if (first < last)
+    prepare(buffer, first);
+  for (pos_t batch = first; batch < last; batch += probe_batch_rows, buffer ^= 1) {
+    if (batch + probe_batch_rows < last)
+      prepare(buffer ^ 1, batch + probe_batch_rows);
+    for (size_t i = 0, rows = std::min<size_t>(probe_batch_rows, last - batch); i < rows; ++i) {
+      const size_t group = hashTable.find(keys[buffer][i], hashes[buffer][i]);
+      if (group != AbstractFlatHashTable::npos) {
+        const pos_t *begin = hashTable.groupBegin(group), *end = hashTable.groupEnd(group);
+        buildPositions.insert(buildPositions.end(), begin, end);
+        probePositions.insert(probePositions.end(), end - begin, batch + i);
+      }
+    }
+  }
+}
+
+/// Flat hash table over N key columns; V is the value stored per key
+/// column, value ids for aggregations and hashed values for joins, as
+/// for the single key HashTables.
+template <typename V, size_t N>
+class FlatHashTable : public AbstractFlatHashTable {
+public:
+  typedef std::array<V, N> key_t;
+
+private:
+  struct slot_t {
+    key_t key;
+    size_t group;
+  };
+
+  // Open addressing with linear probing, the number of slots is a power
+  // of two and at most half of them are used
+  std::vector<slot_t> _slots;
+  size_t _shift;
+
+  // Key and first position of every group, _offsets has one more entry
+  std::vector<key_t> _keys;
+  std::vector<size_t> _offsets;
+  pos_list_t _positions;
+
+  c_atable_ptr_t _table;
+  field_list_t _fields;
+
+  size_t slotOf(const key_t &key) const {
+    return static_cast<size_t>(hashOf(key) >> _shift);
+  }
+
+  void resizeSlots(size_t count) {
+    size_t bits = 4;
+    while ((size_t(1) << bits) < 2 * count)
+      ++bits;
+    _shift = 64 - bits;
+    _slots.assign(size_t(1) << bits, slot_t {key_t(), npos});
+    const size_t mask = _slots.size() - 1;
+    for (size_t group = 0; group < _keys.size(); ++group) {
+      size_t slot = slotOf(_keys[group]);
+      while (_slots[slot].group != npos)
+        slot = (slot + 1) & mask;
+      _slots[slot] = slot_t {_keys[group], group};
+    }
+  }
+
+  // Returns the group of key, adding a new group if the key is unknown
+  size_t insertKey(const key_t &key) {
+    const size_t mask = _slots.size() - 1;
+    size_t slot = slotOf(key);
+    while (_slots[slot].group != npos) {
+      if (_slots[slot].key == key)
+        return _slots[slot].group;
+      slot = (slot + 1) & mask;
+    }
+    size_t group = _keys.size();
+    _keys.push_back(key);
+    _slots[slot] = slot_t {key, group};
+    if (2 * _keys.size() > _slots.size())
+      resizeSlots(_keys.size() * 2);
+    return group;
+  }
+
+  // Groups the rows by key, rows[i] is stored under keys[i]
+  void build(const key_t *keys, const pos_t *rows, size_t count) {
+    // Start small, tables with few distinct keys stay in cache
+    resizeSlots(std::min<size_t>(count, 1024));
+    std::vector<size_t> groups(count);
+    for (size_t i = 0; i < count; ++i)
+      groups[i] = insertKey(keys[i]);
+
+    _offsets.assign(_keys.size() + 1, 0);
+    for (const auto &group : groups)
+      ++_offsets[group + 1];
+    for (size_t group = 0; group < _keys.size(); ++group)
+      _offsets[group + 1] += _offsets[group];
+
+    _positions.resize(count);
+    std::vector<size_t> cursor(_offsets.begin(), _offsets.end() - 1);
+    for (size_t i = 0; i < count; ++i)
+      _positions[cursor[groups[i]]++] = rows[i];
+  }
+
+public:
+  /// Combines the key columns, the high bits of the result select the
+  /// slot
+  static uint64_t hashOf(const key_t &key) {
+    size_t seed = 0;
+    for (size_t i = 0; i < N; ++i) {
+      // compare boost hash_combine
+      seed ^= static_cast<size_t>(key[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    // Fibonacci hashing spreads the combined value over the high bits
+    return static_cast<uint64_t>(seed) * 0x9e3779b97f4a7c15ull;
+  }
+
+  static key_t getGroupKey(const c_atable_ptr_t &table,
+                           const field_list_t &columns,
+                           const pos_t row) {
+    key_t key;
+    for (size_t i = 0; i < N; ++i)
+      key[i] = extractSingle<V>(table, columns[i], table->getValueId(columns[i], row));
+    return key;
+  }
+
+  // Hash given table's columns, row_offset is added to every position as
+  // for the HashTable
+  FlatHashTable(c_atable_ptr_t t, const field_list_t &f, size_t row_offset = 0)
+    : _table(t), _fields(f) {
+    if (_fields.size() != N)
+      throw std::runtime_error("Number of key columns does not match the flat hash table");
+    const size_t rows = _table->size();
+    std::vector<key_t> keys(rows);
+    pos_list_t positions(rows);
+    for (pos_t row = 0; row < rows; ++row) {
+      keys[row] = getGroupKey(_table, _fields, row);
+      positions[row] = row + row_offset;
+    }
+    build(keys.data(), positions.data(), rows);
+  }
+
+  // Groups count rows that were hashed elsewhere, rows[i] is stored under
+  // keys[i]
+  FlatHashTable(c_atable_ptr_t t, const field_list_t &f, const key_t *keys, const pos_t *rows, size_t count)
+    : _table(t), _fields(f) {
+    build(keys, rows, count);
+  }
+
+  // Merges the given flat hash tables, the positions of a key keep the
+  // order of the tables
+  explicit FlatHashTable(const std::vector<std::shared_ptr<const AbstractHashTable> > &hashTables) {
+    std::vector<key_t> keys;
+    pos_list_t positions;
+    for (const auto &nextElement : hashTables) {
+      const auto &ht = checked_pointer_cast<const FlatHashTable<V, N>>(nextElement);
+      if (!_table) {
+        _table = ht->getTable();
+        _fields = ht->getFields();
+      }
+      for (size_t group = 0; group < ht->numKeys(); ++group) {
+        keys.insert(keys.end(), ht->groupEnd(group) - ht->groupBegin(group), ht->_keys[group]);
+        positions.insert(positions.end(), ht->groupBegin(group), ht->groupEnd(group));
+      }
+    }
+    build(keys.data(), positions.data(), keys.size());
+  }
+
+  virtual ~FlatHashTable() {}
+
+  size_t find(const key_t &key) const {
+    return find(key, hashOf(key));
+  }
+
+  /// Same as above with the hash of key computed by hashOf
+  size_t find(const key_t &key, uint64_t hash) const {
+    const size_t mask = _slots.size() - 1;
+    size_t slot = static_cast<size_t>(hash >> _shift);
+    while (_slots[slot].group != npos) {
+      if (_slots[slot].key == key)
+        return _slots[slot].group;
+      slot = (slot + 1) & mask;
+    }
+    return npos;
+  }
+
+  size_t find(const c_atable_ptr_t &table,
+              const field_list_t &columns,
+              const pos_t row) const {
+    return find(getGroupKey(table, columns, row));
+  }
+
+  /// Fetches the slot of a key with the given hash into the cache
+  void prefetch(uint64_t hash) const {
+    __builtin_prefetch(&_slots[static_cast<size_t>(hash >> _shift)]);
+  }
+
+  void probe(const c_atable_ptr_t &table,
+             const field_list_t &columns,
+             pos_t first,
+             pos_t last,
+             pos_list_t &buildPositions,
+             pos_list_t &probePositions) const {
+    probeInBatches(*this, table, columns, first, last, buildPositions, probePositions);
+  }
+
+  const key_t &groupKey(size_t group) const {
+    return _keys[group];
+  }
+
+  const pos_t *groupBegin(size_t group) const {
+    return _positions.data() + _offsets[group];
+  }
+
+  const pos_t *groupEnd(size_t group) const {
+    return _positions.data() + _offsets[group + 1];
+  }
+
+  std::string stats() const {
+    std::stringstream s;
+    s << "Load Factor " << static_cast<double>(_keys.size()) / _slots.size() << " / ";
+    s << "Slot Count " << _slots.size() << " / ";
+    s << "Key Columns " << N;
+    return s.str();
+  }
+
+  size_t size() const {
+    return _positions.size();
+  }
+
+  c_atable_ptr_t getTable() const {
+    return _table;
+  }
+
+  field_list_t getFields() const {
+    return _fields;
+  }
+
+  size_t getFieldCount() const {
+    return N;
+  }
+
+  uint64_t numKeys() const {
+    return _keys.size();
+  }
+};
+
+/// Flat hash table that is built in parallel. Rows are radix partitioned
+/// by the hash of their key and every partition is grouped into its own
+/// FlatHashTable without any synchronization. Groups are numbered
+/// partition by partition, the positions of a group keep the row order.
+template <typename V, size_t N>
+class PartitionedFlatHashTable : public AbstractFlatHashTable {
+public:
+  typedef FlatHashTable<V, N> partition_t;
+  typedef typename partition_t::key_t key_t;
+
+  /// Number of rows every task hashes and scatters
+  static const size_t chunk_rows = 16 * 1024;
+
+private:
+  std::vector<std::shared_ptr<partition_t> > _partitions;
+  // First group of every partition, has one more entry
+  std::vector<size_t> _groupOffsets;
+  size_t _mask;
+
+  c_atable_ptr_t _table;
+  field_list_t _fields;
+
+  // The partition is taken from bits the partitions do not use for slots
+  size_t partitionOf(uint64_t hash) const {
+    return static_cast<size_t>(hash >> 32) & _mask;
+  }
+
+  size_t partitionOfGroup(size_t group) const {
+    return std::upper_bound(_groupOffsets.begin(), _groupOffsets.end(), group) - _groupOffsets.begin() - 1;
+  }
+
+public:
+  /// Hashes t into at least the given number of partitions, which is
+  /// rounded up to a power of two
+  PartitionedFlatHashTable(c_atable_ptr_t t, const field_list_t &f, size_t partitions, size_t row_offset = 0)
+    : _table(t), _fields(f) {
+    if (_fields.size() != N)
+      throw std::runtime_error("Number of key columns does not match the flat hash table");
+    size_t count = 1;
+    while (count < partitions)
+      count <<= 1;
+    _mask = count - 1;
+
+    const size_t rows = _table->size();
+    const size_t chunks = std::max<size_t>(1, (rows + chunk_rows - 1) / chunk_rows);
+
+    // Hash every chunk and count its rows per partition
+    std::vector<key_t> keys(rows);
+    std::vector<size_t> histogram(chunks * count, 0);
+    taskscheduler::parallelFor(chunks, [&] (size_t chunk) {
+        for (pos_t row = chunk * chunk_rows, end = std::min(rows, row + chunk_rows); row < end; ++row) {
+          keys[row] = partition_t::getGroupKey(_table, _fields, row);
+          ++histogram[chunk * count + partitionOf(partition_t::hashOf(keys[row]))];
+        }
+      });
+
+    // Every chunk writes its rows of a partition after those of the
+    // previous chunks, so partitions are in row order
+    std::vector<size_t> starts(count + 1);
+    size_t offset = 0;
+    for (size_t partition = 0; partition < count; ++partition) {
+      starts[partition] = offset;
+      for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t rowsInChunk = histogram[chunk * count + partition];
+        histogram[chunk * count + partition] = offset;
+        offset += rowsInChunk;
+      }
+    }
+    starts[count] = offset;
+
+    std::vector<key_t> partitionedKeys(rows);
+    pos_list_t positions(rows);
+    taskscheduler::parallelFor(chunks, [&] (size_t chunk) {
+        size_t *cursors = histogram.data() + chunk * count;
+        for (pos_t row = chunk * chunk_rows, end = std::min(rows, row + chunk_rows); row < end; ++row) {
+          auto &cursor = cursors[partitionOf(partition_t::hashOf(keys[row]))];
+          partitionedKeys[cursor] = keys[row];
+          positions[cursor++] = row + row_offset;
+        }
+      });
+
+    _partitions.resize(count);
+    taskscheduler::parallelFor(count, [&] (size_t partition) {
+        _partitions[partition] = std::make_shared<partition_t>(_table, _fields,
+                                                               partitionedKeys.data() + starts[partition],
+                                                               positions.data() + starts[partition],
+                                                               starts[partition + 1] - starts[partition]);
+      });
+
+    _groupOffsets.assign(1, 0);
+    for (const auto &partition : _partitions)
+      _groupOffsets.push_back(_groupOffsets.back() + partition->numKeys());
+  }
+
+  virtual ~PartitionedFlatHashTable() {}
+
+  static key_t getGroupKey(const c_atable_ptr_t &table,
+                           const field_list_t &columns,
+                           const pos_t row) {
+    return partition_t::getGroupKey(table, columns, row);
+  }
+
+  static uint64_t hashOf(const key_t &key) {
+    return partition_t::hashOf(key);
+  }
+
+  size_t find(const key_t &key) const {
+    return find(key, hashOf(key));
+  }
+
+  size_t find(const key_t &key, uint64_t hash) const {
+    const size_t partition = partitionOf(hash);
+    const size_t group = _partitions[partition]->find(key, hash);
+    return group == npos ? npos : _groupOffsets[partition] + group;
+  }
+
+  size_t find(const c_atable_ptr_t &table,
+              const field_list_t &columns,
+              const pos_t row) const {
+    return find(getGroupKey(table, columns, row));
+  }
+
+  void prefetch(uint64_t hash) const {
+    _partitions[partitionOf(hash)]->prefetch(hash);
+  }
+
+  void probe(const c_atable_ptr_t &table,
+             const field_list_t &columns,
+             pos_t first,
+             pos_t last,
+             pos_list_t &buildPositions,
+             pos_list_t &probePositions) const {
+    probeInBatches(*this, table, columns, first, last, buildPositions, probePositions);
+  }
+
+  const pos_t *groupBegin(size_t group) const {
+    const size_t partition = partitionOfGroup(group);
+    return _partitions[partition]->groupBegin(group - _groupOffsets[partition]);
+  }
+
+  const pos_t *groupEnd(size_t group) const {
+    const size_t partition = partitionOfGroup(group);
+    return _partitions[partition]->groupEnd(group - _groupOffsets[partition]);
+  }
+
+  size_t partitionCount() const {
+    return _partitions.size();
+  }
+
+  const partition_t &partition(size_t index) const {
+    return *_partitions[index];
+  }
+
+  std::string stats() const {
+    std::stringstream s;
+    s << "Partitions " << _partitions.size() << " / ";
+    s << "Keys " << _groupOffsets.back() << " / ";
+    s << "Key Columns " << N;
+    return s.str();
+  }
+
+  size_t size() const {
+    return _table->size();
+  }
+
+  c_atable_ptr_t getTable() const {
+    return _table;
+  }
+
+  field_list_t getFields() const {
+    return _fields;
+  }
+
+  size_t getFieldCount() const {
+    return N;
+  }
+
+  uint64_t numKeys() const {
+    return _groupOffsets.back();
+  }
+};
+
+/// Builds the flat hash table for the number of key columns in fields
+template <typename V>
+std::shared_ptr<AbstractFlatHashTable> buildFlatHashTable(const c_atable_ptr_t &table,
+                                                          const field_list_t &fields,
+                                                          size_t row_offset = 0) {
+  switch (fields.size()) {
+    case 1: return std::make_shared<FlatHashTable<V, 1>>(table, fields, row_offset);
+    case 2: return std::make_shared<FlatHashTable<V, 2>>(table, fields, row_offset);
+    case 3: return std::make_shared<FlatHashTable<V, 3>>(table, fields, row_offset);
+    case 4: return std::make_shared<FlatHashTable<V, 4>>(table, fields, row_offset);
+    default: throw std::runtime_error("Flat hash tables support 1 to 4 key columns");
+  }
+}
+
+/// Merges flat hash tables built over the same key columns. Partitioned
+/// tables are built over the whole input and are not merged.
+template <typename V>
+std::shared_ptr<AbstractFlatHashTable> mergeFlatHashTables(const std::vector<std::shared_ptr<const AbstractHashTable> > &hashTables) {
+  if (hashTables.empty())
+    throw std::runtime_error("No hash tables to merge");
+  switch (hashTables.front()->getFieldCount()) {
+    case 1: return std::make_shared<FlatHashTable<V, 1>>(hashTables);
+    case 2: return std::make_shared<FlatHashTable<V, 2>>(hashTables);
+    case 3: return std::make_shared<FlatHashTable<V, 3>>(hashTables);
+    case 4: return std::make_shared<FlatHashTable<V, 4>>(hashTables);
+    default: throw std::runtime_error("Flat hash tables support 1 to 4 key columns");
+  }
+}
+
+/// Builds the partitioned flat hash table for the number of key columns
+/// in fields
+template <typename V>
+std::shared_ptr<AbstractFlatHashTable> buildPartitionedFlatHashTable(const c_atable_ptr_t &table,
+                                                                     const field_list_t &fields,
+                                                                     size_t partitions,
+                                                                     size_t row_offset = 0) {
+  switch (fields.size()) {
+    case 1: return std::make_shared<PartitionedFlatHashTable<V, 1>>(table, fields, partitions, row_offset);
+    case 2: return std::make_shared<PartitionedFlatHashTable<V, 2>>(table, fields, partitions, row_offset);
+    case 3: return std::make_shared<PartitionedFlatHashTable<V, 3>>(table, fields, partitions, row_offset);
+    case 4: return std::make_shared<PartitionedFlatHashTable<V, 4>>(table, fields, partitions, row_offset);
+    default: throw std::runtime_error("Flat hash tables support 1 to 4 key columns");
+  }
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,242 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <assert.h>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "storage/BaseDictionary.h"
+#include "storage/BaseIterator.h"
+#include "storage/DictionaryIterator.h"
+#include "storage/OrderPreservingDictionary.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Sorted values of a mapped dictionary. Fixed width values are stored
+ * as a plain array.
+ */
+template <typename T>
+class MappedValues {
+  const T *_values;
+  size_t _size;
+  std::shared_ptr<void> _owner;
+
+public:
+  MappedValues(const char *data, size_t size, std::shared_ptr<void> owner) :
+    _values(reinterpret_cast<const T *>(data)), _size(size), _owner(owner) {}
+
+  size_t size() const { return _size; }
+
+  T get(size_t index) const { return _values[index]; }
+
+  bool less(size_t index, const T &value) const { return _values[index] < value; }
+
+  bool greater(size_t index, const T &value) const { return value < _values[index]; }
+
+  /// Checks that size values at data fit into the available bytes
+  static bool fits(const char *, size_t size, size_t available) { return size * sizeof(T) <= available; }
+};
+
+/*
+ * Strings are stored as size + 1 offsets into a heap that follows the
+ * offsets, value i spans [offset[i], offset[i + 1]).
+ */
+template <>
+class MappedValues<std::string> {
+  const uint64_t *_offsets;
+  const char *_heap;
+  size_t _size;
+  std::shared_ptr<void> _owner;
+
+  int compare(size_t index, const std::string &value) const {
+    return -value.compare(0, std::string::npos, _heap + _offsets[index], _offsets[index + 1] - _offsets[index]);
+  }
+
+public:
+  MappedValues(const char *data, size_t size, std::shared_ptr<void> owner) :
+    _offsets(reinterpret_cast<const uint64_t *>(data)), _heap(data + (size + 1) * sizeof(uint64_t)), _size(size), _owner(owner) {}
+
+  size_t size() const { return _size; }
+
+  std::string get(size_t index) const {
+    return std::string(_heap + _offsets[index], _offsets[index + 1] - _offsets[index]);
+  }
+
+  bool less(size_t index, const std::string &value) const { return compare(index, value) < 0; }
+
+  bool greater(size_t index, const std::string &value) const { return compare(index, value) > 0; }
+
+  static bool fits(const char *data, size_t size, size_t available) {
+    const size_t offsets = (size + 1) * sizeof(uint64_t);
+    return offsets <= available && reinterpret_cast<const uint64_t *>(data)[size] <= available - offsets;
+  }
+};
+
+
+template <typename T>
+class MappedDictionaryIterator;
+
+/*
+ * Read-only order preserving dictionary over sorted values that live in
+ * external memory, e.g. a mapped binary checkpoint. Lookups work
+ * directly on the mapped data, so adopting a dictionary does not parse
+ * or copy any value. Like any main dictionary it is replaced instead of
+ * modified by the next merge.
+ */
+template <typename T>
+class MappedDictionary : public BaseDictionary<T> {
+  MappedValues<T> _values;
+
+  // Returns the first value id whose value is not smaller than value
+  value_id_t lowerBound(const T &value) const {
+    size_t first = 0, count = _values.size();
+    while (count > 0) {
+      size_t step = count / 2;
+      if (_values.less(first + step, value)) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  // Returns the first value id whose value is greater than value
+  value_id_t upperBound(const T &value) const {
+    size_t first = 0, count = _values.size();
+    while (count > 0) {
+      size_t step = count / 2;
+      if (!_values.greater(first + step, value)) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+public:
+  /// Adopts size sorted values at data, which stays valid as long as owner
+  MappedDictionary(const char *data, size_t size, std::shared_ptr<void> owner) :
+    _values(data, size, owner) {}
+
+  virtual ~MappedDictionary() {}
+
+  void shrink() {}
+
+  value_id_t addValue(T value) {
+    throw std::runtime_error("Mapped dictionaries are read-only");
+  }
+
+  T getValueForValueId(value_id_t value_id) {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (value_id >= _values.size())
+      throw std::out_of_range("Trying to access value_id larger than available values");
+#endif
+    return _values.get(value_id);
+  }
+
+  value_id_t getValueIdForValue(const T &value) const {
+    return lowerBound(value);
+  }
+
+  value_id_t getValueIdForValueSmaller(T other) {
+    auto index = lowerBound(other);
+    assert(index > 0);
+    return index - 1;
+  }
+
+  value_id_t getValueIdForValueGreater(T other) {
+    return upperBound(other);
+  }
+
+  const T getSmallestValue() {
+    assert(_values.size() > 0);
+    return _values.get(0);
+  }
+
+  const T getGreatestValue() {
+    assert(_values.size() > 0);
+    return _values.get(_values.size() - 1);
+  }
+
+  bool isValueIdValid(value_id_t value_id) {
+    return value_id < _values.size();
+  }
+
+  bool valueExists(const T &value) const {
+    auto index = lowerBound(value);
+    return index < _values.size() && !_values.greater(index, value);
+  }
+
+  void reserve(size_t size) {}
+
+  size_t size() {
+    return _values.size();
+  }
+
+  std::shared_ptr<AbstractDictionary> copy() {
+    throw std::runtime_error("Dictionaries cannot be copied");
+  }
+
+  std::shared_ptr<AbstractDictionary> copy_empty() {
+    return std::make_shared<OrderPreservingDictionary<T>>();
+  }
+
+  bool isOrdered() {
+    return true;
+  }
+
+  typedef DictionaryIterator<T> iterator;
+
+  iterator begin() {
+    return iterator(std::make_shared<MappedDictionaryIterator<T>>(_values, 0));
+  }
+
+  iterator end() {
+    return iterator(std::make_shared<MappedDictionaryIterator<T>>(_values, _values.size()));
+  }
+};
+
+
+/*
+ * Iterator of a mapped dictionary, values are materialized on
+ * dereference since strings are not stored as std::string.
+ */
+template <typename T>
+class MappedDictionaryIterator : public BaseIterator<T> {
+  MappedValues<T> _values;
+  size_t _index;
+  mutable T _current;
+
+public:
+  MappedDictionaryIterator(const MappedValues<T>& values, size_t index): _values(values), _index(index) {}
+
+  virtual ~MappedDictionaryIterator() {}
+
+  void increment() {
+    ++_index;
+  }
+
+  bool equal(const std::shared_ptr<BaseIterator<T>>& other) const {
+    return _index == std::dynamic_pointer_cast<MappedDictionaryIterator<T>>(other)->_index;
+  }
+
+  T &dereference() const {
+    _current = _values.get(_index);
+    return _current;
+  }
+
+  value_id_t getValueId() const {
+    return _index;
+  }
+};
+
+} } // namespace hyrise::storage
@@ -239,6 +239,32 @@ const attr_vectors_t MutableVerticalTable::getAttributeVectors(size_t column) co
   return containerAt(column)->getAttributeVectors(offset_in_container[column]);
 }
 
+std::shared_ptr<ZoneMap> MutableVerticalTable::zoneMapAt(size_t column) const {
+  return containerAt(column)->zoneMapAt(offset_in_container[column]);
+}
+
+void MutableVerticalTable::buildZoneMaps(size_t block_size) {
+  for (const auto& c: containers) {
+    c->buildZoneMaps(block_size);
+  }
+}
+
+int MutableVerticalTable::numaNode() const {
+  // only a node all containers agree on is reported
+  int node = containers.empty() ? NO_NUMA_NODE : containers.front()->numaNode();
+  for (const auto& c: containers) {
+    if (c->numaNode() != node)
+      return NO_NUMA_NODE;
+  }
+  return node;
+}
+
+void MutableVerticalTable::placeOnNode(unsigned node) {
+  for (const auto& c: containers) {
+    c->placeOnNode(node);
+  }
+}
+
 void MutableVerticalTable::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "MutableVerticalTable" << this << std::endl;
   for(const auto& c: containers) {
@@ -55,6 +55,10 @@ public:
   table_id_t subtableCount() const override;
   atable_ptr_t copy() const override;
   const attr_vectors_t getAttributeVectors(size_t column) const override;
+  std::shared_ptr<ZoneMap> zoneMapAt(size_t column) const override;
+  void buildZoneMaps(size_t block_size = zone_map_block_size) override;
+  int numaNode() const override;
+  void placeOnNode(unsigned node) override;
   void debugStructure(size_t level=0) const override;
 
   /// Returns the container at a given index.
@@ -0,0 +1,115 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ParallelMerger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "taskscheduler/ParallelFor.h"
+
+namespace hyrise {
+namespace storage {
+
+ParallelMerger::ParallelMerger(size_t chunk_rows) : _chunk_rows(chunk_rows) {
+  if (chunk_rows == 0 || chunk_rows % 64 != 0) {
+    throw std::invalid_argument("ParallelMerger chunk size must be a positive multiple of 64");
+  }
+}
+
+std::vector<ParallelMerger::source_position_t> ParallelMerger::findChunkBoundaries(const std::vector<c_atable_ptr_t > &input_tables,
+                                                                                  bool useValid,
+                                                                                  const std::vector<bool>& valid) const {
+  std::vector<source_position_t> boundaries;
+  size_t destination_row = 0;
+  size_t part_counter = 0;
+  for (size_t table = 0; table < input_tables.size(); ++table) {
+    const size_t rows = input_tables[table]->size();
+    for (size_t row = 0; row < rows;) {
+      if (useValid && !valid[part_counter + row]) {
+        ++row;
+        continue;
+      }
+      if (destination_row % _chunk_rows == 0) {
+        boundaries.push_back({table, row, destination_row});
+      }
+      // Without a valid vector every source row is copied, so the next
+      // boundary can be computed directly
+      const size_t step = useValid ? 1 : std::min(rows - row, _chunk_rows - destination_row % _chunk_rows);
+      row += step;
+      destination_row += step;
+    }
+    part_counter += rows;
+  }
+  return boundaries;
+}
+
+void ParallelMerger::mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
+                                 atable_ptr_t merged_table,
+                                 const column_mapping_t &column_mapping,
+                                 const uint64_t newSize,
+                                 bool useValid,
+                                 const std::vector<bool>& valid) {
+  const std::vector<std::pair<size_t, size_t>> columns(column_mapping.begin(), column_mapping.end());
+  std::vector<value_id_mapping_t> mappingPerAtrtibute(input_tables[0]->columnCount());
+
+  // Dictionaries of different columns are independent, building them
+  // only reads the tables
+  std::vector<AbstractTable::SharedDictionaryPtr> dictionaries(columns.size());
+  const c_atable_ptr_t merged = merged_table;
+  taskscheduler::parallelFor(columns.size(), [&] (size_t i) {
+      dictionaries[i] = buildDictionary(input_tables, columns[i].first, merged, columns[i].second,
+                                        mappingPerAtrtibute[columns[i].first], useValid, valid);
+    });
+
+  // Installing a dictionary rewrites the bit layout shared by all columns
+  // of the attribute vector, so this is done by one thread
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (dictionaries[i])
+      merged_table->setDictionaryAt(dictionaries[i], columns[i].second);
+  }
+
+  merged_table->resize(newSize);
+
+  // Every chunk writes all columns of its destination rows, chunks start
+  // at multiples of 64 rows and never share a word of the attribute vector
+  const auto boundaries = findChunkBoundaries(input_tables, useValid, valid);
+  taskscheduler::parallelFor(boundaries.size(), [&] (size_t chunk) {
+      const auto& first = boundaries[chunk];
+      const size_t destination_end = chunk + 1 < boundaries.size() ? boundaries[chunk + 1].destination_row : newSize;
+
+      // Offset of the first table of the chunk in the valid vector
+      size_t first_part_counter = 0;
+      for (size_t table = 0; table < first.table; ++table) {
+        first_part_counter += input_tables[table]->size();
+      }
+
+      for (const auto& column : columns) {
+        const auto& mapping = mappingPerAtrtibute[column.first];
+        size_t table = first.table;
+        size_t row = first.row;
+        size_t part_counter = first_part_counter;
+        ValueId value_id;
+        for (size_t destination_row = first.destination_row; destination_row < destination_end;) {
+          if (row == input_tables[table]->size()) {
+            part_counter += input_tables[table]->size();
+            ++table;
+            row = 0;
+            continue;
+          }
+          if (!useValid || valid[part_counter + row]) {
+            value_id.valueId = input_tables[table]->getValueId(column.first, row).valueId;
+            if (!mapping.empty()) {
+              value_id.valueId = mapping[table][value_id.valueId];
+            }
+            merged_table->setValueId(column.second, destination_row++, value_id);
+          }
+          ++row;
+        }
+      }
+    });
+}
+
+AbstractMerger *ParallelMerger::copy() {
+  return new ParallelMerger(_chunk_rows);
+}
+
+} } // namespace hyrise::storage
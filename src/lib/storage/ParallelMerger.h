@@ -0,0 +1,49 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <storage/SequentialHeapMerger.h>
+
+namespace hyrise {
+namespace storage {
+
+/// Default number of destination rows remapped by one task, a multiple
+/// of 64 so that no two tasks write the same word of a bit-compressed
+/// attribute vector
+static const size_t parallel_merge_chunk_rows = 64 * 1024;
+
+/*
+ * Merger that produces the same result as SequentialHeapMerger using the
+ * shared task scheduler: the dictionaries of all columns are built
+ * concurrently and installed one after another, afterwards the value id
+ * remapping is split into ranges of destination rows that are processed
+ * in parallel.
+ */
+class ParallelMerger : public SequentialHeapMerger {
+public:
+  explicit ParallelMerger(size_t chunk_rows = parallel_merge_chunk_rows);
+
+  virtual void mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
+                           atable_ptr_t merged_table,
+                           const column_mapping_t &column_mapping,
+                           const uint64_t newSize,
+                           bool useValid = false,
+                           const std::vector<bool>& valid = std::vector<bool>());
+  virtual AbstractMerger *copy();
+
+private:
+
+  // First source row of a range of destination rows
+  struct source_position_t {
+    size_t table;
+    size_t row;
+    size_t destination_row;
+  };
+
+  std::vector<source_position_t> findChunkBoundaries(const std::vector<c_atable_ptr_t > &input_tables,
+                                                     bool useValid,
+                                                     const std::vector<bool>& valid) const;
+
+  const size_t _chunk_rows;
+};
+
+} } // namespace hyrise::storage
@@ -433,6 +433,10 @@ void PointerCalculator::debugStructure(size_t level) const {
   table->debugStructure(level+1);
 }
 
+int PointerCalculator::numaNode() const {
+  return table->numaNode();
+}
+
 
 void PointerCalculator::validate(tx::transaction_id_t tid, tx::transaction_id_t cid) {
   const auto& store = checked_pointer_cast<const Store>(table);
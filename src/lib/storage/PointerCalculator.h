@@ -83,6 +83,8 @@ public:
   void print(const size_t limit = (size_t) -1) const override;
   table_id_t subtableCount() const override { return 1; }
   void debugStructure(size_t level=0) const override;
+  // the rows live in the referenced table
+  int numaNode() const override;
  protected:
   void updateFieldMapping();
  private:
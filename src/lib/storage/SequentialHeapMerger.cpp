@@ -24,32 +24,7 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input
   std::vector<value_id_mapping_t> mappingPerAtrtibute(input_tables[0]->columnCount());
 
   for (const auto & kv: column_mapping) {
-    const auto &source = kv.first;
-    const auto &destination = kv.second;
-    switch (merged_table->metadataAt(destination).getType()) {
-    case IntegerType:
-    case IntegerTypeDelta:
-    case IntegerTypeDeltaConcurrent:
-      mergeValues<hyrise_int_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-    break;
-    
-    case FloatType:
-    case FloatTypeDelta:
-    case FloatTypeDeltaConcurrent:
-      mergeValues<hyrise_float_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-      break;
-      
-    case StringType:
-    case StringTypeDelta:
-    case StringTypeDeltaConcurrent:
-      mergeValues<hyrise_string_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-      break;
-    case IntegerNoDictType:
-    case FloatNoDictType:
-      merged_table->setDictionaryAt(makeDictionary(merged_table->typeOfColumn(destination)), destination);
-    default:
-      break;
-    }
+    mergeDictionary(input_tables, kv.first, merged_table, kv.second, mappingPerAtrtibute[kv.first], useValid, valid);
   }
 
   merged_table->resize(newSize);
@@ -63,10 +38,52 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input
   }
 }
 
+AbstractTable::SharedDictionaryPtr SequentialHeapMerger::buildDictionary(const std::vector<c_atable_ptr_t > &input_tables,
+                                                                         size_t source,
+                                                                         const c_atable_ptr_t &merged_table,
+                                                                         size_t destination,
+                                                                         value_id_mapping_t &mapping,
+                                                                         bool useValid,
+                                                                         const std::vector<bool>& valid) {
+  switch (merged_table->metadataAt(destination).getType()) {
+  case IntegerType:
+  case IntegerTypeDelta:
+  case IntegerTypeDeltaConcurrent:
+    return mergeValues<hyrise_int_t>(input_tables, source, merged_table, destination, mapping, useValid, valid);
+  
+  case FloatType:
+  case FloatTypeDelta:
+  case FloatTypeDeltaConcurrent:
+    return mergeValues<hyrise_float_t>(input_tables, source, merged_table, destination, mapping, useValid, valid);
+    
+  case StringType:
+  case StringTypeDelta:
+  case StringTypeDeltaConcurrent:
+    return mergeValues<hyrise_string_t>(input_tables, source, merged_table, destination, mapping, useValid, valid);
+  case IntegerNoDictType:
+  case FloatNoDictType:
+    return makeDictionary(merged_table->typeOfColumn(destination));
+  default:
+    return nullptr;
+  }
+}
+
+void SequentialHeapMerger::mergeDictionary(const std::vector<c_atable_ptr_t > &input_tables,
+                                           size_t source,
+                                           atable_ptr_t merged_table,
+                                           size_t destination,
+                                           value_id_mapping_t &mapping,
+                                           bool useValid,
+                                           const std::vector<bool>& valid) {
+  auto dict = buildDictionary(input_tables, source, merged_table, destination, mapping, useValid, valid);
+  if (dict)
+    merged_table->setDictionaryAt(dict, destination);
+}
+
 template <typename T>
-void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
+AbstractTable::SharedDictionaryPtr SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
                                        size_t source_column_index,
-                                       atable_ptr_t merged_table,
+                                       const c_atable_ptr_t &merged_table,
                                        size_t destination_column_index,
                                        value_id_mapping_t &value_id_mapping,
                                        bool useValid,
@@ -89,8 +106,7 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input
 
   // Create new BaseDictionary - shrink when merge finished?
   new_dict = createNewDict<T>(input_tables, value_id_maps, value_id_mapping, source_column_index, useValid, valid);
-  // set new value id map for column
-  merged_table->setDictionaryAt(new_dict, destination_column_index);
+  return new_dict;
 }
 
 
@@ -19,14 +19,37 @@ public:
                            const std::vector<bool>& valid = std::vector<bool>());
   virtual AbstractMerger *copy();
 
-private:
+protected:
 
   typedef std::vector<std::vector<value_id_t> > value_id_mapping_t;
 
+  /// Builds the merged dictionary of one column and the mapping from
+  /// the value ids of each input table to the new value ids without
+  /// modifying merged_table; returns nullptr for columns without one
+  AbstractTable::SharedDictionaryPtr buildDictionary(const std::vector<c_atable_ptr_t > &input_tables,
+                                                     size_t source,
+                                                     const c_atable_ptr_t &merged_table,
+                                                     size_t destination,
+                                                     value_id_mapping_t &mapping,
+                                                     bool useValid,
+                                                     const std::vector<bool>& valid);
+
+  /// Builds the merged dictionary of one column and installs it in
+  /// merged_table
+  void mergeDictionary(const std::vector<c_atable_ptr_t > &input_tables,
+                       size_t source,
+                       atable_ptr_t merged_table,
+                       size_t destination,
+                       value_id_mapping_t &mapping,
+                       bool useValid,
+                       const std::vector<bool>& valid);
+
+private:
+
   template <typename T>
-  void mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
+  AbstractTable::SharedDictionaryPtr mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
                    size_t source_column_index,
-                   atable_ptr_t  merged_table,
+                   const c_atable_ptr_t &merged_table,
                    size_t destination_column,
                    value_id_mapping_t &mapping,
                    bool useValid,
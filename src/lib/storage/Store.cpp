@@ -1,5 +1,6 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/Store.h>
+#include <algorithm>
 #include <iostream>
 
 #include <io/TransactionManager.h>
@@ -17,11 +18,16 @@
 
 namespace hyrise { namespace storage {
 
+// Number of logged positions that never invalidate the cached visibility
+static const size_t visibility_log_limit = 64 * 1024;
+
 TableMerger* createDefaultMerger() {
   return new TableMerger(new DefaultMergeStrategy, new SequentialHeapMerger, false);
 }
 
 Store::Store() :
+  _delta_size(0),
+  _layout(std::make_shared<layout_t>(layout_t {nullptr, nullptr, nullptr, 0})),
   merger(createDefaultMerger()) {
   setUuid();
 }
@@ -37,8 +43,10 @@ auto create_concurrent_storage = [](std::size_t cols) { return std::make_shared<
 
 Store::Store(atable_ptr_t main_table) :
     _delta_size(0),
-    _main_table(main_table),
-    delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)),
+    _layout(std::make_shared<layout_t>(layout_t {
+        main_table, nullptr,
+        main_table->copy_structure(create_concurrent_dict, create_concurrent_storage),
+        main_table->size()})),
     merger(createDefaultMerger()),
     _cidBeginVector(main_table->size(), 0),
     _cidEndVector(main_table->size(), tx::INF_CID),
@@ -50,16 +58,25 @@ Store::~Store() {
   delete merger;
 }
 
-void Store::merge() {
+atable_ptr_t Store::merge() {
   if (merger == nullptr) {
     throw std::runtime_error("No Merger set.");
   }
+  return merge(*merger);
+}
+
+atable_ptr_t Store::merge(const TableMerger& tableMerger) {
+  std::lock_guard<locking::SharedSpinlock> lock(_delta_write_lock);
+  const auto current = layout();
+  if (current->frozen_delta) {
+    throw std::runtime_error("Cannot merge while an online merge is in progress");
+  }
 
   // Create new delta and merge
-  atable_ptr_t new_delta = delta->copy_structure(create_concurrent_dict, create_concurrent_storage);
+  atable_ptr_t new_delta = current->delta->copy_structure(create_concurrent_dict, create_concurrent_storage);
 
   // Prepare the merge
-  std::vector<c_atable_ptr_t> tmp {_main_table, delta};
+  std::vector<c_atable_ptr_t> tmp {current->main, current->delta};
 
   // get valid positions
   std::vector<bool> validPositions(_cidBeginVector.size());
@@ -68,66 +85,149 @@ void Store::merge() {
     validPositions[i] = isVisibleForTransaction(i, last_commit_id, tx::MERGE_TID);
   });
 
-  auto tables = merger->merge(tmp, true, validPositions);
+  auto tables = tableMerger.merge(tmp, true, validPositions);
   assert(tables.size() == 1);
-  _main_table = tables.front();
+  if (_numaNode != NO_NUMA_NODE)
+    tables.front()->placeOnNode(_numaNode);
+  const auto& new_main = tables.front();
   // Fixup the cid and tid vectors
-  _cidBeginVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::UNKNOWN_CID);
-  _cidEndVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::INF_CID);
-  _tidVector = tbb::concurrent_vector<tx::transaction_id_t>(_main_table->size(), tx::START_TID);
+  _cidBeginVector = tbb::concurrent_vector<tx::transaction_cid_t>(new_main->size(), tx::UNKNOWN_CID);
+  _cidEndVector = tbb::concurrent_vector<tx::transaction_cid_t>(new_main->size(), tx::INF_CID);
+  _tidVector = tbb::concurrent_vector<tx::transaction_id_t>(new_main->size(), tx::START_TID);
   
-  // Replace the delta partition
-  delta = new_delta;
+  // Replace the main and the delta partition
   _delta_size = new_delta->size();
+  publishLayout(new_main, nullptr, new_delta, new_main->size());
+
+  // Positions changed, all rows of the new main are visible
+  std::lock_guard<std::mutex> guard(_visibility_mutex);
+  _visibility = std::make_shared<VisibilityBitmap>(last_commit_id, new_main->size(), true);
+  _commit_log.clear();
+  _commit_log_positions = 0;
+  _commit_log_horizon = last_commit_id;
+  return new_main;
+}
+
+void Store::freezeDelta() {
+  std::lock_guard<locking::SharedSpinlock> lock(_delta_write_lock);
+  const auto current = layout();
+  if (current->frozen_delta) {
+    throw std::runtime_error("Delta is already frozen");
+  }
+
+  atable_ptr_t new_delta = current->delta->copy_structure(create_concurrent_dict, create_concurrent_storage);
+
+  // Every existing row keeps its position, readers of the new layout
+  // find it in the frozen delta
+  _delta_size = 0;
+  publishLayout(current->main, current->delta, new_delta,
+                current->main->size() + current->delta->size());
+}
+
+void Store::mergeFrozenDelta() {
+  if (merger == nullptr) {
+    throw std::runtime_error("No Merger set.");
+  }
+  mergeFrozenDelta(*merger);
+}
+
+void Store::mergeFrozenDelta(const TableMerger& tableMerger) {
+  const auto frozen = layout();
+  if (!frozen->frozen_delta) {
+    throw std::runtime_error("No frozen delta to merge");
+  }
+
+  // Main and frozen delta only see MVCC updates from now on, so they can
+  // be merged without holding any lock. Invalid rows are kept, dropping
+  // them would move the rows running transactions refer to.
+  std::vector<c_atable_ptr_t> tmp {frozen->main, frozen->frozen_delta};
+  auto tables = tableMerger.merge(tmp);
+  assert(tables.size() == 1);
+  assert(tables.front()->size() == frozen->delta_offset);
+  if (_numaNode != NO_NUMA_NODE)
+    tables.front()->placeOnNode(_numaNode);
+
+  // The new main covers exactly the rows before the delta offset. The
+  // write lock keeps setDelta() from replacing the delta meanwhile.
+  std::lock_guard<locking::SharedSpinlock> lock(_delta_write_lock);
+  const auto current = layout();
+  _retired_tables = {current->main, current->frozen_delta};
+  publishLayout(tables.front(), nullptr, current->delta, current->delta_offset);
+}
+
+void Store::publishLayout(atable_ptr_t main, atable_ptr_t frozen_delta, atable_ptr_t delta, size_t delta_offset) {
+  std::atomic_store(&_layout, layout_ptr_t(std::make_shared<layout_t>(
+      layout_t {std::move(main), std::move(frozen_delta), std::move(delta), delta_offset})));
+}
+
+void Store::mergeOnline() {
+  freezeDelta();
+  mergeFrozenDelta();
+}
+
+void Store::mergeOnline(const TableMerger& tableMerger) {
+  freezeDelta();
+  mergeFrozenDelta(tableMerger);
 }
 
 
 atable_ptr_t Store::getMainTable() const {
-  return _main_table;
+  return layout()->main;
 }
 
 atable_ptr_t Store::getDeltaTable() const {
-  return delta;
+  return layout()->delta;
+}
+
+atable_ptr_t Store::getFrozenDeltaTable() const {
+  return layout()->frozen_delta;
 }
 
 const ColumnMetadata& Store::metadataAt(const size_t column_index, const size_t row_index, const table_id_t table_id) const {
-  size_t offset = _main_table->size();
-  if (row_index < offset) {
-    return _main_table->metadataAt(column_index, row_index, table_id);
-  }
-  return delta->metadataAt(column_index, row_index - offset, table_id);
+  auto location = locateRow(row_index);
+  return location.table->metadataAt(column_index, location.offset_in_table, table_id);
 }
 
 void Store::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row, const table_id_t table_id) {
-  size_t offset = _main_table->size();
-  if (row < offset) {
-    _main_table->setDictionaryAt(dict, column, row, table_id);
+  const auto current = layout();
+  if (row < current->delta_offset && row < current->main->size()) {
+    current->main->setDictionaryAt(dict, column, row, table_id);
   }
-  delta->setDictionaryAt(dict, column, row - offset, table_id);
+  current->delta->setDictionaryAt(dict, column, row - current->delta_offset, table_id);
 }
 
 const AbstractTable::SharedDictionaryPtr& Store::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id) const {
-  size_t offset = _main_table->size();
-  if (row < offset) {
-    return _main_table->dictionaryAt(column, row);
-  }
-  return delta->dictionaryAt(column, row - offset);
+  auto location = locateRow(row);
+  return location.table->dictionaryAt(column, location.offset_in_table);
 }
 
 const AbstractTable::SharedDictionaryPtr& Store::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
+  const auto current = layout();
   if (table_id == 0)
-    return _main_table->dictionaryByTableId(column, table_id);
+    return current->main->dictionaryByTableId(column, table_id);
+  else if (table_id == 2 && current->frozen_delta)
+    return current->frozen_delta->dictionaryByTableId(column, 0);
   else
-    return delta->dictionaryByTableId(column, table_id);
+    return current->delta->dictionaryByTableId(column, table_id);
 }
 
-inline Store::table_offset_idx_t Store::responsibleTable(const size_t row) const {
-  size_t offset = _main_table->size();
-  if (row < offset) {
-    return {_main_table, row, 0};
+Store::table_offset_idx_t Store::locateRow(const size_t row) const {
+  // a concurrent merge publishes a new layout, the row is located in one
+  const auto current = layout();
+  if (row >= current->delta_offset) {
+    return {current->delta, row - current->delta_offset, 1};
   }
-  assert( row - offset < delta->size() );
-  return {delta, row - offset, 1};
+  const size_t main_size = current->main->size();
+  if (row < main_size) {
+    return {current->main, row, 0};
+  }
+  return {current->frozen_delta, row - main_size, 2};
+}
+
+Store::table_offset_idx_t Store::responsibleTable(const size_t row) const {
+  auto location = locateRow(row);
+  assert( location.offset_in_table < location.table->size() );
+  return location;
 }
 
 void Store::setValueId(const size_t column, const size_t row, ValueId vid) {
@@ -144,25 +244,26 @@ ValueId Store::getValueId(const size_t column, const size_t row) const {
 
 
 size_t Store::size() const {
-  return _main_table->size() + delta->size();
+  const auto current = layout();
+  return current->delta_offset + current->delta->size();
 }
 
 size_t Store::deltaOffset() const {
-  return _main_table->size();
+  return layout()->delta_offset;
 }
 
 size_t Store::columnCount() const {
-  return delta->columnCount();
+  return layout()->delta->columnCount();
 }
 
 unsigned Store::partitionCount() const {
-  return _main_table->partitionCount();
+  return layout()->main->partitionCount();
 }
 
 size_t Store::partitionWidth(const size_t slice) const {
   // TODO we now require that all main tables have the same layout
   //return main_tables[0]->partitionWidth(slice);
-  return  _main_table->partitionWidth(slice);
+  return layout()->main->partitionWidth(slice);
 }
 
 
@@ -176,14 +277,20 @@ void Store::setMerger(TableMerger *_merger) {
 }
 
 void Store::setDelta(atable_ptr_t _delta) {
-  delta = _delta;
+  std::lock_guard<locking::SharedSpinlock> lock(_delta_write_lock);
+  const auto current = layout();
+  _delta_size = _delta->size();
+  publishLayout(current->main, current->frozen_delta, _delta, current->delta_offset);
 }
 
 atable_ptr_t Store::copy() const {
   std::shared_ptr<Store> new_store = std::make_shared<Store>();
 
-  new_store->_main_table = _main_table->copy();
-  new_store->delta = delta->copy();
+  const auto current = layout();
+  new_store->publishLayout(current->main->copy(),
+                           current->frozen_delta ? current->frozen_delta->copy() : nullptr,
+                           current->delta->copy(), current->delta_offset);
+  new_store->_delta_size = current->delta->size();
 
   if (merger == nullptr) {
     new_store->merger = nullptr;
@@ -197,21 +304,42 @@ atable_ptr_t Store::copy() const {
 
 const attr_vectors_t Store::getAttributeVectors(size_t column) const {
   attr_vectors_t tables;
+  const auto current = layout();
 
-  const auto& subtablesM = _main_table->getAttributeVectors(column);
+  const auto& subtablesM = current->main->getAttributeVectors(column);
   tables.insert(tables.end(), subtablesM.begin(), subtablesM.end());
 
-  const auto& subtables = delta->getAttributeVectors(column);
+  if (current->frozen_delta) {
+    const auto& subtablesF = current->frozen_delta->getAttributeVectors(column);
+    tables.insert(tables.end(), subtablesF.begin(), subtablesF.end());
+  }
+
+  const auto& subtables = current->delta->getAttributeVectors(column);
   tables.insert(tables.end(), subtables.begin(), subtables.end());
   return tables;
 }
 
+int Store::numaNode() const {
+  return layout()->main->numaNode();
+}
+
+void Store::placeOnNode(unsigned node) {
+  // the delta is written by many threads and stays where it is
+  _numaNode = node;
+  layout()->main->placeOnNode(node);
+}
+
 void Store::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "Store " << this << std::endl;
+  const auto current = layout();
   std::cout << std::string(level, '\t') << "(main) " << this << std::endl;
-  _main_table->debugStructure(level+1);
+  current->main->debugStructure(level+1);
+  if (current->frozen_delta) {
+    std::cout << std::string(level, '\t') << "(frozen delta) " << this << std::endl;
+    current->frozen_delta->debugStructure(level+1);
+  }
   std::cout << std::string(level, '\t') << "(delta) " << this << std::endl;
-  delta->debugStructure(level+1);
+  current->delta->debugStructure(level+1);
 }
 
 bool Store::isVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
@@ -249,16 +377,83 @@ void Store::validatePositions(pos_list_t& pos, tx::transaction_cid_t last_commit
   // Make sure we captured all rows
   assert(_cidBeginVector.size() == size() && _cidEndVector.size() == size() && _tidVector.size() == size());
 
-  // Pos is nullptr, we should circumvent
+  // Only our own rows differ from the snapshot visibility
+  const auto visible = snapshotVisibility(last_commit_id);
   auto end = std::remove_if(std::begin(pos), std::end(pos), [&](const pos_t& v){
-
-    return !isVisibleForTransaction(v, last_commit_id, tid);
-
+    return _tidVector[v] == tid ? !isVisibleForTransaction(v, last_commit_id, tid) : !visible->test(v);
   } );
   if (end != pos.end())
     pos.erase(end, pos.end());
 }
 
+std::shared_ptr<VisibilityBitmap> Store::computeVisibility(tx::transaction_cid_t last_commit_id) const {
+  const size_t rows = _cidBeginVector.size();
+  auto result = std::make_shared<VisibilityBitmap>(last_commit_id, rows);
+  for (size_t row = 0; row < rows; ++row) {
+    if (_cidBeginVector[row] <= last_commit_id && last_commit_id < _cidEndVector[row]) {
+      result->set(row, true);
+    }
+  }
+  return result;
+}
+
+void Store::pruneCommitLog(tx::transaction_cid_t last_commit_id) const {
+  auto end = std::remove_if(_commit_log.begin(), _commit_log.end(), [&] (const logged_commit_t& commit) {
+      return commit.cid <= last_commit_id;
+    });
+  _commit_log.erase(end, _commit_log.end());
+  _commit_log_positions = 0;
+  for (const auto& commit : _commit_log) {
+    _commit_log_positions += commit.positions.size();
+  }
+}
+
+std::shared_ptr<const VisibilityBitmap> Store::snapshotVisibility(tx::transaction_cid_t last_commit_id) const {
+  // Commits up to a published commit id are complete, so its snapshot
+  // cannot change anymore and may be cached
+  const bool published = last_commit_id <= tx::TransactionManager::getInstance().getLastCommitId();
+
+  std::lock_guard<std::mutex> guard(_visibility_mutex);
+  if (_visibility && _visibility->cid() == last_commit_id) {
+    return _visibility;
+  }
+  if (!published || (_visibility && _visibility->cid() > last_commit_id) ||
+      (!_visibility && last_commit_id < _commit_log_horizon)) {
+    return computeVisibility(last_commit_id);
+  }
+
+  if (!_visibility) {
+    // Commits after last_commit_id stay in the log, they may have been
+    // written before or after the scan
+    _visibility = computeVisibility(last_commit_id);
+    pruneCommitLog(last_commit_id);
+    return _visibility;
+  }
+
+  // Advance the cached snapshot by all commits up to last_commit_id, in
+  // commit order, as a row may be inserted and deleted in between
+  std::vector<const logged_commit_t *> commits;
+  for (const auto& commit : _commit_log) {
+    if (commit.cid <= last_commit_id) {
+      commits.push_back(&commit);
+    }
+  }
+  std::stable_sort(commits.begin(), commits.end(), [] (const logged_commit_t *a, const logged_commit_t *b) {
+      return a->cid < b->cid;
+    });
+
+  auto next = std::make_shared<VisibilityBitmap>(*_visibility);
+  next->setCid(last_commit_id);
+  for (const auto *commit : commits) {
+    for (const auto& row : commit->positions) {
+      next->set(row, commit->valid);
+    }
+  }
+  _visibility = next;
+  pruneCommitLog(last_commit_id);
+  return _visibility;
+}
+
 pos_list_t Store::buildValidPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
   pos_list_t result;
   functional::forEachWithIndex(_cidBeginVector, [&](size_t i, tx::transaction_cid_t v){
@@ -268,15 +463,17 @@ pos_list_t Store::buildValidPositions(tx::transaction_cid_t last_commit_id, tx::
 }
 
 std::pair<size_t, size_t> Store::resizeDelta(size_t num) {
-  assert(num > delta->size());
-  return appendToDelta(num - delta->size());
+  const auto current_delta = getDeltaTable();
+  assert(num > current_delta->size());
+  return appendToDelta(num - current_delta->size());
 }
 
 std::pair<size_t, size_t> Store::appendToDelta(size_t num_rows) {
   // By atomically drawing a range of rows unique to the calling thread...
   std::size_t prior_delta_size =_delta_size.fetch_add(num_rows);
-  delta->resize(prior_delta_size + num_rows);  
-  auto main_size = _main_table->size();
+  const auto current = layout();
+  current->delta->resize(prior_delta_size + num_rows);  
+  auto main_size = current->delta_offset;
   auto new_size = main_size + prior_delta_size + num_rows;
   auto grow_and_fill = [=] (tbb::concurrent_vector<tx::transaction_id_t>& vector, tx::transaction_id_t value) {
     vector.grow_to_at_least(new_size);
@@ -290,12 +487,13 @@ std::pair<size_t, size_t> Store::appendToDelta(size_t num_rows) {
 }
 
 void Store::copyRowToDelta(const c_atable_ptr_t& source, const size_t src_row, const size_t dst_row, tx::transaction_id_t tid) {
-  auto main_tables_size = _main_table->size();
+  const auto current = layout();
+  auto main_tables_size = current->delta_offset;
 
   // Update the validity
   _tidVector[main_tables_size + dst_row] = tid;
 
-  delta->copyRowFrom(source, src_row, dst_row, true);
+  current->delta->copyRowFrom(source, src_row, dst_row, true);
 }
 
 tx::TX_CODE Store::commitPositions(const pos_list_t& pos, const tx::transaction_cid_t cid, bool valid) {
@@ -307,6 +505,19 @@ tx::TX_CODE Store::commitPositions(const pos_list_t& pos, const tx::transaction_
     }
     _tidVector[p] = tx::START_TID;
   }
+
+  std::lock_guard<std::mutex> guard(_visibility_mutex);
+  _commit_log.push_back({cid, pos, valid});
+  _commit_log_positions += pos.size();
+  // Without a cached snapshot only unpublished commits are needed. If the
+  // log outgrows the snapshot, recomputing it is cheaper than advancing.
+  if (_visibility && _commit_log_positions > std::max<size_t>(visibility_log_limit, _visibility->size() / 8)) {
+    _visibility = nullptr;
+  }
+  if (!_visibility) {
+    _commit_log_horizon = std::max(_commit_log_horizon, tx::TransactionManager::getInstance().getLastCommitId());
+    pruneCommitLog(_commit_log_horizon);
+  }
   return tx::TX_CODE::TX_OK;
 }
 
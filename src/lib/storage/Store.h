@@ -14,8 +14,14 @@
 #include <storage/AbstractMergeStrategy.h>
 #include <storage/SequentialHeapMerger.h>
 #include <storage/PrettyPrinter.h>
+#include <storage/VisibilityBitmap.h>
 
 #include <helper/types.h>
+#include <helper/locking.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #include "tbb/concurrent_vector.h"
 
@@ -27,6 +33,13 @@ namespace storage {
  * only entity capable of modifying the content of the table(s) after
  * initialization via the delta store. It can be merged into the main
  * tables using a to-be-set merger.
+ *
+ * Besides the blocking merge(), the store supports an online merge: the
+ * delta is frozen and new writes go to a fresh delta, while the main and
+ * the frozen delta are merged in the background. Rows keep their
+ * positions during an online merge, so the MVCC vectors and positions
+ * held by running transactions stay valid. Rows are laid out as main,
+ * frozen delta (only during an online merge), delta.
  */
 class Store : public AbstractTable {
 public:
@@ -37,8 +50,33 @@ public:
   atable_ptr_t getMainTable() const;
   void setDelta(atable_ptr_t _delta);
   atable_ptr_t getDeltaTable() const;
+  /// Delta that is being merged by an online merge, nullptr otherwise
+  atable_ptr_t getFrozenDeltaTable() const;
+  /// First row of the delta that receives new writes
   size_t deltaOffset() const;
-  void merge();
+  /// Blocking merge, returns the new main
+  atable_ptr_t merge();
+  /// Merges with tableMerger instead of the merger of the store
+  atable_ptr_t merge(const TableMerger& tableMerger);
+
+  /// Online merge, step one: freezes the current delta and redirects
+  /// all further writes to a new, empty delta. Waits for writers that
+  /// currently hold the delta write lock.
+  void freezeDelta();
+
+  /// Online merge, step two: merges the main and the frozen delta into a
+  /// new main and installs it. Does not block writers; all rows, including
+  /// invalidated ones, are retained so that row positions do not change.
+  void mergeFrozenDelta();
+  void mergeFrozenDelta(const TableMerger& tableMerger);
+
+  /// Runs both steps of the online merge
+  void mergeOnline();
+  void mergeOnline(const TableMerger& tableMerger);
+
+  /// Writers into the delta must hold this lock in shared mode from
+  /// appendToDelta() until their last write to the drawn rows
+  locking::SharedSpinlock& deltaWriteLock() { return _delta_write_lock; }
 
   /// Replaces the merger used for merging main tables with delta.
   /// @param _merger Pointer to a merger instance.
@@ -52,10 +90,19 @@ public:
 
   bool isVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const;
 
-  /// This method validates a list of positions to check if it is valid
+  /// This method validates a list of positions to check if it is valid.
+  /// Only rows locked by tid are checked against the MVCC vectors, all
+  /// others are looked up in the snapshot visibility.
   void validatePositions(pos_list_t& pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid ) const;
   pos_list_t buildValidPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const;
 
+  /// Rows visible to transactions that started at last_commit_id, without
+  /// the uncommitted changes of any transaction. The newest snapshot of a
+  /// published commit id is cached and advanced to later commit ids by
+  /// applying the positions committed since, so a read-only transaction
+  /// does not scan the MVCC vectors. A blocking merge resets it.
+  std::shared_ptr<const VisibilityBitmap> snapshotVisibility(tx::transaction_cid_t last_commit_id) const;
+
   /// Copies a new row to the delta table, sets the validity and the
   /// tx id accordingly. May need to resize delta.
   void copyRowToDelta(const c_atable_ptr_t& source, size_t src_row, size_t dst_row, tx::transaction_id_t tid);
@@ -69,6 +116,21 @@ public:
   tx::TX_CODE markForDeletion(pos_t pos,  tx::transaction_id_t tid);
   tx::TX_CODE unmarkForDeletion(const pos_list_t& pos, tx::transaction_id_t tid);
 
+  /// Reads a value from the table the row is located in. Unlike
+  /// AbstractTable::getValue(), which looks up the value id and the
+  /// dictionary separately, this stays consistent while an online merge
+  /// installs a new main.
+  template <typename T>
+  T getValue(const field_t column, const size_t row) const {
+    const auto location = responsibleTable(row);
+    return location.table->template getValue<T>(column, location.offset_in_table);
+  }
+
+  template <typename T>
+  T getValue(const field_name_t &column_name, const size_t row) const {
+    return getValue<T>(numberOfColumn(column_name), row);
+  }
+
   /// AbstractTable interface
   const ColumnMetadata& metadataAt(const size_t column_index, const size_t row_index = 0, const table_id_t table_id = 0) const override;
 
@@ -82,23 +144,68 @@ public:
   unsigned partitionCount() const override;
   size_t partitionWidth(size_t slice) const override;
   void print(size_t limit = (size_t) - 1) const override;
-  table_id_t subtableCount() const override { return 2; }
+  table_id_t subtableCount() const override { return layout()->frozen_delta ? 3 : 2; }
   atable_ptr_t copy() const override;
   const attr_vectors_t getAttributeVectors(size_t column) const override;
   void debugStructure(size_t level=0) const override;
+  int numaNode() const override;
+  void placeOnNode(unsigned node) override;
 
  private:
   std::atomic<std::size_t> _delta_size;
-  //* Vector containing the main tables
-  atable_ptr_t _main_table;
 
-  //* Delta store
-  atable_ptr_t delta;
+  //* Tables the rows are located in. Readers take no lock, so the
+  //* tables and the first row of the delta are replaced together by
+  //* publishing a new layout with std::atomic_store.
+  typedef struct {
+    //* Main table, reported as table id 0
+    atable_ptr_t main;
+    //* Delta being merged by an online merge, reported as table id 2
+    atable_ptr_t frozen_delta;
+    //* Delta store, reported as table id 1
+    atable_ptr_t delta;
+    //* First row of delta, rows before belong to the main or the frozen delta
+    size_t delta_offset;
+  } layout_t;
+  typedef std::shared_ptr<const layout_t> layout_ptr_t;
+  layout_ptr_t _layout;
+
+  layout_ptr_t layout() const { return std::atomic_load(&_layout); }
+  void publishLayout(atable_ptr_t main, atable_ptr_t frozen_delta, atable_ptr_t delta, size_t delta_offset);
+
+  //* Node the main is kept on across merges, set by placeOnNode()
+  int _numaNode = NO_NUMA_NODE;
+
+  //* Mains replaced by an online merge, kept alive until the next one
+  //* installs its main for callers still holding references into them,
+  //* e.g. from dictionaryAt()
+  std::vector<atable_ptr_t> _retired_tables;
+
+  //* Excludes freezing the delta while rows are written to it
+  locking::SharedSpinlock _delta_write_lock;
 
   //* Current merger
   TableMerger *merger;
 
-  typedef struct { const atable_ptr_t& table; size_t offset_in_table; size_t table_index; } table_offset_idx_t;
+  //* Positions committed by one transaction, kept to advance the cached
+  //* snapshot visibility
+  typedef struct { tx::transaction_cid_t cid; pos_list_t positions; bool valid; } logged_commit_t;
+
+  //* Guards the cached snapshot visibility and the commit log
+  mutable std::mutex _visibility_mutex;
+  mutable std::shared_ptr<const VisibilityBitmap> _visibility;
+  mutable std::vector<logged_commit_t> _commit_log;
+  mutable size_t _commit_log_positions = 0;
+  //* Commits up to here may be missing from the log when no snapshot is
+  //* cached, older snapshots are not cached
+  mutable tx::transaction_cid_t _commit_log_horizon = 0;
+
+  std::shared_ptr<VisibilityBitmap> computeVisibility(tx::transaction_cid_t last_commit_id) const;
+  void pruneCommitLog(tx::transaction_cid_t last_commit_id) const;
+
+  //* Owns the located table, so it outlives a concurrent merge
+  typedef struct { atable_ptr_t table; size_t offset_in_table; size_t table_index; } table_offset_idx_t;
+  table_offset_idx_t locateRow(size_t row) const;
   table_offset_idx_t responsibleTable(size_t row) const;
  
   // TX Management
@@ -173,6 +173,9 @@ ValueId Table::getValueId(const size_t column, const size_t row) const {
 void Table::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   assert(column < width);
   tuples->set(column, row, valueId.valueId);
+  if (!_zoneMaps.empty() && _zoneMaps[column]) {
+    _zoneMaps[column]->update(row, valueId.valueId);
+  }
 }
 
 
@@ -215,6 +218,11 @@ void Table::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_
     _metadata[column].setType(types::getOrderedType(_metadata[column].getType()));
   }
 
+  // The value ids summarized by the zone map refer to the old dictionary
+  if (!_zoneMaps.empty()) {
+    _zoneMaps[column] = nullptr;
+  }
+
   _dictionaries[column] = dict;
 }
 
@@ -222,6 +230,33 @@ void Table::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_
 
 void Table::setAttributes(SharedAttributeVector doc) {
   tuples = doc;
+  _zoneMaps.clear();
+  _numaNode = NO_NUMA_NODE;
+}
+
+std::shared_ptr<ZoneMap> Table::zoneMapAt(const size_t column) const {
+  return _zoneMaps.empty() ? nullptr : _zoneMaps[column];
+}
+
+void Table::buildZoneMaps(const size_t block_size) {
+  if (!tuples) {
+    return;
+  }
+  std::vector<std::shared_ptr<ZoneMap>> zoneMaps(width);
+  for (size_t column = 0; column < width; ++column) {
+    zoneMaps[column] = std::make_shared<ZoneMap>(*tuples, column, size(), block_size);
+  }
+  _zoneMaps.swap(zoneMaps);
+}
+
+int Table::numaNode() const {
+  return _numaNode;
+}
+
+void Table::placeOnNode(const unsigned node) {
+  if (tuples && tuples->placeOnNode(node)) {
+    _numaNode = node;
+  }
 }
 
 
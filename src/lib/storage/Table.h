@@ -19,6 +19,7 @@
 
 #include "storage/BaseAttributeVector.h"
 #include "storage/AttributeVectorFactory.h"
+#include "storage/ZoneMap.h"
 
 namespace hyrise {
 namespace storage {
@@ -58,6 +59,13 @@ private:
 
   bool _compressed = false;
 
+  //* Zone maps per column, empty unless buildZoneMaps() was called. A
+  //* column whose dictionary was replaced has none.
+  std::vector<std::shared_ptr<ZoneMap>> _zoneMaps;
+
+  //* Node the tuples were placed on by placeOnNode()
+  int _numaNode = NO_NUMA_NODE;
+
 public:
 
   /*
@@ -132,6 +140,14 @@ public:
     return { t };
   }
 
+  virtual std::shared_ptr<ZoneMap> zoneMapAt(size_t column) const;
+
+  virtual void buildZoneMaps(size_t block_size = zone_map_block_size);
+
+  virtual int numaNode() const;
+
+  virtual void placeOnNode(unsigned node);
+
   virtual void debugStructure(size_t level=0) const;
 };
 
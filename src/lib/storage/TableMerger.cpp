@@ -4,6 +4,7 @@
 #include <cassert>
 
 #include "storage/AbstractMerger.h"
+#include "storage/ZoneMap.h"
 
 namespace hyrise {
 namespace storage {
@@ -42,6 +43,7 @@ std::vector<atable_ptr_t> TableMerger::mergeToTable(atable_ptr_t dest,
     // do the merge
     auto newSize = _strategy->calculateNewSize(tables.tables_to_merge, useValid, valid);
     _merger->mergeValues(tables.tables_to_merge, dest, mapping, newSize, useValid, valid);
+    dest->buildZoneMaps(zone_map_block_size);
 
     // create result tables
     result.push_back(dest);
@@ -80,6 +82,7 @@ std::vector<atable_ptr_t > TableMerger::merge(std::vector<c_atable_ptr_t > &inpu
 
     // do the merge
     _merger->mergeValues(tables.tables_to_merge, merged_table, identityMap(merged_table), new_size, useValid, valid);
+    merged_table->buildZoneMaps(zone_map_block_size);
 
     // create result tables
     result.push_back(merged_table);
@@ -0,0 +1,58 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/VisibilityBitmap.h"
+
+#include <algorithm>
+
+namespace hyrise {
+namespace storage {
+
+VisibilityBitmap::VisibilityBitmap(tx::transaction_cid_t cid, size_t rows, bool visible) :
+    _cid(cid), _rows(rows), _words((rows + 63) / 64, visible ? ~0ull : 0ull) {
+  // Keep the bits behind the last row cleared for count()
+  if (visible && rows % 64 != 0) {
+    _words.back() = (1ull << (rows % 64)) - 1;
+  }
+}
+
+void VisibilityBitmap::set(size_t row, bool visible) {
+  if (row >= _rows) {
+    _rows = row + 1;
+    _words.resize((_rows + 63) / 64, 0);
+  }
+  if (visible) {
+    _words[row / 64] |= 1ull << (row % 64);
+  } else {
+    _words[row / 64] &= ~(1ull << (row % 64));
+  }
+}
+
+size_t VisibilityBitmap::count() const {
+  size_t result = 0;
+  for (const auto& word : _words) {
+    result += __builtin_popcountll(word);
+  }
+  return result;
+}
+
+void VisibilityBitmap::appendPositions(size_t start, size_t stop, pos_list_t& positions) const {
+  stop = std::min(stop, _rows);
+  if (start >= stop) {
+    return;
+  }
+  for (size_t word = start / 64; word <= (stop - 1) / 64; ++word) {
+    uint64_t bits = _words[word];
+    // Mask out the rows before start and from stop on
+    if (word == start / 64) {
+      bits &= ~0ull << (start % 64);
+    }
+    if (word == (stop - 1) / 64 && stop % 64 != 0) {
+      bits &= (1ull << (stop % 64)) - 1;
+    }
+    while (bits) {
+      positions.push_back(word * 64 + __builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,54 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/**
+ * Visibility of the rows of a store for a snapshot: bit i is set if row
+ * i was inserted by a transaction that committed at or before the
+ * snapshot's commit id and not deleted by one. Uncommitted changes are
+ * not included, rows behind size() are invisible.
+ */
+class VisibilityBitmap {
+ public:
+  VisibilityBitmap(tx::transaction_cid_t cid, size_t rows, bool visible = false);
+
+  tx::transaction_cid_t cid() const {
+    return _cid;
+  }
+
+  void setCid(tx::transaction_cid_t cid) {
+    _cid = cid;
+  }
+
+  size_t size() const {
+    return _rows;
+  }
+
+  bool test(size_t row) const {
+    return row < _rows && (_words[row / 64] >> (row % 64)) & 1;
+  }
+
+  /// Sets the visibility of row, growing the bitmap if necessary
+  void set(size_t row, bool visible);
+
+  /// Number of visible rows
+  size_t count() const;
+
+  /// Appends all visible rows in [start, stop) to positions in ascending order
+  void appendPositions(size_t start, size_t stop, pos_list_t& positions) const;
+
+ private:
+  tx::transaction_cid_t _cid;
+  size_t _rows;
+  std::vector<uint64_t> _words;
+};
+
+} } // namespace hyrise::storage
@@ -0,0 +1,43 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ZoneMap.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace hyrise {
+namespace storage {
+
+ZoneMap::ZoneMap(const BaseAttributeVector<value_id_t>& vector, size_t column, size_t rows,
+                 size_t block_size) : _block_size(block_size), _rows(rows) {
+  if (block_size == 0) {
+    throw std::invalid_argument("Zone map block size must be greater than zero");
+  }
+
+  const size_t blocks = (rows + block_size - 1) / block_size;
+  _min.resize(blocks, std::numeric_limits<value_id_t>::max());
+  _max.resize(blocks, std::numeric_limits<value_id_t>::min());
+
+  for (size_t block = 0; block < blocks; ++block) {
+    value_id_t low = std::numeric_limits<value_id_t>::max();
+    value_id_t high = std::numeric_limits<value_id_t>::min();
+    const size_t end = std::min(rows, (block + 1) * block_size);
+    for (size_t row = block * block_size; row < end; ++row) {
+      const value_id_t value_id = vector.get(column, row);
+      low = std::min(low, value_id);
+      high = std::max(high, value_id);
+    }
+    _min[block] = low;
+    _max[block] = high;
+  }
+}
+
+void ZoneMap::update(size_t row, value_id_t value_id) {
+  if (row >= _rows) {
+    return;
+  }
+  const size_t block = row / _block_size;
+  _min[block] = std::min(_min[block], value_id);
+  _max[block] = std::max(_max[block], value_id);
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,99 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "storage/BaseAttributeVector.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Default number of rows summarized by one zone map entry
+static const size_t zone_map_block_size = 64 * 1024;
+
+/**
+ * Zone map of a single column: stores the smallest and largest value id
+ * of every block of blockSize() rows. On a column with an order
+ * preserving dictionary, a range predicate on value ids can skip all
+ * blocks whose [min, max] interval does not intersect the searched
+ * range. Rows behind coveredRows() are not summarized and always have to
+ * be scanned.
+ */
+class ZoneMap {
+ public:
+  /// Builds the zone map over the first `rows` rows of `column` in `vector`
+  ZoneMap(const BaseAttributeVector<value_id_t>& vector, size_t column, size_t rows,
+          size_t block_size = zone_map_block_size);
+
+  size_t blockSize() const {
+    return _block_size;
+  }
+
+  size_t blockCount() const {
+    return _min.size();
+  }
+
+  size_t coveredRows() const {
+    return _rows;
+  }
+
+  value_id_t minAt(size_t block) const {
+    return _min[block];
+  }
+
+  value_id_t maxAt(size_t block) const {
+    return _max[block];
+  }
+
+  /// Whether block may contain a value id in [low, high]
+  bool mayContain(size_t block, value_id_t low, value_id_t high) const {
+    return _max[block] >= low && _min[block] <= high;
+  }
+
+  /// Widens the summary of the block containing row to include value_id,
+  /// must be called whenever a covered row is overwritten
+  void update(size_t row, value_id_t value_id);
+
+  /// Calls f(begin, end) for every maximal range of rows within [start,
+  /// stop) that may contain a value id in [low, high]. Adjacent candidate
+  /// blocks are combined into a single range.
+  template <typename F>
+  void forEachCandidate(size_t start, size_t stop, value_id_t low, value_id_t high, F f) const {
+    if (start >= stop) {
+      return;
+    }
+    size_t range_begin = start;
+    bool in_range = false;
+    const size_t covered_stop = std::min(stop, _rows);
+    for (size_t row = start; row < covered_stop;) {
+      const size_t block = row / _block_size;
+      const size_t block_end = std::min(covered_stop, (block + 1) * _block_size);
+      const bool candidate = mayContain(block, low, high);
+      if (candidate && !in_range) {
+        range_begin = row;
+      } else if (!candidate && in_range) {
+        f(range_begin, row);
+      }
+      in_range = candidate;
+      row = block_end;
+    }
+    if (stop > _rows) {
+      if (!in_range) {
+        range_begin = std::max(start, _rows);
+      }
+      f(range_begin, stop);
+    } else if (in_range) {
+      f(range_begin, stop);
+    }
+  }
+
+ private:
+  size_t _block_size;
+  size_t _rows;
+  std::vector<value_id_t> _min;
+  std::vector<value_id_t> _max;
+};
+
+} } // namespace hyrise::storage
@@ -0,0 +1,170 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace hyrise {
+namespace storage {
+namespace bit_unpacking {
+
+/*
+  Block unpacking kernels for bit-packed attribute vectors. Values are
+  stored as a contiguous little-endian bit stream, the value of row `r`
+  in a given column starts at bit `r * stride + offset`. All kernels
+  require at least one word of padding behind the last used block, as
+  they read the stream with unaligned 64 bit loads.
+*/
+
+typedef uint64_t storage_t;
+
+// Largest width that fits into a single unaligned 64 bit load regardless
+// of the bit offset inside the first byte.
+static const uint64_t max_single_load_bits = 57;
+
+// Number of values decoded per call to the kernels by the scan
+// functions, the buffer stays in L1
+static const size_t scan_chunk_size = 1024;
+
+inline uint64_t load_unaligned(const storage_t *data, uint64_t bit) {
+  uint64_t word;
+  std::memcpy(&word, reinterpret_cast<const char *>(data) + (bit >> 3), sizeof(word));
+  return word >> (bit & 7);
+}
+
+// Reads a value of arbitrary width (<= 64 bit) without relying on the
+// single load property
+inline uint64_t extract(const storage_t *data, uint64_t bit, uint64_t bits) {
+  const uint64_t block = bit / 64;
+  const uint64_t shift = bit % 64;
+  const uint64_t mask = bits == 64 ? ~0ull : (1ull << bits) - 1ull;
+  uint64_t result = data[block] >> shift;
+  if (shift + bits > 64) {
+    result |= data[block + 1] << (64 - shift);
+  }
+  return result & mask;
+}
+
+#ifdef __AVX2__
+inline void store4(uint32_t *out, __m256i values) {
+  const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(values, pack)));
+}
+
+inline void store4(uint64_t *out, __m256i values) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), values);
+}
+
+template <typename T>
+inline void store4(T *out, __m256i values) {
+  alignas(32) uint64_t tmp[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(tmp), values);
+  for (size_t i = 0; i < 4; ++i)
+    out[i] = static_cast<T>(tmp[i]);
+}
+#endif
+
+/*
+  Decodes the rows [begin, end) of a column with a width of `Bits` bits
+  into out. The width is a template parameter so that masks and shifts
+  are compile time constants; the AVX2 variant decodes four values per
+  iteration with a gather and a variable shift.
+*/
+template <uint64_t Bits, typename T>
+struct Unpacker {
+  static_assert(Bits <= max_single_load_bits, "Width exceeds a single unaligned load");
+  static void run(const storage_t *data, uint64_t stride, uint64_t offset,
+                  size_t begin, size_t end, T *out) {
+    static const uint64_t mask = (1ull << Bits) - 1ull;
+    size_t row = begin;
+#ifdef __AVX2__
+    const __m256i vmask = _mm256_set1_epi64x(mask);
+    const __m256i vseven = _mm256_set1_epi64x(7);
+    const __m256i vstep = _mm256_set1_epi64x(4 * stride);
+    const uint64_t first = row * stride + offset;
+    __m256i vbit = _mm256_setr_epi64x(first, first + stride, first + 2 * stride, first + 3 * stride);
+    const long long *base = reinterpret_cast<const long long *>(data);
+    for (; row + 4 <= end; row += 4, out += 4) {
+      __m256i words = _mm256_i64gather_epi64(base, _mm256_srli_epi64(vbit, 3), 1);
+      __m256i values = _mm256_and_si256(_mm256_srlv_epi64(words, _mm256_and_si256(vbit, vseven)), vmask);
+      store4(out, values);
+      vbit = _mm256_add_epi64(vbit, vstep);
+    }
+#endif
+    for (uint64_t bit = row * stride + offset; row < end; ++row, bit += stride) {
+      *out++ = static_cast<T>(load_unaligned(data, bit) & mask);
+    }
+  }
+};
+
+// Selects the specialized kernel for a runtime width by walking down
+// from the widest specialization
+template <uint64_t Bits, typename T>
+struct Dispatcher {
+  static void run(uint64_t bits, const storage_t *data, uint64_t stride, uint64_t offset,
+                  size_t begin, size_t end, T *out) {
+    if (bits == Bits) {
+      Unpacker<Bits, T>::run(data, stride, offset, begin, end, out);
+    } else {
+      Dispatcher<Bits - 1, T>::run(bits, data, stride, offset, begin, end, out);
+    }
+  }
+};
+
+template <typename T>
+struct Dispatcher<0, T> {
+  static void run(uint64_t bits, const storage_t *data, uint64_t stride, uint64_t offset,
+                  size_t begin, size_t end, T *out) {
+    for (uint64_t bit = begin * stride + offset; begin < end; ++begin, bit += stride) {
+      *out++ = static_cast<T>(extract(data, bit, bits));
+    }
+  }
+};
+
+// Widths up to 32 bit get a specialized kernel, wider columns use the
+// generic path
+template <typename T>
+inline void unpack(uint64_t bits, const storage_t *data, uint64_t stride, uint64_t offset,
+                   size_t begin, size_t end, T *out) {
+  Dispatcher<32, T>::run(bits, data, stride, offset, begin, end, out);
+}
+
+/*
+  Appends all rows in [begin, end) whose value lies within [low, high]
+  to positions. Values are decoded in chunks and filtered with a branch
+  free loop that writes every candidate and only advances the output
+  cursor on a match.
+*/
+template <typename T, typename P>
+void scanBetween(uint64_t bits, const storage_t *data, uint64_t stride, uint64_t offset,
+                 T low, T high, size_t begin, size_t end, std::vector<P> &positions) {
+  if (begin >= end || high < low) return;
+
+  const uint64_t lower = static_cast<uint64_t>(low);
+  const uint64_t range = static_cast<uint64_t>(high) - lower;
+  T buffer[scan_chunk_size];
+
+  for (size_t chunk = begin; chunk < end; chunk += scan_chunk_size) {
+    const size_t count = std::min(scan_chunk_size, end - chunk);
+    unpack<T>(bits, data, stride, offset, chunk, chunk + count, buffer);
+
+    const size_t written = positions.size();
+    positions.resize(written + count);
+    P *out = positions.data() + written;
+    size_t matches = 0;
+    for (size_t i = 0; i < count; ++i) {
+      out[matches] = chunk + i;
+      matches += (static_cast<uint64_t>(buffer[i]) - lower) <= range;
+    }
+    positions.resize(written + matches);
+  }
+}
+
+} } } // namespace hyrise::storage::bit_unpacking
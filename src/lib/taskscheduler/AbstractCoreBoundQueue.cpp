@@ -20,11 +20,11 @@ namespace taskscheduler {
 log4cxx::LoggerPtr AbstractCoreBoundQueue::logger(log4cxx::Logger::getLogger("taskscheduler.AbstractCoreBoundQueue"));
 
 
-AbstractCoreBoundQueue::AbstractCoreBoundQueue(): _status(RUN){
+AbstractCoreBoundQueue::AbstractCoreBoundQueue(): _status(RUN), _node(0){
   // TODO Auto-generated constructor stub
 }
 
-AbstractCoreBoundQueue::AbstractCoreBoundQueue(int core): _status(RUN), _core(core){}
+AbstractCoreBoundQueue::AbstractCoreBoundQueue(int core): _status(RUN), _core(core), _node(0){}
 
 AbstractCoreBoundQueue::~AbstractCoreBoundQueue() {
   // TODO Auto-generated destructor stub
@@ -47,6 +47,8 @@ void AbstractCoreBoundQueue::launchThread(int core) {
   core = (core % (NUM_PROCS - freeCores)) + freeCores;
 
   if (core < NUM_PROCS) {
+    // set before the thread starts, workers use it to pick steal victims
+    _node = getNodeForCore(core);
     _thread = new std::thread(&AbstractTaskQueue::executeTask, this);
     hwloc_cpuset_t cpuset;
     hwloc_obj_t obj;
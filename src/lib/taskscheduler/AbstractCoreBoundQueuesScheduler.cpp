@@ -28,18 +28,11 @@ AbstractCoreBoundQueuesScheduler::scheduler_status_t AbstractCoreBoundQueuesSche
  */
 void AbstractCoreBoundQueuesScheduler::schedule(std::shared_ptr<Task> task) {
   // simple strategy: check if task is ready to run -> then move to next taskqueue
-  // otherwise store in wait list
-  // lock the task - otherwise, a notify might happen prior to the task being added to the wait set
-  task->lockForNotifications();
-  if (task->isReady())
+  // otherwise the task is handed back by its last dependency
+  if (!task->deferUntilReady(shared_from_this()))
     pushToQueue(task);
-  else {
-    task->addReadyObserver(shared_from_this());
-    std::lock_guard<lock_t> lk(_setMutex);
-    _waitSet.insert(task);
-    LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " inserted in wait queue");
-  }
-  task->unlockForNotifications();
+  else
+    LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " waits for its dependencies");
 }
 /*
  * schedule a task for execution on a given core
@@ -54,18 +47,8 @@ void AbstractCoreBoundQueuesScheduler::schedule(std::shared_ptr<Task> task, int
  * notify scheduler that a given task is ready
  */
 void AbstractCoreBoundQueuesScheduler::notifyReady(std::shared_ptr<Task> task) {
-  // remove task from wait set
-  _setMutex.lock();
-  int tmp = _waitSet.erase(task);
-  _setMutex.unlock();
-
-  // if task was found in wait set, schedule task to next queue
-  if (tmp == 1) {
-    LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
-    pushToQueue(task);
-  } else
-    // should never happen, but check to identify potential race conditions
-    LOG4CXX_ERROR(_logger, "Task that notified to be ready to run was not found / found more than once in waitSet! " << std::to_string(tmp));
+  LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
+  pushToQueue(task);
 }
 
 /*
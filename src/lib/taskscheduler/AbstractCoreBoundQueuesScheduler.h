@@ -22,21 +22,16 @@ class AbstractCoreBoundQueuesScheduler :
  public:
 
   typedef AbstractCoreBoundQueue task_queue_t;
-  typedef std::unordered_set<std::shared_ptr<Task> > waiting_tasks_t;
   typedef std::vector<task_queue_t *> task_queues_t;
 
  protected:
 
-  // set for tasks with open dependencies
-  waiting_tasks_t _waitSet;
   // task queues to dispatch tasks to
   task_queues_t _taskQueues;
   // number of queues
   size_t _queues;
   // scheduler status
   std::atomic<scheduler_status_t> _status;
-  // mutex to protect waitset
-  lock_t _setMutex;
   // mutex to protect task queues
   lock_t _queuesMutex;
   // holds the queue that gets the next task (simple roundrobin, first)
@@ -19,7 +19,7 @@ bool registered  =
     SharedScheduler::registerScheduler<CentralPriorityScheduler>("CentralPriorityScheduler");
 }
 
-CentralPriorityScheduler::CentralPriorityScheduler(int threads): _threads(threads) {}
+CentralPriorityScheduler::CentralPriorityScheduler(int threads): _threads(threads), _runningTasks(0) {}
 
 void CentralPriorityScheduler::init(){
   _status = START_UP;
@@ -90,11 +90,16 @@ void PriorityWorkerThread::operator()(){
       std::shared_ptr<Task> task = scheduler._runQueue.top();
       // get first task
       scheduler._runQueue.pop();
+      // counted while the queue is locked, so that a task is always seen
+      // either queued or running
+      if (task)
+        ++scheduler._runningTasks;
 
       ul.unlock();
       
       if (task) {
         (*task)();
+        --scheduler._runningTasks;
         LOG4CXX_DEBUG(scheduler._logger, "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec);
         // notify done observers that task is done
         task->notifyDoneObservers();
@@ -119,22 +124,15 @@ void PriorityWorkerThread::operator()(){
  */
 void CentralPriorityScheduler::schedule(std::shared_ptr<Task> task){
   // simple strategy: check if task is ready to run -> push to run_queue
-  // otherwise store in wait list
-
-  // lock the task - otherwise, a notify might happen prior to the task being added to the wait set
-  task->lockForNotifications();
-  if (task->isReady()){
+  // otherwise the task is handed back by its last dependency
+  if (!task->deferUntilReady(shared_from_this())){
     std::lock_guard<lock_t> lk(_queueMutex);
     _runQueue.push(task);
     _condition.notify_one();
   }
   else {
-    task->addReadyObserver(shared_from_this());
-    std::lock_guard<lock_t> lk(_setMutex);
-    _waitSet.insert(task);
-    LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " inserted in wait queue");
+    LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " waits for its dependencies");
   }
-  task->unlockForNotifications();
 }
 
 /*
@@ -166,20 +164,10 @@ size_t CentralPriorityScheduler::getNumberOfWorker() const{
  * notify scheduler that a given task is ready
  */
 void CentralPriorityScheduler::notifyReady(std::shared_ptr<Task> task) {
-  // remove task from wait set
-  _setMutex.lock();
-  int tmp = _waitSet.erase(task);
-  _setMutex.unlock();
-
-  // if task was found in wait set, schedule task to next queue
-  if (tmp == 1) {
-    LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
-    std::lock_guard<lock_t> lk(_queueMutex);
-    _runQueue.push(task);
-    _condition.notify_one();
-  } else
-    // should never happen, but check to identify potential race conditions
-    LOG4CXX_ERROR(_logger, "Task that notified to be ready to run was not found / found more than once in waitSet! " << std::to_string(tmp));
+  LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
+  std::lock_guard<lock_t> lk(_queueMutex);
+  _runQueue.push(task);
+  _condition.notify_one();
 }
 
 } } // namespace hyrise::taskscheduler
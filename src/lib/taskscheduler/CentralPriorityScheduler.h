@@ -9,6 +9,7 @@
 
 #include "AbstractTaskScheduler.h"
 #include "helper/HwlocHelper.h"
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <queue>
@@ -42,11 +43,6 @@ class CentralPriorityScheduler :
   public std::enable_shared_from_this<TaskReadyObserver> {
   friend class PriorityWorkerThread;
 protected:
-  typedef std::unordered_set<std::shared_ptr<Task> > waiting_tasks_t;
-  // set for tasks with open dependencies
-  waiting_tasks_t _waitSet;
-  // mutex to protect waitset
-  lock_t _setMutex;
   // queue of tasks that are ready to run
   std::priority_queue<std::shared_ptr<Task>, std::vector<std::shared_ptr<Task>>, CompareTaskPtr> _runQueue;
   // mutex to protect ready queue
@@ -61,6 +57,8 @@ protected:
   lock_t _statusMutex;
   // number of threads
   int _threads;
+  // number of tasks taken from the run queue that are still executing
+  std::atomic<size_t> _runningTasks;
 
   static log4cxx::LoggerPtr _logger;
 
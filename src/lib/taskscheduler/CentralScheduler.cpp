@@ -91,13 +91,8 @@ void WorkerThread::operator()(){
  * schedule a task for execution
  */
 void CentralScheduler::schedule(std::shared_ptr<Task> task){
-  task->lockForNotifications();
-  if (task->isReady()) {
+  if (!task->deferUntilReady(shared_from_this()))
     _runQueue.push(task);
-  } else {
-    task->addReadyObserver(shared_from_this());
-  }
-  task->unlockForNotifications();
 }
 
 /*
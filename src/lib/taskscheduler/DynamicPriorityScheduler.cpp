@@ -15,7 +15,7 @@ DynamicPriorityScheduler::DynamicPriorityScheduler(int threads):CentralPriorityS
 
 void DynamicPriorityScheduler::schedule(std::shared_ptr<Task> task){
   if (task->isDynamic() && task->isReady()) {
-    uint dynamicCount = task->determineDynamicCount(_maxTaskSize);
+    uint dynamicCount = task->determineDynamicCount(_maxTaskSize, idleWorkers());
     auto tasks = task->applyDynamicParallelization(dynamicCount);
     for (const auto& i : tasks) {
       CentralPriorityScheduler::schedule(i);
@@ -25,38 +25,30 @@ void DynamicPriorityScheduler::schedule(std::shared_ptr<Task> task){
   }
 }
 
-void DynamicPriorityScheduler::notifyReady(std::shared_ptr<Task> task){
-	// remove task from wait set
-  _setMutex.lock();
-  int tmp = _waitSet.erase(task);
-  _setMutex.unlock();
+size_t DynamicPriorityScheduler::idleWorkers() {
+  std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
+  const size_t busy = _runQueue.size() + _runningTasks;
+  return busy < static_cast<size_t>(_threads) ? _threads - busy : 0;
+}
 
-  // if task was found in wait set, schedule task to next queue
-  if (tmp == 1) {
-    LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
-    if (task->isDynamic()) {
-      auto dynamicCount = task->determineDynamicCount(_maxTaskSize);
-      auto tasks = task->applyDynamicParallelization(dynamicCount);
-      for (const auto& i : tasks) {
-        if (i->isReady()) {
-          std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
-          _runQueue.push(i);
-          _condition.notify_one();
-        } else {   
-          i->addReadyObserver(shared_from_this());
-          std::lock_guard<decltype(_setMutex)> lk(_setMutex);
-          _waitSet.insert(i);
-          LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)i.get() << std::dec << " inserted in wait queue");
-        }
+void DynamicPriorityScheduler::notifyReady(std::shared_ptr<Task> task){
+  LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
+  if (task->isDynamic()) {
+    auto dynamicCount = task->determineDynamicCount(_maxTaskSize, idleWorkers());
+    auto tasks = task->applyDynamicParallelization(dynamicCount);
+    for (const auto& i : tasks) {
+      if (!i->deferUntilReady(shared_from_this())) {
+        std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
+        _runQueue.push(i);
+        _condition.notify_one();
+      } else {
+        LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)i.get() << std::dec << " waits for its dependencies");
       }
-    } else { // task is not dynamic
-      std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
-      _runQueue.push(task);
-      _condition.notify_one();
     }
-  } else {
-    // should never happen, but check to identify potential race conditions
-    LOG4CXX_ERROR(_logger, "Task that notified to be ready to run was not found / found more than once in waitSet! " << std::to_string(tmp));
-  }    
+  } else { // task is not dynamic
+    std::lock_guard<decltype(_queueMutex)> lk(_queueMutex);
+    _runQueue.push(task);
+    _condition.notify_one();
+  }
 }
 }}
@@ -22,6 +22,10 @@ public:
 
 private:
   size_t _maxTaskSize = 0;
+
+  // workers neither running a task nor covered by the tasks in the run
+  // queue
+  size_t idleWorkers();
 };
 
 }}
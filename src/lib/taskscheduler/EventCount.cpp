@@ -0,0 +1,59 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "taskscheduler/EventCount.h"
+
+#include <climits>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hyrise {
+namespace taskscheduler {
+
+#ifdef __linux__
+
+namespace {
+  // std::atomic<uint32_t> is a plain 32 bit word on Linux
+  int futex(std::atomic<uint32_t> *address, int operation, uint32_t value) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t *>(address), operation, value, nullptr, nullptr, 0);
+  }
+}
+
+void EventCount::wait(uint32_t key) {
+  // the kernel only puts us to sleep if the epoch still equals key
+  while (_epoch.load(std::memory_order_seq_cst) == key)
+    futex(&_epoch, FUTEX_WAIT_PRIVATE, key);
+  _waiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void EventCount::wake(bool all) {
+  _epoch.fetch_add(1, std::memory_order_seq_cst);
+  futex(&_epoch, FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1);
+}
+
+#else
+
+void EventCount::wait(uint32_t key) {
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this, key] { return _epoch.load(std::memory_order_seq_cst) != key; });
+  }
+  _waiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void EventCount::wake(bool all) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _epoch.fetch_add(1, std::memory_order_seq_cst);
+  }
+  if (all)
+    _condition.notify_all();
+  else
+    _condition.notify_one();
+}
+
+#endif
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,62 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Parks idle worker threads without a lock on the fast path. A worker
+ * announces itself with prepareWait, checks once more for work and then
+ * either calls cancelWait or wait with the returned key. Producers call
+ * notify after publishing work; they only enter the kernel if a worker
+ * is parked.
+ *
+ * Waiting uses futexes on Linux and a condition variable elsewhere.
+ */
+class EventCount {
+  std::atomic<uint32_t> _epoch;
+  std::atomic<uint32_t> _waiters;
+#ifndef __linux__
+  std::mutex _mutex;
+  std::condition_variable _condition;
+#endif
+
+  void wake(bool all);
+
+ public:
+  EventCount() : _epoch(0), _waiters(0) {}
+
+  EventCount(const EventCount &) = delete;
+  EventCount &operator=(const EventCount &) = delete;
+
+  uint32_t prepareWait() {
+    _waiters.fetch_add(1, std::memory_order_seq_cst);
+    return _epoch.load(std::memory_order_seq_cst);
+  }
+
+  void cancelWait() {
+    _waiters.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /// Blocks until notify was called after prepareWait returned key
+  void wait(uint32_t key);
+
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_seq_cst) != 0)
+      wake(false);
+  }
+
+  void notifyAll() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_seq_cst) != 0)
+      wake(true);
+  }
+};
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,86 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "taskscheduler/ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+namespace {
+
+// Shared between the caller and all helpers. Helpers keep it alive on
+// their own, a helper that starts after all indices are claimed returns
+// without calling body.
+struct ParallelForState {
+  ParallelForState(size_t count, const std::function<void(size_t)>& body) : count(count), body(body) {}
+
+  void work() {
+    size_t index;
+    while ((index = next.fetch_add(1)) < count) {
+      try {
+        body(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++finished == count) {
+        all_finished.notify_all();
+      }
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    all_finished.wait(lock, [this] () { return finished == count; });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  const size_t count;
+  const std::function<void(size_t)> body;
+  std::atomic<size_t> next {0};
+  std::mutex mutex;
+  std::condition_variable all_finished;
+  size_t finished = 0;
+  std::exception_ptr error;
+};
+
+}
+
+void parallelFor(size_t count, const std::function<void(size_t)>& body, size_t parallelism, int priority) {
+  auto& sharedScheduler = SharedScheduler::getInstance();
+  if (count <= 1 || parallelism == 1 || !sharedScheduler.isInitialized()) {
+    for (size_t index = 0; index < count; ++index) {
+      body(index);
+    }
+    return;
+  }
+
+  auto scheduler = sharedScheduler.getScheduler();
+  if (parallelism == 0) {
+    parallelism = std::max<size_t>(scheduler->getNumberOfWorker(), 1);
+  }
+
+  auto state = std::make_shared<ParallelForState>(count, body);
+  const size_t helpers = std::min(parallelism, count) - 1;
+  for (size_t i = 0; i < helpers; ++i) {
+    auto helper = std::make_shared<FunctionTask>([state] () { state->work(); });
+    helper->setPriority(priority);
+    scheduler->schedule(helper);
+  }
+
+  state->work();
+  state->wait();
+}
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,27 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <functional>
+
+#include "taskscheduler/Task.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Runs body(i) for every i in [0, count) on the shared scheduler.
+ *
+ * Indices are claimed through a shared atomic counter by up to
+ * `parallelism` helper tasks (0 uses one per worker) and by the calling
+ * thread. The caller only waits for indices that are already being
+ * processed, so it makes progress even if every worker is busy or blocked
+ * in another parallelFor. Runs sequentially if no scheduler is
+ * initialized. The first exception thrown by body is rethrown once all
+ * indices are done.
+ */
+void parallelFor(size_t count,
+                 const std::function<void(size_t)>& body,
+                 size_t parallelism = 0,
+                 int priority = Task::DEFAULT_PRIORITY);
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,216 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "taskscheduler/ShardedPriorityScheduler.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+log4cxx::LoggerPtr ShardedPriorityScheduler::_logger = log4cxx::Logger::getLogger("taskscheduler.ShardedPriorityScheduler");
+
+// register Scheduler at SharedScheduler
+namespace {
+bool registered  =
+    SharedScheduler::registerScheduler<ShardedPriorityScheduler>("ShardedPriorityScheduler");
+
+// worker of the calling thread, if it belongs to a ShardedPriorityScheduler
+thread_local const ShardedPriorityScheduler *current_scheduler = nullptr;
+thread_local size_t current_worker = 0;
+
+// shard selection state of threads that are not workers
+thread_local uint32_t thread_random = 0;
+
+uint32_t nextRandom(uint32_t &state) {
+  if (state == 0)
+    state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+void bindToCore(std::thread &thread, int core) {
+  int NUM_PROCS = getNumberOfCoresOnSystem();
+  // keep core 0 free for the system if there is more than one core
+  const int freeCores = std::min(NUM_PROCS - 1, 1);
+  core = (core % (NUM_PROCS - freeCores)) + freeCores;
+
+  hwloc_topology_t topology = getHWTopology();
+  hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE, core);
+  // the bitmap to modify
+  hwloc_cpuset_t cpuset = hwloc_bitmap_dup(obj->cpuset);
+  // remove hyperthreads
+  hwloc_bitmap_singlify(cpuset);
+  // bind
+  if (hwloc_set_thread_cpubind(topology, thread.native_handle(), cpuset, HWLOC_CPUBIND_STRICT | HWLOC_CPUBIND_NOMEMBIND)) {
+    char *str;
+    int error = errno;
+    hwloc_bitmap_asprintf(&str, obj->cpuset);
+    fprintf(stderr, "Couldn't bind to cpuset %s: %s\n", str, strerror(error));
+    fprintf(stderr, "Continuing as normal, however, no guarantees\n");
+    free(str);
+  }
+  hwloc_bitmap_free(cpuset);
+}
+}
+
+ShardedPriorityScheduler::shard_t::shard_t() : top(INT_MAX), size(0) {}
+
+ShardedPriorityScheduler::ShardedPriorityScheduler(int threads): _status(START_UP), _threads(threads) {}
+
+ShardedPriorityScheduler::~ShardedPriorityScheduler() {
+  // wait until all threads have joined
+  if (_workerThreads.size() > 0)
+    shutdown();
+}
+
+void ShardedPriorityScheduler::init() {
+  _status = START_UP;
+  for (int i = 0; i < _threads; ++i)
+    _shards.emplace_back(new shard_t);
+  for (int i = 0; i < _threads; ++i) {
+    std::thread thread(&ShardedPriorityScheduler::workerLoop, this, i);
+    bindToCore(thread, i);
+    _workerThreads.push_back(std::move(thread));
+  }
+  _status = RUN;
+}
+
+void ShardedPriorityScheduler::workerLoop(size_t worker) {
+  current_scheduler = this;
+  current_worker = worker;
+  uint32_t random = worker + 1;
+  //infinite thread loop
+  while (1) {
+    if (_status == TO_STOP)
+      break;
+
+    std::shared_ptr<Task> task = pop(worker, random);
+    if (!task) {
+      // announce that we are about to sleep and look once more, a task
+      // pushed after prepareWait wakes us
+      const uint32_t key = _idleWorkers.prepareWait();
+      task = pop(worker, random);
+      if (task) {
+        _idleWorkers.cancelWait();
+      } else if (_status == TO_STOP) {
+        _idleWorkers.cancelWait();
+        break;
+      } else {
+        _idleWorkers.wait(key);
+        continue;
+      }
+    }
+    (*task)();
+    LOG4CXX_DEBUG(_logger, "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec);
+    // notify done observers that task is done
+    task->notifyDoneObservers();
+  }
+  current_scheduler = nullptr;
+}
+
+std::shared_ptr<Task> ShardedPriorityScheduler::popFrom(shard_t &shard) {
+  std::shared_ptr<Task> task;
+  if (shard.size.load(std::memory_order_relaxed) == 0)
+    return task;
+  std::lock_guard<lock_t> lk(shard.mutex);
+  if (!shard.queue.empty()) {
+    task = shard.queue.top();
+    shard.queue.pop();
+    shard.size.store(shard.queue.size(), std::memory_order_relaxed);
+    shard.top.store(shard.queue.empty() ? INT_MAX : shard.queue.top()->getPriority(), std::memory_order_relaxed);
+  }
+  return task;
+}
+
+std::shared_ptr<Task> ShardedPriorityScheduler::pop(size_t worker, uint32_t &random) {
+  const size_t shards = _shards.size();
+  // two choices: the own shard and a random other one, the more urgent
+  // top is tried first
+  size_t first = worker;
+  size_t second = (worker + 1 + nextRandom(random) % std::max<size_t>(shards - 1, 1)) % shards;
+  if (_shards[second]->top.load(std::memory_order_relaxed) < _shards[first]->top.load(std::memory_order_relaxed))
+    std::swap(first, second);
+  std::shared_ptr<Task> task = popFrom(*_shards[first]);
+  if (!task && second != first)
+    task = popFrom(*_shards[second]);
+  if (task)
+    return task;
+  // both were empty, look at all shards before parking
+  const size_t start = nextRandom(random) % shards;
+  for (size_t i = 0; i < shards && !task; ++i)
+    task = popFrom(*_shards[(start + i) % shards]);
+  return task;
+}
+
+void ShardedPriorityScheduler::push(std::shared_ptr<Task> task) {
+  size_t target;
+  if (current_scheduler == this) {
+    target = current_worker;
+  } else {
+    // the shorter of two random shards
+    const size_t shards = _shards.size();
+    target = nextRandom(thread_random) % shards;
+    const size_t other = nextRandom(thread_random) % shards;
+    if (_shards[other]->size.load(std::memory_order_relaxed) < _shards[target]->size.load(std::memory_order_relaxed))
+      target = other;
+  }
+  shard_t &shard = *_shards[target];
+  {
+    std::lock_guard<lock_t> lk(shard.mutex);
+    shard.queue.push(std::move(task));
+    shard.size.store(shard.queue.size(), std::memory_order_relaxed);
+    shard.top.store(shard.queue.top()->getPriority(), std::memory_order_relaxed);
+  }
+  _idleWorkers.notify();
+}
+
+/*
+ * schedule a task for execution
+ */
+void ShardedPriorityScheduler::schedule(std::shared_ptr<Task> task) {
+  // ready tasks are pushed right away, the others are handed back by
+  // their last dependency
+  if (!task->deferUntilReady(shared_from_this()))
+    push(std::move(task));
+  else
+    LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " waits for its dependencies");
+}
+
+/*
+ * notify scheduler that a given task is ready
+ */
+void ShardedPriorityScheduler::notifyReady(std::shared_ptr<Task> task) {
+  LOG4CXX_DEBUG(_logger, "Task " << std::hex << (void *)task.get() << std::dec << " ready to run");
+  push(std::move(task));
+}
+
+/*
+ * shutdown task scheduler; makes sure all underlying threads are stopped
+ */
+void ShardedPriorityScheduler::shutdown() {
+  _status = TO_STOP;
+  //wake up threads in case they are sleeping
+  _idleWorkers.notifyAll();
+  for (size_t i = 0; i < _workerThreads.size(); i++) {
+    _workerThreads[i].join();
+  }
+  _workerThreads.clear();
+  _status = STOPPED;
+}
+
+/**
+ * get number of worker
+ */
+size_t ShardedPriorityScheduler::getNumberOfWorker() const {
+  return _workerThreads.size();
+}
+
+} } // namespace hyrise::taskscheduler
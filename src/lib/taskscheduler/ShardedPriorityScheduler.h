@@ -0,0 +1,83 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "taskscheduler/AbstractTaskScheduler.h"
+#include "taskscheduler/EventCount.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Priority scheduler with one ready queue per worker instead of the single
+ * queue of the CentralPriorityScheduler.
+ *
+ * Workers push tasks that became ready to their own queue, other threads
+ * to the shorter of two random queues. A worker pops from the more urgent
+ * of its own queue and a random other one, comparing their cached tops
+ * without locking either. Priorities are thus only ordered within a
+ * queue; across queues the most urgent task is found with high
+ * probability. Workers without work park on an EventCount.
+ *
+ * Tasks with open dependencies are not tracked by the scheduler, the last
+ * finishing dependency hands them back on its own worker.
+ */
+class ShardedPriorityScheduler :
+  public AbstractTaskScheduler,
+  public TaskReadyObserver,
+  public std::enable_shared_from_this<TaskReadyObserver> {
+
+  struct shard_t {
+    lock_t mutex;
+    std::priority_queue<std::shared_ptr<Task>, std::vector<std::shared_ptr<Task> >, CompareTaskPtr> queue;
+    // priority of the top task, readable without the mutex
+    std::atomic<int> top;
+    std::atomic<size_t> size;
+    // shards are used by different workers, keep them on separate cache lines
+    char padding[64];
+
+    shard_t();
+  };
+
+  std::vector<std::unique_ptr<shard_t> > _shards;
+  std::vector<std::thread> _workerThreads;
+  EventCount _idleWorkers;
+  std::atomic<scheduler_status_t> _status;
+  int _threads;
+
+  static log4cxx::LoggerPtr _logger;
+
+  void workerLoop(size_t worker);
+  void push(std::shared_ptr<Task> task);
+  std::shared_ptr<Task> pop(size_t worker, uint32_t &random);
+  std::shared_ptr<Task> popFrom(shard_t &shard);
+
+public:
+  ShardedPriorityScheduler(int threads = getNumberOfCoresOnSystem());
+  virtual ~ShardedPriorityScheduler();
+  /*
+   * init task scheduler
+   */
+  virtual void init();
+  /*
+   * schedule a task for execution
+   */
+  virtual void schedule(std::shared_ptr<Task> task);
+  /*
+   * shutdown task scheduler; makes sure all underlying threads are stopped
+   */
+  void shutdown();
+  /**
+   * get number of worker
+   */
+  size_t getNumberOfWorker() const;
+
+  virtual void notifyReady(std::shared_ptr<Task> task);
+};
+
+} } // namespace hyrise::taskscheduler
@@ -10,6 +10,7 @@
 
 #include <taskscheduler/AbstractTaskScheduler.h>
 #include <taskscheduler/DynamicPriorityScheduler.h>
+#include <map>
 #include <stdexcept>
 
 namespace hyrise {
@@ -16,6 +16,9 @@
 
 namespace {
 log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.taskscheduler"));
+
+// set in the dependency count of tasks that wait in a scheduler
+const int waiting_flag = 1 << 30;
 }
 
 namespace hyrise {
@@ -27,53 +30,26 @@ std::vector<std::shared_ptr<Task>> Task::applyDynamicParallelization(size_t dyna
   return { shared_from_this() };
 }
 
-void Task::lockForNotifications() {
-  _notifyMutex.lock();
-}
-
-void Task::unlockForNotifications() {
-  _notifyMutex.unlock();
-}
-
-void Task::notifyReadyObservers() {
-  // Lock and copy observers.
-  // This way we do not run any callbacks while holding a lock.
-  std::vector<std::weak_ptr<TaskReadyObserver>> targets;
-	{
-    std::lock_guard<decltype(_observerMutex)> lk(_observerMutex);
-    targets = _readyObservers;
-  }
-	for (const auto& target : targets) {
-    if (auto observer = target.lock()) {
-      observer->notifyReady(shared_from_this());  
-    }
-	}
-}
-
 void Task::notifyDoneObservers() {
-  // Lock and copy observers.
-  // This way we do not run any callbacks while holding a lock.
-  std::vector<std::weak_ptr<TaskDoneObserver>> targets;
-  {
-    std::lock_guard<decltype(_observerMutex)> lk(_observerMutex);
-    targets = _doneObservers;  
-  }
-	for (const auto& target : targets) {
+  // successors are not added once a task runs, so they are neither locked
+  // nor copied
+  const auto self = shared_from_this();
+  for (const auto& target : _doneObservers) {
     if (auto observer = target.lock()) {
-      observer->notifyDone(shared_from_this());  
+      observer->notifyDone(self);
     }
-	}
+  }
 }
 
-Task::Task(): _dependencyWaitCount(0), _preferredCore(NO_PREFERRED_CORE), _preferredNode(NO_PREFERRED_NODE), _priority(DEFAULT_PRIORITY), _sessionId(SESSION_ID_NOT_SET), _id(0) {
+Task::Task(): _dependencyWaitCount(0), _preferredCore(NO_PREFERRED_CORE), _preferredNode(NO_PREFERRED_NODE), _actualNode(NO_PREFERRED_NODE), _priority(DEFAULT_PRIORITY), _sessionId(SESSION_ID_NOT_SET), _id(0) {
 }
 
 void Task::addDependency(std::shared_ptr<Task> dependency) {
   {
     std::lock_guard<decltype(_depMutex)> lk(_depMutex);
     _dependencies.push_back(dependency);
-    ++_dependencyWaitCount;
   }
+  _dependencyWaitCount.fetch_add(1, std::memory_order_relaxed);
   dependency->addDoneObserver(shared_from_this());
 }
 
@@ -91,7 +67,7 @@ void Task::removeDependency(std::shared_ptr<Task> dependency) {
     auto newEnd = std::remove(_dependencies.begin(), _dependencies.end(), dependency);
     if (newEnd != _dependencies.end()) { // we actually removed something
       _dependencies.erase(newEnd, _dependencies.end());
-      --_dependencyWaitCount;
+      _dependencyWaitCount.fetch_sub(1, std::memory_order_relaxed);
     }
 }
 
@@ -111,7 +87,7 @@ void Task::changeDependency(std::shared_ptr<Task> from, std::shared_ptr<Task> to
 void Task::setDependencies(std::vector<std::shared_ptr<Task> > dependencies, int count) {
     std::lock_guard<decltype(_depMutex)> lk(_depMutex);
     _dependencies = dependencies;
-    _dependencyWaitCount = 0;
+    _dependencyWaitCount.fetch_and(waiting_flag, std::memory_order_relaxed);
 }
 
 bool Task::isDependency(const task_ptr_t& task) {
@@ -122,10 +98,17 @@ bool Task::isDependency(const task_ptr_t& task) {
       [task](task_ptr_t t) {return t == task;});
 }
 
-void Task::addReadyObserver(const std::shared_ptr<TaskReadyObserver>& observer) {
-
-  std::lock_guard<decltype(_observerMutex)> lk(_observerMutex);
-  _readyObservers.push_back(observer);
+bool Task::deferUntilReady(const std::shared_ptr<TaskReadyObserver>& observer) {
+  if (isReady())
+    return false;
+  _readyObserver = observer;
+  _waitingSelf = shared_from_this();
+  if (_dependencyWaitCount.fetch_add(waiting_flag, std::memory_order_acq_rel) != 0)
+    return true;
+  // the last dependency finished in the meantime
+  _readyObserver.reset();
+  _waitingSelf.reset();
+  return false;
 }
 
 void Task::addDoneObserver(const std::shared_ptr<TaskDoneObserver>& observer) {
@@ -134,22 +117,24 @@ void Task::addDoneObserver(const std::shared_ptr<TaskDoneObserver>& observer) {
   _doneObservers.push_back(observer);
 }
 
-void Task::notifyDone(std::shared_ptr<Task> task) {
-  _depMutex.lock();
-  int t = --_dependencyWaitCount;
-  _depMutex.unlock();
+void Task::notifyDone(const std::shared_ptr<Task> &task) {
+  const int remaining = _dependencyWaitCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  if ((remaining & ~waiting_flag) != 0)
+    return;
 
-  if (t == 0) {
-    if(_preferredCore == NO_PREFERRED_CORE && _preferredNode == NO_PREFERRED_NODE)
-      _preferredNode = task->getActualNode();
-    std::lock_guard<decltype(_notifyMutex)> lk(_notifyMutex);
-    notifyReadyObservers();
-  }
+  if(_preferredCore == NO_PREFERRED_CORE && _preferredNode == NO_PREFERRED_NODE)
+    _preferredNode = task->getActualNode();
+  // tasks that are not scheduled yet are pushed by deferUntilReady, the
+  // others are handed over on the thread that finished the last dependency
+  if (remaining != waiting_flag)
+    return;
+  auto self = std::move(_waitingSelf);
+  if (auto observer = _readyObserver.lock())
+    observer->notifyReady(std::move(self));
 }
 
 bool Task::isReady() {
-  std::lock_guard<decltype(_depMutex)> lk(_depMutex);
-  return (_dependencyWaitCount == 0);
+  return (_dependencyWaitCount.load(std::memory_order_acquire) & ~waiting_flag) == 0;
 }
 
 int Task::getDependencyCount() {
@@ -197,6 +182,13 @@ void SleepTask::operator()() {
   std::this_thread::sleep_for(std::chrono::microseconds(_microseconds));
 }
 
+FunctionTask::FunctionTask(std::function<void()> function) : _function(function) {
+}
+
+void FunctionTask::operator()() {
+  _function();
+}
+
 void SyncTask::operator()() {
   //do nothing
 }
@@ -8,9 +8,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <condition_variable>
+#include <functional>
 #include <string>
 
 #include "helper/locking.h"
@@ -36,7 +38,7 @@ class TaskDoneObserver {
    * notify that task has changed state
    */
 public:
-  virtual void notifyDone(task_ptr_t task) = 0;
+  virtual void notifyDone(const task_ptr_t &task) = 0;
   virtual ~TaskDoneObserver() {
   };
 };
@@ -54,25 +56,31 @@ public:
   static const int SESSION_ID_NOT_SET = 0;
   // split up the operator in as many instances as indicated by dynamicCount
   virtual std::vector<task_ptr_t> applyDynamicParallelization(size_t dynamicCount);
-  // determine the number of instances necessary to adhere to a max task size.
+  // determine the number of instances necessary to adhere to a max task size;
+  // idleWorkers is the number of workers that would otherwise wait for work.
   // should be overridden in operators
-  // currently all implementing operators are fine-tuned for server gaza.
-  virtual size_t determineDynamicCount(size_t maxTaskRunTime) {
+  virtual size_t determineDynamicCount(size_t maxTaskRunTime, size_t idleWorkers = 0) {
     return 1;
   }
 
 protected:
   std::vector<task_ptr_t> _dependencies;
-  std::vector<std::weak_ptr<TaskReadyObserver>> _readyObservers;
+  // successors; they are registered before the task runs and are not
+  // changed afterwards, so notifying them needs no lock
   std::vector<std::weak_ptr<TaskDoneObserver>> _doneObservers;
-
-  int _dependencyWaitCount;
-  // mutex for dependencyCount and dependency vector
+  // scheduler to hand the task to once it is ready
+  std::weak_ptr<TaskReadyObserver> _readyObserver;
+  // keeps a scheduled task alive while it waits for its dependencies
+  task_ptr_t _waitingSelf;
+
+  // number of unfinished dependencies; a flag bit is added once the task
+  // waits in a scheduler, the dependency that leaves only the flag hands
+  // the task over
+  std::atomic<int> _dependencyWaitCount;
+  // mutex for dependency vector
   hyrise::locking::Spinlock _depMutex;
   // mutex for observer vector
   hyrise::locking::Spinlock _observerMutex;
-  // mutex to stop notifications, while task is being scheduled to wait set in SimpleTaskScheduler
-  hyrise::locking::Spinlock _notifyMutex;
   // indicates on which core the task should run
   int _preferredCore;
   // indicates on which node the task should run
@@ -140,9 +148,11 @@ public:
    */
   bool isDependency(const task_ptr_t& task);
   /*
-   * adds an observer that gets notified if this task is ready to run
+   * hands the task to observer once all dependencies are done and keeps it
+   * alive until then; returns false without registering observer if the
+   * task is ready already, the caller has to run it then
    */
-  void addReadyObserver(const std::shared_ptr<TaskReadyObserver>& observer);
+  bool deferUntilReady(const std::shared_ptr<TaskReadyObserver>& observer);
   /*
    * adds an obserer that gets notified if this task is done
    */
@@ -154,11 +164,7 @@ public:
   /*
    * notify that task is done
    */
-  void notifyDone(task_ptr_t task);
-  /*
-   * notify all ready observers that task is ready
-   */
-  void notifyReadyObservers();
+  void notifyDone(const task_ptr_t &task);
   /*
    * notify all done observers that task is done
    */
@@ -171,12 +177,6 @@ public:
    * get preferred core for this task
    */
   int getPreferredCore();
-  /*
-   * block task for notifications -> used e.g., when task is moved into wait set of scheduler
-   */
-  void lockForNotifications();
-  void unlockForNotifications();
-
   int getActualNode() const {
     return _actualNode;
   }
@@ -261,6 +261,21 @@ public:
   const std::string vname(){return "SleepTask";};
 };
 
+/*
+ * runs an arbitrary function; used by operators that spawn helper tasks for
+ * intra-operator parallelism
+ */
+class FunctionTask : public Task {
+private:
+  std::function<void()> _function;
+public:
+  explicit FunctionTask(std::function<void()> function);
+  virtual ~FunctionTask() {};
+  virtual void operator()();
+
+  const std::string vname(){return "FunctionTask";};
+};
+
 class SyncTask : public Task {
 public:
   SyncTask() {};
@@ -32,11 +32,6 @@ class ThreadPerTaskScheduler :
   public AbstractTaskScheduler,
   public TaskReadyObserver,
   public std::enable_shared_from_this<TaskReadyObserver> {
-  typedef std::unordered_set<std::shared_ptr<Task> > waiting_tasks_t;
-    // set for tasks with open dependencies
-    waiting_tasks_t _waitSet;
-    // mutex to protect waitset
-    lock_t _setMutex;
     // scheduler status
     scheduler_status_t _status;
     // mutex to protect status
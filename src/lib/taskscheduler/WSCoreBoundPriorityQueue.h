@@ -16,13 +16,19 @@ namespace taskscheduler {
 
 class WSCoreBoundPriorityQueuesScheduler;
 
+/*
+ * Work-stealing queue ordered by task priority. The run queue is tbb's
+ * concurrent priority queue, so thieves take the most urgent task of
+ * their victim. Idle workers park on the scheduler's EventCount.
+ */
 class WSCoreBoundPriorityQueue : public AbstractCoreBoundQueue {
 
   typedef tbb::concurrent_priority_queue<std::shared_ptr<Task> , CompareTaskPtr> run_queue_t;
   run_queue_t _runQueue;
   WSCoreBoundPriorityQueuesScheduler * _scheduler;
   const std::vector<AbstractCoreBoundQueue *> * _allQueues;
-
+  // state of the victim selection
+  uint32_t _random;
 
 private:
   std::shared_ptr<Task> stealTasks();
@@ -43,6 +49,10 @@ public:
    * push a new task to the queue, tasks are expected to have no unmet dependencies
    */
   void push(std::shared_ptr<Task> task);
+  /*
+   * wait until all tasks are done
+   */
+  void join();
   /*
    * stop queue and return remaining tasks; allows resizing the number of threads used by a task pool
    */
@@ -9,12 +9,16 @@
 
 #include "AbstractCoreBoundQueuesScheduler.h"
 #include "AbstractCoreBoundQueue.h"
+#include "EventCount.h"
 
 namespace hyrise {
 namespace taskscheduler {
 
 class WSCoreBoundPriorityQueuesScheduler : public AbstractCoreBoundQueuesScheduler {
 
+  // workers without work park here until a task is pushed to any queue
+  EventCount _idleWorkers;
+
   /**
    * push ready task to the next queue
    */
@@ -35,6 +39,10 @@ public:
   virtual void init();
 
   const std::vector<AbstractCoreBoundQueue *> *getTaskQueues();
+
+  EventCount &getIdleWorkers() {
+    return _idleWorkers;
+  }
 };
 
 } } // namespace hyrise::taskscheduler
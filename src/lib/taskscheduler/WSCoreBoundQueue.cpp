@@ -10,7 +10,11 @@
 namespace hyrise {
 namespace taskscheduler {
 
-WSCoreBoundQueue::WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler): AbstractCoreBoundQueue(core), _scheduler(scheduler){}
+namespace {
+  thread_local WSCoreBoundQueue *current_queue = nullptr;
+}
+
+WSCoreBoundQueue::WSCoreBoundQueue(int core, WSCoreBoundQueuesScheduler *scheduler): AbstractCoreBoundQueue(core), _scheduler(scheduler), _allQueues(nullptr), _random(core + 1){}
 
 void WSCoreBoundQueue::init(){
   launchThread(_core);
@@ -20,110 +24,135 @@ WSCoreBoundQueue::~WSCoreBoundQueue() {
   if (_thread != nullptr) stopQueue();
 }
 
+WSCoreBoundQueue *WSCoreBoundQueue::current() {
+  return current_queue;
+}
+
 void WSCoreBoundQueue::executeTask() {
+  current_queue = this;
+  EventCount &idle = _scheduler->getIdleWorkers();
   //infinite thread loop
   while (1) {
-    //block protected by _threadStatusMutex
     if (_status == TO_STOP)
       break;
 
-    // lock queue to get task
-    std::unique_lock<lock_t> ul(_queueMutex);
-
-    std::shared_ptr<Task> task;
-    // get task and execute
-    if (_runQueue.size() > 0) {
-      // get first task
-      task = _runQueue.front();
-      _runQueue.pop_front();
-      ul.unlock();
-
-      // no task in runQueue -> try to steal task from other queue, otherwise sleep and wait for new tasks
-    } else {
-      ul.unlock();
-      // try to steal work
+    std::shared_ptr<Task> task = popTask();
+    // no task in runQueue -> try to steal task from other queue, otherwise sleep and wait for new tasks
+    if (!task)
       task = stealTasks();
-      if (!task){
-        ul.lock();
-        //if queue still empty go to sleep and wait until new tasks have been arrived
-        if (_runQueue.size() < 1) {
-          {
-            // if thread is about to stop, break execution loop
-            if(_status != RUN)
-              break;
-            _condition.wait(ul);           
-          }
-        }
+    if (!task) {
+      // announce that we are about to sleep and look once more, a task
+      // pushed after prepareWait wakes us
+      const uint32_t key = idle.prepareWait();
+      task = popTask();
+      if (!task)
+        task = stealTasks();
+      if (task) {
+        idle.cancelWait();
+      } else if (_status != RUN) {
+        // if thread is about to stop, break execution loop
+        idle.cancelWait();
+        break;
+      } else {
+        idle.wait(key);
+        continue;
       }
     }
-    if (task) {
-      //LOG4CXX_DEBUG(logger, "Started executing task" << std::hex << &task << std::dec << " on core " << _core);
-      // run task
-      //std::cout << "Running task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
-      (*task)();
-      //std::cout << "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
-
-      LOG4CXX_DEBUG(logger, "Executed task " << std::hex << &task << std::dec << " on core " << _core);
-      // notify done observers that task is done
-      task->notifyDoneObservers();
-    }
+    //LOG4CXX_DEBUG(logger, "Started executing task" << std::hex << &task << std::dec << " on core " << _core);
+    // run task
+    (*task)();
+
+    LOG4CXX_DEBUG(logger, "Executed task " << std::hex << &task << std::dec << " on core " << _core);
+    // notify done observers that task is done
+    task->notifyDoneObservers();
   }
+  current_queue = nullptr;
+}
+
+std::shared_ptr<Task> WSCoreBoundQueue::popTask() {
+  std::shared_ptr<Task> task;
+  std::shared_ptr<Task> *box;
+  if (_runQueue.pop(box)) {
+    task = std::move(*box);
+    delete box;
+  } else {
+    _inbox.try_pop(task);
+  }
+  return task;
 }
 
 std::shared_ptr<Task> WSCoreBoundQueue::stealTasks() {
   std::shared_ptr<Task> task = nullptr;
   //check scheduler status
-  WSCoreBoundQueuesScheduler::scheduler_status_t status = _scheduler->getSchedulerStatus();
-  if (status == WSCoreBoundQueuesScheduler::RUN) {
-    auto *queues = _scheduler->getTaskQueues();
-    if (queues != nullptr) {
-      int number_of_queues = queues->size();
-      if(number_of_queues > 1){
-        // steal from the next queue (we only check number_of_queues -1, as we do not have to check the queue taht wants to steal)
-        for (int i = 1; i < number_of_queues; i++) {
-          // we steal relative from the current queue to distribute stealing over queues
-          task = static_cast<WSCoreBoundQueue *>(queues->at((i + _core) % number_of_queues))->stealTask();
-          if (task != nullptr) {
-            //push(task);
-            //std::cout << "Queue " << _core << " stole Task " <<  task->vname() << "; hex " << std::hex << &task << std::dec << " from queue " << i << std::endl;
-            break;
-          }
-        }
+  if (_scheduler->getSchedulerStatus() != WSCoreBoundQueuesScheduler::RUN || _allQueues == nullptr)
+    return task;
+  const size_t number_of_queues = _allQueues->size();
+  bool retry = number_of_queues > 1;
+  while (retry) {
+    retry = false;
+    // start at a random victim so that thieves spread over the queues
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    const size_t first = _random % number_of_queues;
+    // victims on the own node first, their tasks likely work on memory
+    // of this node; remote victims are only tried if those are empty
+    for (int local = 1; local >= 0; local--) {
+      for (size_t i = 0; i < number_of_queues; i++) {
+        auto *victim = static_cast<WSCoreBoundQueue *>(_allQueues->at((first + i) % number_of_queues));
+        if (victim == this || (victim->getNode() == _node) != static_cast<bool>(local))
+          continue;
+        task = victim->stealTask(retry);
+        if (task != nullptr)
+          return task;
       }
     }
   }
   return task;
 }
 
-std::shared_ptr<Task> WSCoreBoundQueue::stealTask() {
+std::shared_ptr<Task> WSCoreBoundQueue::stealTask(bool &retry) {
   std::shared_ptr<Task> task = nullptr;
-  // hold queueMutex, to avoid race conditions
-  std::lock_guard<lock_t> lk1(_queueMutex);
   // dont steal tasks if thread is about to stop
-  if (_status == RUN && _runQueue.size() >= 1) {
-      task = _runQueue.back();
-      _runQueue.pop_back();
+  if (_status != RUN)
+    return task;
+  std::shared_ptr<Task> *box;
+  switch (_runQueue.steal(box)) {
+    case run_queue_t::SUCCESS:
+      task = std::move(*box);
+      delete box;
+      break;
+    case run_queue_t::ABORT:
+      retry = true;
+      break;
+    case run_queue_t::EMPTY:
+      _inbox.try_pop(task);
+      break;
   }
   return task;
 }
 
 void WSCoreBoundQueue::push(std::shared_ptr<Task> task) {
-  std::lock_guard<lock_t> lk(_queueMutex);
-  _runQueue.push_back(task);
-  _condition.notify_one();
+  // only the worker itself may push to the deque
+  if (current_queue == this)
+    _runQueue.push(new std::shared_ptr<Task>(std::move(task)));
+  else
+    _inbox.push(std::move(task));
+  _scheduler->getIdleWorkers().notify();
+}
+
+void WSCoreBoundQueue::join() {
+  _status = RUN_UNTIL_DONE;
+  _scheduler->getIdleWorkers().notifyAll();
+  _thread->join();
 }
 
 std::vector<std::shared_ptr<Task> > WSCoreBoundQueue::stopQueue() {
   if (_status != STOPPED) {
-    // the thread to be stopped is either executing a task, or waits for the condition variable
-    // set status to "TO_STOP" so that the thread either quits after executing the task, or after having been notified by the condition variable
-    // we need the mutex here, otherwise, we might call notify prior to the thread going to sleep
-    {
-      std::lock_guard<lock_t> lk(_queueMutex);
-      _status = TO_STOP;
-      //wake up thread in case thread is sleeping
-      _condition.notify_one();
-    }
+    // the thread to be stopped is either executing a task, or is parked
+    // set status to "TO_STOP" so that the thread either quits after executing the task, or after having been woken up
+    _status = TO_STOP;
+    _scheduler->getIdleWorkers().notifyAll();
     _thread->join();
     delete _thread;
     _thread = nullptr;
@@ -134,11 +163,25 @@ std::vector<std::shared_ptr<Task> > WSCoreBoundQueue::stopQueue() {
 
 std::vector<std::shared_ptr<Task> > WSCoreBoundQueue::emptyQueue() {
   std::vector<std::shared_ptr<Task> > tmp;
-  std::lock_guard<lock_t> lk(_queueMutex);
-  for(auto it = _runQueue.begin(); it != _runQueue.end(); it++)
-    tmp.push_back(*it);
+  std::shared_ptr<Task> *box;
+  // stealing is safe from any thread
+  while (true) {
+    const auto result = _runQueue.steal(box);
+    if (result == run_queue_t::EMPTY)
+      break;
+    if (result == run_queue_t::SUCCESS) {
+      tmp.push_back(std::move(*box));
+      delete box;
+    }
+  }
+  std::shared_ptr<Task> task;
+  while (_inbox.try_pop(task))
+    tmp.push_back(task);
   return tmp;
 }
 
-} } // namespace hyrise::taskscheduler
+void WSCoreBoundQueue::refreshQueues(){
+  _allQueues = _scheduler->getTaskQueues();
+}
 
+} } // namespace hyrise::taskscheduler
@@ -7,22 +7,36 @@
 
 #pragma once
 
-#include <deque>
+#include "tbb/concurrent_queue.h"
 #include "WSCoreBoundQueuesScheduler.h"
 #include "AbstractCoreBoundQueue.h"
+#include "WorkStealingDeque.h"
 
 namespace hyrise {
 namespace taskscheduler {
 
 class WSCoreBoundQueuesScheduler;
 
+/*
+ * Tasks pushed by the worker of a queue go to the bottom of its lock-free
+ * deque, tasks pushed by other threads to an inbox the worker drains.
+ * Idle workers steal from randomly chosen queues, trying the queues on
+ * their own NUMA node first, and park on the scheduler's EventCount once
+ * no queue has work left.
+ */
 class WSCoreBoundQueue : public AbstractCoreBoundQueue {
 
-  typedef std::deque<std::shared_ptr<Task> > run_queue_t;
+  // tasks are boxed, the deque only holds trivially copyable items
+  typedef WorkStealingDeque<std::shared_ptr<Task> *> run_queue_t;
   run_queue_t _runQueue;
+  tbb::concurrent_queue<std::shared_ptr<Task> > _inbox;
   WSCoreBoundQueuesScheduler * _scheduler;
+  const std::vector<AbstractCoreBoundQueue *> * _allQueues;
+  // state of the victim selection
+  uint32_t _random;
 
 private:
+  std::shared_ptr<Task> popTask();
   std::shared_ptr<Task> stealTasks();
 
 public:
@@ -41,6 +55,10 @@ public:
    * push a new task to the queue, tasks are expected to have no unmet dependencies
    */
   void push(std::shared_ptr<Task> task);
+  /*
+   * wait until all tasks are done
+   */
+  void join();
   /*
    * stop queue and return remaining tasks; allows resizing the number of threads used by a task pool
    */
@@ -51,10 +69,20 @@ public:
    */
   std::vector<std::shared_ptr<Task> > emptyQueue();
   /*
-   * steal Task
+   * steal Task; retry is set if a task was lost to a concurrent thief
    * */
-  std::shared_ptr<Task> stealTask();
+  std::shared_ptr<Task> stealTask(bool &retry);
+  /*
+   * set Task Queues
+   */
+  void refreshQueues();
+  WSCoreBoundQueuesScheduler *getScheduler() const {
+    return _scheduler;
+  }
+  /*
+   * queue of the calling worker thread or nullptr
+   */
+  static WSCoreBoundQueue *current();
 };
 
 } } // namespace hyrise::taskscheduler
-
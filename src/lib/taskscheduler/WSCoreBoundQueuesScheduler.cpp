@@ -18,17 +18,23 @@ bool registered  =
     SharedScheduler::registerScheduler<WSCoreBoundQueuesScheduler>("WSCoreBoundQueuesScheduler");
 }
 
-WSCoreBoundQueuesScheduler::WSCoreBoundQueuesScheduler(const int queues):AbstractCoreBoundQueuesScheduler(queues){}
+WSCoreBoundQueuesScheduler::WSCoreBoundQueuesScheduler(const int queues):AbstractCoreBoundQueuesScheduler(queues), _nodes(1){}
 
 void WSCoreBoundQueuesScheduler::init(){
   _status = START_UP;
+  _nodes = getNumberOfNodes(getHWTopology());
   // set _queues to queues after new queues have been created to new tasks to be assigned to new queues
   // lock _queue mutex as queues are manipulated
-  std::lock_guard<lock_t> lk(_queuesMutex);
-  for (size_t i = 0; i < _queues; ++i) {
-    task_queue_t *queue = createTaskQueue(i);
-    queue->init();
-    _taskQueues.push_back(queue);
+  {
+    std::lock_guard<lock_t> lk(_queuesMutex);
+    for (size_t i = 0; i < _queues; ++i) {
+      task_queue_t *queue = createTaskQueue(i);
+      queue->init();
+      _taskQueues.push_back(queue);
+    }
+  }
+  for (unsigned i = 0; i < _taskQueues.size(); ++i) {
+    static_cast<WSCoreBoundQueue *>(_taskQueues[i])->refreshQueues();
   }
   _status = RUN;
 }
@@ -61,6 +67,14 @@ void WSCoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
       // push task to queue that runs on given core
       this->_taskQueues[core]->push(task);
       LOG4CXX_DEBUG(this->_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " pushed to queue " << core);
+    } else if (core == Task::NO_PREFERRED_CORE && task->getPreferredNode() >= 0 && _nodes > 1
+               && pushToNode(task, task->getPreferredNode())) {
+      LOG4CXX_DEBUG(this->_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " pushed to node " << task->getPreferredNode());
+    } else if (core == Task::NO_PREFERRED_CORE && WSCoreBoundQueue::current() != nullptr
+               && WSCoreBoundQueue::current()->getScheduler() == this) {
+      // tasks that become ready on a worker stay on its deque, idle
+      // workers steal them from there
+      WSCoreBoundQueue::current()->push(task);
     } else if (core == Task::NO_PREFERRED_CORE || core >= static_cast<int>(this->_queues)) {
       if (core < Task::NO_PREFERRED_CORE || core >= static_cast<int>(this->_queues))
         // Tried to assign task to core which is not assigned to scheduler; assigned to other core, log warning
@@ -76,6 +90,26 @@ void WSCoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
     }
   }
 
+bool WSCoreBoundQueuesScheduler::pushToNode(const std::shared_ptr<Task> &task, int node) {
+  // a worker on the node keeps the task, like tasks without a preference
+  WSCoreBoundQueue *current = WSCoreBoundQueue::current();
+  if (current != nullptr && current->getScheduler() == this && current->getNode() == node) {
+    current->push(task);
+    return true;
+  }
+  // otherwise round robin over the queues of the node
+  std::lock_guard<lock_t> lk(this->_queuesMutex);
+  for (size_t i = 0; i < this->_queues; ++i) {
+    const size_t queue = (this->_nextQueue + i) % this->_queues;
+    if (this->_taskQueues[queue]->getNode() == node) {
+      this->_taskQueues[queue]->push(task);
+      this->_nextQueue = (queue + 1) % this->_queues;
+      return true;
+    }
+  }
+  return false;
+}
+
 WSCoreBoundQueuesScheduler::task_queue_t *WSCoreBoundQueuesScheduler::createTaskQueue(int core) {
   return new WSCoreBoundQueue(core, this);
 }
@@ -9,17 +9,29 @@
 
 #include "AbstractCoreBoundQueuesScheduler.h"
 #include "AbstractCoreBoundQueue.h"
+#include "EventCount.h"
 
 namespace hyrise {
 namespace taskscheduler {
 
 class WSCoreBoundQueuesScheduler : public AbstractCoreBoundQueuesScheduler {
 
+  // workers without work park here until a task is pushed to any queue
+  EventCount _idleWorkers;
+  // number of numa nodes, tasks are only routed by node if there are several
+  unsigned _nodes;
+
   /**
    * push ready task to the next queue
    */
   virtual void pushToQueue(std::shared_ptr<Task> task);
 
+  /**
+   * push task to a queue on the given node; returns false if the
+   * scheduler has no queue there
+   */
+  bool pushToNode(const std::shared_ptr<Task> &task, int node);
+
   /*
    * create a new task queue
    */
@@ -35,6 +47,10 @@ public:
   virtual void init();
   const std::vector<AbstractCoreBoundQueue *> *getTaskQueues();
 
+  EventCount &getIdleWorkers() {
+    return _idleWorkers;
+  }
+
 };
 
 } } // namespace hyrise::taskscheduler
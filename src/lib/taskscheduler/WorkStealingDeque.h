@@ -0,0 +1,136 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Lock-free work-stealing deque after Chase and Lev, "Dynamic Circular
+ * Work-Stealing Deque" (SPAA 2005), with the memory orderings of Le et
+ * al., "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (PPoPP 2013).
+ *
+ * Only the owning thread may push and pop, both at the bottom. Any thread
+ * may steal from the top. T must be trivially copyable, e.g. a pointer.
+ * The buffer grows on demand; replaced buffers are kept until the deque
+ * is destroyed since a thief may still read from them.
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  typedef enum {
+    EMPTY,
+    // lost a race against another thief or the owner, retrying may succeed
+    ABORT,
+    SUCCESS
+  } steal_result_t;
+
+ private:
+  class Buffer {
+    const int64_t _mask;
+    std::unique_ptr<std::atomic<T>[]> _items;
+
+   public:
+    explicit Buffer(int64_t capacity) : _mask(capacity - 1), _items(new std::atomic<T>[capacity]) {}
+
+    int64_t capacity() const {
+      return _mask + 1;
+    }
+
+    T get(int64_t i) const {
+      return _items[i & _mask].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t i, T item) {
+      _items[i & _mask].store(item, std::memory_order_relaxed);
+    }
+
+    Buffer *grow(int64_t bottom, int64_t top) const {
+      Buffer *result = new Buffer(2 * capacity());
+      for (int64_t i = top; i != bottom; ++i)
+        result->put(i, get(i));
+      return result;
+    }
+  };
+
+  // top and bottom are kept on separate cache lines, thieves only write
+  // top
+  std::atomic<int64_t> _top;
+  char _padding[64 - sizeof(std::atomic<int64_t>)];
+  std::atomic<int64_t> _bottom;
+  std::atomic<Buffer *> _buffer;
+  std::vector<std::unique_ptr<Buffer> > _buffers;
+
+ public:
+  explicit WorkStealingDeque(int64_t capacity = 1024) : _top(0), _bottom(0) {
+    _buffers.emplace_back(new Buffer(capacity));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  /// Owner only
+  void push(T item) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top = _top.load(std::memory_order_acquire);
+    Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->capacity() - 1) {
+      _buffers.emplace_back(buffer->grow(bottom, top));
+      buffer = _buffers.back().get();
+      _buffer.store(buffer, std::memory_order_release);
+    }
+    buffer->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /// Owner only, takes the most recently pushed item
+  bool pop(T &item) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    item = buffer->get(bottom);
+    if (top == bottom) {
+      // last item, race against thieves for it
+      const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  /// Any thread, takes the least recently pushed item
+  steal_result_t steal(T &item) {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+      return EMPTY;
+    Buffer *buffer = _buffer.load(std::memory_order_acquire);
+    item = buffer->get(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      return ABORT;
+    return SUCCESS;
+  }
+
+  /// Approximate number of items
+  size_t size() const {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top = _top.load(std::memory_order_relaxed);
+    return bottom > top ? bottom - top : 0;
+  }
+};
+
+} } // namespace hyrise::taskscheduler